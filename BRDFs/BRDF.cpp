@@ -60,3 +60,11 @@ BRDF::rho(const ShadeRec& sr, const Vector3D& wo) const {
 	return (black);
 }
 
+
+// ------------------------------------------------------------------------ pdf
+
+float
+BRDF::pdf(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const {
+	return (0.0);
+}
+
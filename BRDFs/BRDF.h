@@ -19,6 +19,7 @@ class BRDF {
 		virtual BRDF*
 		clone(void) const = 0;
 		
+		virtual
 		~BRDF(void);
 								
 		virtual RGBColor
@@ -32,6 +33,9 @@ class BRDF {
 		
 		virtual RGBColor
 		rho(const ShadeRec& sr, const Vector3D& wo) const;
+
+		virtual float					// the density with which sample_f picks wi, over solid angle
+		pdf(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const;
 		
 			
 	protected:
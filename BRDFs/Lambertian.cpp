@@ -1,12 +1,15 @@
+#include <math.h>
+
 #include "Lambertian.h"
-#include "../Utilities/Constants.h"
+#include "../Utilities/Maths.h"
 
 // ---------------------------------------------------------------------- default constructor
 
 Lambertian::Lambertian(void) 
 	:   BRDF(),
 		kd(0.0), 
-		cd(0.0)
+		cd(0.0),
+		texture_ptr(NULL)
 {}
 
 
@@ -15,7 +18,8 @@ Lambertian::Lambertian(void)
 Lambertian::Lambertian(const Lambertian& lamb) 
 	:   BRDF(lamb),
 		kd(lamb.kd), 
-		cd(lamb.cd)
+		cd(lamb.cd),
+		texture_ptr(lamb.texture_ptr ? lamb.texture_ptr->clone() : NULL)
 {}
 
 
@@ -29,7 +33,9 @@ Lambertian::clone(void) const {
 
 // ---------------------------------------------------------------------- destructor
 
-Lambertian::~Lambertian(void) {}
+Lambertian::~Lambertian(void) {
+	delete texture_ptr;
+}
 
 
 // ---------------------------------------------------------------------- assignment operator
@@ -43,24 +49,41 @@ Lambertian::operator= (const Lambertian& rhs) {
 	
 	kd = rhs.kd; 
 	cd = rhs.cd;
+
+	delete texture_ptr;
+	texture_ptr = rhs.texture_ptr ? rhs.texture_ptr->clone() : NULL;
 	
 	return (*this);
 }
 
 
-// ---------------------------------------------------------------------- f
+// ---------------------------------------------------------------------- sample_f
+// a path takes one direction per hit, so the point in the unit square is drawn at random rather
+// than from a sampler's sets; it's mapped to the hemisphere with density cos(theta) / PI about the
+// normal, in the frame AmbientOccluder uses
 
 RGBColor
-Lambertian::f(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const {
-	return (kd * cd * invPI);
-}
+Lambertian::sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wi, float& pdf) const {
+	Vector3D w(sr.normal);
+	Vector3D v = w ^ Vector3D(0.0072, 1.0, 0.0034);
+	v.normalize();
+	Vector3D u = v ^ w;
 
+	float phi 		= 2.0 * PI * random_float();
+	float cos_theta = sqrt(1.0 - random_float());
+	float sin_theta = sqrt(1.0 - cos_theta * cos_theta);
 
-// ---------------------------------------------------------------------- rho
+	wi 	= sin_theta * cos(phi) * u + sin_theta * sin(phi) * v + cos_theta * w;
+	pdf = cos_theta * invPI;
 
-RGBColor
-Lambertian::rho(const ShadeRec& sr, const Vector3D& wo) const {
-	return (kd * cd);
+	return (f(sr, wo, wi));
 }
 
 
+// ---------------------------------------------------------------------- set_cd
+
+void
+Lambertian::set_cd(Texture* _texture_ptr) {
+	delete texture_ptr;
+	texture_ptr = _texture_ptr;
+}
@@ -1,7 +1,12 @@
 #ifndef __LAMBERTIAN__
 #define __LAMBERTIAN__
 
+// A Lambertian's colour is cd, or the colour of its texture at the hit if it has one; with a texture,
+// f and rho depend on the hit, and constant_f and constant_rho are meaningless.
+
 #include "BRDF.h"
+#include "../Textures/Texture.h"
+#include "../Utilities/Constants.h"
 
 class Lambertian: public BRDF {
 	public:
@@ -21,8 +26,20 @@ class Lambertian: public BRDF {
 		virtual RGBColor
 		f(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const;
 		
+		virtual RGBColor										// cosine weighted
+		sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wi, float& pdf) const;
+
 		virtual RGBColor
 		rho(const ShadeRec& sr, const Vector3D& wo) const;
+
+		virtual float
+		pdf(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const;
+
+		RGBColor												// f, which doesn't depend on the directions
+		constant_f(void) const;
+
+		RGBColor												// rho, which doesn't depend on the direction
+		constant_rho(void) const;
 			
 		void
 		set_ka(const float ka);	
@@ -38,11 +55,18 @@ class Lambertian: public BRDF {
 		
 		void													
 		set_cd(const float c);
+
+		void													// takes ownership; NULL goes back to cd
+		set_cd(Texture* texture_ptr);
+
+		bool
+		has_texture(void) const;
 					
 	private:
 	
 		float		kd;
 		RGBColor 	cd;
+		Texture*	texture_ptr;
 };
 
 
@@ -88,4 +112,61 @@ Lambertian::set_cd(const float c) {
 	cd.r = c; cd.g = c; cd.b = c;
 }
 
+
+// ---------------------------------------------------------------- has_texture
+
+inline bool
+Lambertian::has_texture(void) const {
+	return (texture_ptr != NULL);
+}
+
+
+// ---------------------------------------------------------------------- f
+// f and rho are inlined so that, without a texture, they cost no more than reading kd and cd
+
+inline RGBColor
+Lambertian::f(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const {
+	if (texture_ptr)
+		return (kd * texture_ptr->get_color(sr) * invPI);
+
+	return (constant_f());
+}
+
+
+// ---------------------------------------------------------------------- rho
+
+inline RGBColor
+Lambertian::rho(const ShadeRec& sr, const Vector3D& wo) const {
+	if (texture_ptr)
+		return (kd * texture_ptr->get_color(sr));
+
+	return (constant_rho());
+}
+
+
+// ---------------------------------------------------------------------- pdf
+
+inline float
+Lambertian::pdf(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wi) const {
+	float ndotwi = sr.normal * wi;
+
+	return (ndotwi > 0.0f ? ndotwi * invPI : 0.0f);
+}
+
+
+// ---------------------------------------------------------------------- constant_f
+
+inline RGBColor
+Lambertian::constant_f(void) const {
+	return (kd * cd * invPI);
+}
+
+
+// ---------------------------------------------------------------------- constant_rho
+
+inline RGBColor
+Lambertian::constant_rho(void) const {
+	return (kd * cd);
+}
+
 #endif
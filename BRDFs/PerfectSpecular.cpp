@@ -0,0 +1,64 @@
+// This file contains the definition of the class PerfectSpecular
+
+#include <math.h>
+
+#include "PerfectSpecular.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------- default constructor
+
+PerfectSpecular::PerfectSpecular(void)
+	:	BRDF(),
+		kr(0.0), 
+		cr(1.0)
+{}
+
+
+// ---------------------------------------------------------- copy constructor
+
+PerfectSpecular::PerfectSpecular(const PerfectSpecular& ps)
+	:	BRDF(ps),
+		kr(ps.kr), 
+		cr(ps.cr)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+PerfectSpecular* 
+PerfectSpecular::clone(void) const {
+	return (new PerfectSpecular(*this));
+}	
+
+
+// ---------------------------------------------------------- destructor
+
+PerfectSpecular::~PerfectSpecular(void) {}
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+PerfectSpecular& 
+PerfectSpecular::operator= (const PerfectSpecular& rhs) {
+	if (this == &rhs)
+		return (*this);
+		
+	BRDF::operator= (rhs);
+	
+	kr = rhs.kr; 
+	cr = rhs.cr;
+	
+	return (*this);
+}
+
+
+// ---------------------------------------------------------- sample_f
+// wi is wo reflected about the normal
+
+RGBColor
+PerfectSpecular::sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wi) const {
+	float ndotwo = sr.normal * wo;
+	wi = -wo + 2.0 * ndotwo * Vector3D(sr.normal);
+	
+	return (kr * cr / fabs(sr.normal * wi));
+}
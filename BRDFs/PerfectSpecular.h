@@ -0,0 +1,78 @@
+#ifndef __PERFECT_SPECULAR__
+#define __PERFECT_SPECULAR__
+
+// This file contains the declaration of the class PerfectSpecular, the BRDF of a mirror
+// Its f is a delta function, so it has no f or rho; sample_f returns the mirror direction, with the
+// reflectance divided by the cosine, so that the cosine in the shading cancels.
+
+#include "BRDF.h"
+
+class PerfectSpecular: public BRDF {
+	public:
+	
+		PerfectSpecular(void);
+		
+		PerfectSpecular(const PerfectSpecular& ps);
+		
+		virtual PerfectSpecular*
+		clone(void) const;
+		
+		~PerfectSpecular(void);
+		
+		PerfectSpecular& 
+		operator= (const PerfectSpecular& rhs);
+		
+		virtual RGBColor
+		sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wi) const;
+			
+		void
+		set_kr(const float k);
+		
+		void
+		set_cr(const RGBColor& c);
+		
+		void													
+		set_cr(const float r, const float g, const float b);
+		
+		void													
+		set_cr(const float c);
+					
+	private:
+	
+		float		kr;			// reflection coefficient
+		RGBColor 	cr;			// the reflection colour
+};
+
+
+// -------------------------------------------------------------- set_kr
+
+inline void
+PerfectSpecular::set_kr(const float k) {
+	kr = k;
+}
+
+
+// -------------------------------------------------------------- set_cr
+
+inline void
+PerfectSpecular::set_cr(const RGBColor& c) {
+	cr = c;
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void													
+PerfectSpecular::set_cr(const float r, const float g, const float b) {
+	cr.r = r; cr.g = g; cr.b = b;
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void													
+PerfectSpecular::set_cr(const float c) {
+	cr.r = c; cr.g = c; cr.b = c;
+}
+
+#endif
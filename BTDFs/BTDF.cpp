@@ -0,0 +1,61 @@
+// This file contains the definition of the class BTDF
+
+#include "../Utilities/Constants.h"
+#include "BTDF.h"
+
+// ---------------------------------------------------------- default constructor
+
+BTDF::BTDF(void) {}
+
+
+// ---------------------------------------------------------- copy constructor
+
+BTDF::BTDF(const BTDF& btdf) {}	
+
+
+// --------------------------------------------------------------- assignment operator
+
+BTDF&														
+BTDF::operator= (const BTDF& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------- destructor
+
+BTDF::~BTDF(void) {}  
+
+
+// ------------------------------------------------------------------------ f
+
+RGBColor
+BTDF::f(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wt) const {
+	return (black);
+}
+
+
+// ------------------------------------------------------------------------ sample_f
+
+RGBColor
+BTDF::sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wt) const {
+	return (black);
+}
+
+
+// ------------------------------------------------------------------------ rho	
+	
+RGBColor
+BTDF::rho(const ShadeRec& sr, const Vector3D& wo) const {
+	return (black);
+}
+
+
+// ------------------------------------------------------------------------ tir
+	
+bool
+BTDF::tir(const ShadeRec& sr) const {
+	return (false);
+}
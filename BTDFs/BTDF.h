@@ -0,0 +1,43 @@
+#ifndef __BTDF__
+#define __BTDF__
+
+// This file contains the declaration of the base class BTDF, for light transmitted through a surface
+
+#include <math.h>
+
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/Vector3D.h"
+#include "../Utilities/ShadeRec.h"
+
+class BTDF {
+	public:
+	
+		BTDF(void);						
+		
+		BTDF(const BTDF& btdf);
+		
+		virtual BTDF*
+		clone(void) const = 0;
+		
+		virtual
+		~BTDF(void);
+								
+		virtual RGBColor
+		f(const ShadeRec& sr, const Vector3D& wo, const Vector3D& wt) const;
+		
+		virtual RGBColor
+		sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wt) const;
+		
+		virtual RGBColor
+		rho(const ShadeRec& sr, const Vector3D& wo) const;
+
+		virtual bool									// total internal reflection?
+		tir(const ShadeRec& sr) const;
+			
+	protected:
+	
+		BTDF&							
+		operator= (const BTDF& rhs);
+};
+
+#endif
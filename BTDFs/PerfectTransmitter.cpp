@@ -0,0 +1,89 @@
+// This file contains the definition of the class PerfectTransmitter
+
+#include "PerfectTransmitter.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------- default constructor
+
+PerfectTransmitter::PerfectTransmitter(void)
+	:	BTDF(),
+		kt(0.0), 
+		ior(1.0)
+{}
+
+
+// ---------------------------------------------------------- copy constructor
+
+PerfectTransmitter::PerfectTransmitter(const PerfectTransmitter& pt)
+	:	BTDF(pt),
+		kt(pt.kt), 
+		ior(pt.ior)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+PerfectTransmitter* 
+PerfectTransmitter::clone(void) const {
+	return (new PerfectTransmitter(*this));
+}	
+
+
+// ---------------------------------------------------------- destructor
+
+PerfectTransmitter::~PerfectTransmitter(void) {}
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+PerfectTransmitter& 
+PerfectTransmitter::operator= (const PerfectTransmitter& rhs) {
+	if (this == &rhs)
+		return (*this);
+		
+	BTDF::operator= (rhs);
+	
+	kt 	= rhs.kt; 
+	ior = rhs.ior;
+	
+	return (*this);
+}
+
+
+// ---------------------------------------------------------- tir
+// the ray is leaving the object if it hits the inside of the surface
+
+bool
+PerfectTransmitter::tir(const ShadeRec& sr) const {
+	Vector3D 	wo(-sr.ray.d);
+	double 		cos_thetai 	= sr.normal * wo;
+	double 		eta 		= ior;
+
+	if (cos_thetai < 0.0)
+		eta = 1.0 / eta;
+
+	return (1.0 - (1.0 - cos_thetai * cos_thetai) / (eta * eta) < 0.0);
+}
+
+
+// ---------------------------------------------------------- sample_f
+// this must not be called when tir is true
+
+RGBColor
+PerfectTransmitter::sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wt) const {
+	Vector3D 	n(sr.normal);
+	double 		cos_thetai 	= n * wo;
+	double 		eta 		= ior;
+
+	if (cos_thetai < 0.0) {			// transmitted ray is outside
+		cos_thetai 	= -cos_thetai;
+		n 			= -n;
+		eta 		= 1.0 / eta;
+	}
+
+	double temp 		= 1.0 - (1.0 - cos_thetai * cos_thetai) / (eta * eta);
+	double cos_theta2 	= sqrt(temp);
+	wt = -wo / eta - (cos_theta2 - cos_thetai / eta) * n;
+
+	return (kt / (eta * eta) * white / fabs(sr.normal * wt));
+}
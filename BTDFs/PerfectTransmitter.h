@@ -0,0 +1,60 @@
+#ifndef __PERFECT_TRANSMITTER__
+#define __PERFECT_TRANSMITTER__
+
+// This file contains the declaration of the class PerfectTransmitter, the BTDF of clear glass or water
+// sample_f returns the direction refracted by Snell's law, with the transmission coefficient scaled by
+// 1 / eta^2 for the change in solid angle and divided by the cosine, so that the cosine in the shading
+// cancels. The normal is taken to point outside, into the medium with index 1.
+
+#include "BTDF.h"
+
+class PerfectTransmitter: public BTDF {
+	public:
+	
+		PerfectTransmitter(void);
+		
+		PerfectTransmitter(const PerfectTransmitter& pt);
+		
+		virtual PerfectTransmitter*
+		clone(void) const;
+		
+		~PerfectTransmitter(void);
+		
+		PerfectTransmitter& 
+		operator= (const PerfectTransmitter& rhs);
+		
+		void
+		set_kt(const float k);
+		
+		void
+		set_ior(const float eta);
+
+		virtual bool
+		tir(const ShadeRec& sr) const;
+		
+		virtual RGBColor
+		sample_f(const ShadeRec& sr, const Vector3D& wo, Vector3D& wt) const;
+		
+	private:
+	
+		float	kt;			// transmission coefficient
+		float	ior;		// index of refraction
+};
+
+
+// -------------------------------------------------------------- set_kt
+
+inline void
+PerfectTransmitter::set_kt(const float k) {
+	kt = k;
+}
+
+
+// -------------------------------------------------------------- set_ior
+
+inline void
+PerfectTransmitter::set_ior(const float eta) {
+	ior = eta;
+}
+
+#endif
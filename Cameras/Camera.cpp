@@ -57,6 +57,40 @@ Camera::operator= (const Camera& rhs) {
 Camera::~Camera(void) {}
 
 
+// ----------------------------------------------------------------- get_rays
+// one ray at a time; cameras override this when they can share work between the rays
+// only the origins and directions are set, so the rays keep their times
+
+void
+Camera::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	for (int j = 0; j < n; j++) {
+		Ray ray = get_ray(vp, pp[j]);
+
+		rays[j].o = ray.o;
+		rays[j].d = ray.d;
+	}
+}
+
+
+// ----------------------------------------------------------------- get_differentials
+// the rays through the points one pixel across and one pixel up from pp; a camera whose rays through
+// nearby points don't all start at the eye, such as a thin lens camera, overrides this
+// a differential ray with a zero direction, off the edge of a fisheye camera's image circle, leaves the
+// ray without differentials
+
+void
+Camera::get_differentials(const ViewPlane& vp, const Point2D& pp, Ray& ray) const {
+	Ray rx = get_ray(vp, Point2D(pp.x + vp.s, pp.y));
+	Ray ry = get_ray(vp, Point2D(pp.x, pp.y + vp.s));
+
+	ray.has_differentials = rx.d * rx.d > 0.0 && ry.d * ry.d > 0.0;
+
+	if (ray.has_differentials) {
+		ray.rx_o = rx.o; ray.rx_d = rx.d;
+		ray.ry_o = ry.o; ray.ry_d = ry.d;
+	}
+}
+
 
 //-------------------------------------------------------------- compute_uvw
 
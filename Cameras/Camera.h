@@ -3,11 +3,18 @@
 
 // This file contains the declaration of the base class Camera
 // There is no view plane distance because the fisheye and panoramic cameras don't use it
-
+// Cameras only make rays: World::render_scene schedules the tiles, samples the pixels, traces the rays
+// and writes the image, whatever the camera. World::render_tile asks the camera for the primary rays
+// of a pixel's samples all at once, through get_rays, so a camera can set up its per-pixel work once
+// and each sample costs one ray, not a virtual call. A ray with a zero direction is no ray: the
+// sample is black, as it is for the points of a fisheye camera's view plane outside its image circle.
+// When the view plane asks for ray differentials, render_tile then has the camera add them to each ray.
+
+#include "../Utilities/Point2D.h"
 #include "../Utilities/Point3D.h"
+#include "../Utilities/Ray.h"
 #include "../Utilities/Vector3D.h"
-
-class World;  // can't #include "World" here because World contains a camera pointer
+#include "../World/ViewPlane.h"
 
 //--------------------------------------------------------------------- class Camera
 
@@ -24,8 +31,14 @@ class Camera {
 		virtual
 		~Camera();   							
 
-		virtual void 																		
-		render_scene(const World& w) = 0;
+		virtual Ray								// the ray through the point pp on the view plane
+		get_ray(const ViewPlane& vp, const Point2D& pp) const = 0;
+
+		virtual void							// the rays through the n points pp, into rays' origins and directions
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
+
+		virtual void							// the differentials of the ray through pp, one pixel across and up
+		get_differentials(const ViewPlane& vp, const Point2D& pp, Ray& ray) const;
 		
 		void
 		set_eye(const Point3D& p);
@@ -50,6 +63,9 @@ class Camera {
 		
 		void
 		set_exposure_time(const float exposure);
+
+		float
+		get_exposure_time(void) const;
 		
 		void									
 		compute_uvw(void);
@@ -136,4 +152,12 @@ Camera::set_exposure_time(const float exposure) {
 }
 
 
+// ----------------------------------------------------------------- get_exposure_time
+
+inline float
+Camera::get_exposure_time(void) const {
+	return (exposure_time);
+}
+
+
 #endif
\ No newline at end of file
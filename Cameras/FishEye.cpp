@@ -0,0 +1,92 @@
+// This file contains the definition of the FishEye class
+
+#include <math.h>
+
+#include "FishEye.h"
+#include "../Utilities/Constants.h"
+
+// ----------------------------------------------------------------------------- default constructor
+
+FishEye::FishEye(void)
+	:	Camera(),
+		psi_max(90.0)
+{}
+
+
+// ----------------------------------------------------------------------------- copy constructor
+
+FishEye::FishEye(const FishEye& fe)
+	: 	Camera(fe),
+		psi_max(fe.psi_max)
+{}
+
+
+// ----------------------------------------------------------------------------- clone
+
+Camera*
+FishEye::clone(void) const {
+	return (new FishEye(*this));
+}
+
+
+// ----------------------------------------------------------------------------- assignment operator
+
+FishEye&
+FishEye::operator= (const FishEye& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Camera::operator= (rhs);
+
+	psi_max = rhs.psi_max;
+
+	return (*this);
+}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+FishEye::~FishEye(void) {}
+
+
+// ----------------------------------------------------------------------------- ray_direction
+// pp is normalised so that the image circle is the unit circle; alpha is the angle of the point about
+// the centre, and psi the angle of the direction to -w
+
+Vector3D
+FishEye::ray_direction(const ViewPlane& vp, const Point2D& pp) const {
+	double 	scale 	= vp.hres < vp.vres ? vp.hres : vp.vres;
+	double 	x 		= 2.0 / (vp.s * scale) * pp.x;
+	double 	y 		= 2.0 / (vp.s * scale) * pp.y;
+	double 	r 		= sqrt(x * x + y * y);
+
+	if (r > 1.0)
+		return (Vector3D(0.0));
+
+	if (r == 0.0)
+		return (-w);
+
+	double psi 		= r * psi_max * PI_ON_180;
+	double sin_psi 	= sin(psi);
+
+	return (sin_psi * x / r * u + sin_psi * y / r * v - cos(psi) * w);
+}
+
+
+// ----------------------------------------------------------------------------- get_ray
+
+Ray
+FishEye::get_ray(const ViewPlane& vp, const Point2D& pp) const {
+	return (Ray(eye, ray_direction(vp, pp)));
+}
+
+
+// ----------------------------------------------------------------------------- get_rays
+
+void
+FishEye::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	for (int j = 0; j < n; j++) {
+		rays[j].o = eye;
+		rays[j].d = ray_direction(vp, pp[j]);
+	}
+}
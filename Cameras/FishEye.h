@@ -0,0 +1,55 @@
+#ifndef __FISH_EYE__
+#define __FISH_EYE__
+
+// This file contains the declaration of the class FishEye, a camera with an equidistant fisheye lens
+// The image circle is the largest circle that fits in the view plane. A point on it at a distance r
+// from the centre, as a fraction of the circle's radius, sees the direction at an angle of r * psi_max
+// to the view direction, so the camera sees a cone of half angle psi_max, which can be more than 90
+// degrees. The view plane outside the image circle gets no rays, and is black.
+
+#include "Camera.h"
+
+//--------------------------------------------------------------------- class FishEye
+
+class FishEye: public Camera {
+	public:
+
+		FishEye();
+
+		FishEye(const FishEye& fe);
+
+		virtual Camera*
+		clone(void) const;
+
+		FishEye&
+		operator= (const FishEye& rhs);
+
+		virtual
+		~FishEye();
+
+		void									// the full field of view, in degrees
+		set_fov(const float fov);
+
+		Vector3D								// zero outside the image circle
+		ray_direction(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual Ray
+		get_ray(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual void
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
+
+	private:
+
+		float	psi_max;		// in degrees
+};
+
+
+//-------------------------------------------------------------------------- set_fov
+
+inline void
+FishEye::set_fov(const float fov) {
+	psi_max = 0.5 * fov;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// This file contains the definition of the Orthographic class
+
+#include "Orthographic.h"
+
+// ----------------------------------------------------------------------------- default constructor
+
+Orthographic::Orthographic(void)
+	:	Camera()
+{}
+
+
+// ----------------------------------------------------------------------------- copy constructor
+
+Orthographic::Orthographic(const Orthographic& oc)
+	: 	Camera(oc)
+{}
+
+
+// ----------------------------------------------------------------------------- clone
+
+Camera*
+Orthographic::clone(void) const {
+	return (new Orthographic(*this));
+}
+
+
+// ----------------------------------------------------------------------------- assignment operator
+
+Orthographic&
+Orthographic::operator= (const Orthographic& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Camera::operator= (rhs);
+
+	return (*this);
+}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+Orthographic::~Orthographic(void) {}
+
+
+// ----------------------------------------------------------------------------- get_ray
+
+Ray
+Orthographic::get_ray(const ViewPlane& vp, const Point2D& pp) const {
+	return (Ray(eye + pp.x * u + pp.y * v, -w));
+}
+
+
+// ----------------------------------------------------------------------------- get_rays
+
+void
+Orthographic::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	Vector3D d = -w;
+
+	for (int j = 0; j < n; j++) {
+		rays[j].o = eye + pp[j].x * u + pp[j].y * v;
+		rays[j].d = d;
+	}
+}
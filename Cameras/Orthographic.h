@@ -0,0 +1,35 @@
+#ifndef __ORTHOGRAPHIC__
+#define __ORTHOGRAPHIC__
+
+// This file contains the declaration of the class Orthographic, a camera with parallel rays
+// Every ray goes along -w, from the point of the view plane through the eye that the view plane point
+// gives. World renders through one looking down the z axis from z = 100 when no camera is set.
+
+#include "Camera.h"
+
+//--------------------------------------------------------------------- class Orthographic
+
+class Orthographic: public Camera {
+	public:
+
+		Orthographic();
+
+		Orthographic(const Orthographic& oc);
+
+		virtual Camera*
+		clone(void) const;
+
+		Orthographic&
+		operator= (const Orthographic& rhs);
+
+		virtual
+		~Orthographic();
+
+		virtual Ray
+		get_ray(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual void
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
+};
+
+#endif
@@ -1,10 +1,8 @@
 // This file contains the definition of the Pinhole class
 
-#include "../Utilities/Constants.h"
 #include "../Utilities/Point3D.h"
 #include "../Utilities/Vector3D.h"
 #include "Pinhole.h"
-#include <math.h>
 
 // ----------------------------------------------------------------------------- default constructor
 
@@ -65,42 +63,20 @@ Pinhole::get_direction(const Point2D& p) const {
 }
 
 
+// ----------------------------------------------------------------------------- get_ray
 
-// ----------------------------------------------------------------------------- render_scene
-
-void 												
-Pinhole::render_scene(const World& w) {
-	RGBColor	L;
-	ViewPlane	vp(w.vp);	 								
-	Ray			ray;
-	int 		depth = 0;  
-	Point2D 	pp;		// sample point on a pixel
-	int n = (int)sqrt((float)vp.num_samples);
-		
-	vp.s /= zoom;
-	ray.o = eye;
-
-    std::ofstream myFile;
-    myFile.open("image.ppm");
-
-    myFile << "P3\n" << vp.vres << " " << vp.hres << " " << "\n255\n";
-
-	for (int r = 0; r < vp.vres; r++)			// up
-		for (int c = 0; c < vp.hres; c++) {		// across 					
-			L = black; 
-			
-			for (int p = 0; p <= n; p--)			// up pixel
-				for (int q = 0; q < n; q++) {	// across pixel
-					pp.x = vp.s * (c - 0.5 * vp.hres + (q + 0.5) / n); 
-					pp.y = vp.s * (r - 0.5 * vp.vres + (p + 0.5) / n);
-					ray.d = get_direction(pp);
-					L += w.tracer_ptr->trace_ray(ray, depth);
-				}	
-											
-			L /= vp.num_samples;
-			L *= exposure_time;
-			w.display_pixel(r, c, L, myFile);
-		} 
+Ray
+Pinhole::get_ray(const ViewPlane& vp, const Point2D& pp) const {
+	return (Ray(eye, get_direction(Point2D(pp.x / zoom, pp.y / zoom))));
 }
 
 
+// ----------------------------------------------------------------------------- get_rays
+
+void
+Pinhole::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	for (int j = 0; j < n; j++) {
+		rays[j].o = eye;
+		rays[j].d = get_direction(Point2D(pp[j].x / zoom, pp[j].y / zoom));
+	}
+}
@@ -3,8 +3,8 @@
 
 // This file contains the declaration of the class Pinhole
 
+#include "Camera.h"
 #include "../Utilities/Point2D.h"
-#include "../World/World.h"    // we can #include "World.h" here
 
 //--------------------------------------------------------------------- class Pinhole
 
@@ -33,8 +33,11 @@ class Pinhole: public Camera {
 		Vector3D								
 		get_direction(const Point2D& p) const;
 		
-		virtual void 												
-		render_scene(const World& w);
+		virtual Ray
+		get_ray(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual void
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
 		
 	private:
 			
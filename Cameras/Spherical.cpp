@@ -0,0 +1,89 @@
+// This file contains the definition of the Spherical class
+
+#include <math.h>
+
+#include "Spherical.h"
+#include "../Utilities/Constants.h"
+
+// ----------------------------------------------------------------------------- default constructor
+
+Spherical::Spherical(void)
+	:	Camera(),
+		lambda_max(180.0),
+		psi_max(90.0)
+{}
+
+
+// ----------------------------------------------------------------------------- copy constructor
+
+Spherical::Spherical(const Spherical& sph)
+	: 	Camera(sph),
+		lambda_max(sph.lambda_max),
+		psi_max(sph.psi_max)
+{}
+
+
+// ----------------------------------------------------------------------------- clone
+
+Camera*
+Spherical::clone(void) const {
+	return (new Spherical(*this));
+}
+
+
+// ----------------------------------------------------------------------------- assignment operator
+
+Spherical&
+Spherical::operator= (const Spherical& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Camera::operator= (rhs);
+
+	lambda_max 	= rhs.lambda_max;
+	psi_max 	= rhs.psi_max;
+
+	return (*this);
+}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+Spherical::~Spherical(void) {}
+
+
+// ----------------------------------------------------------------------------- ray_direction
+// lambda is the azimuth, from -w towards u, and psi the elevation; phi and theta are the polar angles
+// of the direction, with the pole along v and phi measured from w
+
+Vector3D
+Spherical::ray_direction(const ViewPlane& vp, const Point2D& pp) const {
+	double x 			= 2.0 / (vp.s * vp.hres) * pp.x;
+	double y 			= 2.0 / (vp.s * vp.vres) * pp.y;
+	double lambda 		= x * lambda_max * PI_ON_180;
+	double psi 			= y * psi_max * PI_ON_180;
+	double phi 			= PI - lambda;
+	double theta 		= 0.5 * PI - psi;
+	double sin_theta 	= sin(theta);
+
+	return (sin_theta * sin(phi) * u + cos(theta) * v + sin_theta * cos(phi) * w);
+}
+
+
+// ----------------------------------------------------------------------------- get_ray
+
+Ray
+Spherical::get_ray(const ViewPlane& vp, const Point2D& pp) const {
+	return (Ray(eye, ray_direction(vp, pp)));
+}
+
+
+// ----------------------------------------------------------------------------- get_rays
+
+void
+Spherical::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	for (int j = 0; j < n; j++) {
+		rays[j].o = eye;
+		rays[j].d = ray_direction(vp, pp[j]);
+	}
+}
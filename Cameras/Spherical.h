@@ -0,0 +1,57 @@
+#ifndef __SPHERICAL__
+#define __SPHERICAL__
+
+// This file contains the declaration of the class Spherical, a panoramic camera
+// The view plane maps linearly onto azimuth and elevation angles about the view direction: its left
+// and right edges are lambda_max degrees either side of -w, about v, and its bottom and top edges
+// psi_max degrees below and above it. A horizontal field of view of 360 and a vertical one of 180
+// degrees give the whole sphere of directions, as an equirectangular image.
+
+#include "Camera.h"
+
+//--------------------------------------------------------------------- class Spherical
+
+class Spherical: public Camera {
+	public:
+
+		Spherical();
+
+		Spherical(const Spherical& sph);
+
+		virtual Camera*
+		clone(void) const;
+
+		Spherical&
+		operator= (const Spherical& rhs);
+
+		virtual
+		~Spherical();
+
+		void									// the full fields of view, in degrees
+		set_fov(const float horizontal, const float vertical);
+
+		Vector3D
+		ray_direction(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual Ray
+		get_ray(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual void
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
+
+	private:
+
+		float	lambda_max;		// in degrees
+		float	psi_max;		// in degrees
+};
+
+
+//-------------------------------------------------------------------------- set_fov
+
+inline void
+Spherical::set_fov(const float horizontal, const float vertical) {
+	lambda_max 	= 0.5 * horizontal;
+	psi_max 	= 0.5 * vertical;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// This file contains the definition of the ThinLens class
+
+#include "ThinLens.h"
+#include "../Samplers/Jittered.h"
+
+// ----------------------------------------------------------------------------- default constructor
+
+ThinLens::ThinLens(void)
+	:	Camera(),
+		lens_radius(1.0),
+		d(500),
+		f(1000),
+		zoom(1.0)
+{
+	set_num_samples(16);
+}
+
+
+// ----------------------------------------------------------------------------- copy constructor
+
+ThinLens::ThinLens(const ThinLens& tl)
+	: 	Camera(tl),
+		lens_radius(tl.lens_radius),
+		d(tl.d),
+		f(tl.f),
+		zoom(tl.zoom),
+		sampler(tl.sampler)
+{}
+
+
+// ----------------------------------------------------------------------------- clone
+
+Camera*
+ThinLens::clone(void) const {
+	return (new ThinLens(*this));
+}
+
+
+// ----------------------------------------------------------------------------- assignment operator
+
+ThinLens&
+ThinLens::operator= (const ThinLens& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Camera::operator= (rhs);
+
+	lens_radius	= rhs.lens_radius;
+	d 			= rhs.d;
+	f 			= rhs.f;
+	zoom		= rhs.zoom;
+	sampler		= rhs.sampler;
+
+	return (*this);
+}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+ThinLens::~ThinLens(void) {}
+
+
+// ----------------------------------------------------------------------------- set_sampler
+
+void
+ThinLens::set_sampler(Sampler* sampler_ptr) {
+	sampler_ptr->map_samples_to_unit_disk();
+	sampler.set_sampler(sampler_ptr);
+}
+
+
+// ----------------------------------------------------------------------------- set_num_samples
+
+void
+ThinLens::set_num_samples(const int n) {
+	set_sampler(new Jittered(n));
+}
+
+
+// ----------------------------------------------------------------------------- ray_direction
+// the view plane point, scaled out to the focal plane, seen from the lens point
+
+Vector3D
+ThinLens::ray_direction(const Point2D& pp, const Point2D& lp) const {
+	float 		scale 	= f / (d * zoom);
+	Vector3D 	dir 	= (pp.x * scale - lp.x) * u + (pp.y * scale - lp.y) * v - f * w;
+	dir.normalize();
+
+	return (dir);
+}
+
+
+// ----------------------------------------------------------------------------- get_ray
+
+Ray
+ThinLens::get_ray(const ViewPlane& vp, const Point2D& pp) const {
+	Ray ray;
+
+	get_rays(vp, &pp, &ray, 1);
+
+	return (ray);
+}
+
+
+// ----------------------------------------------------------------------------- get_differentials
+// the differential rays leave the same point on the lens as the ray, which is found from its origin,
+// and go through the focal plane one pixel across and up
+
+void
+ThinLens::get_differentials(const ViewPlane& vp, const Point2D& pp, Ray& ray) const {
+	Vector3D 	offset 	= ray.o - eye;
+	Point2D 	lp(offset * u, offset * v);
+
+	ray.has_differentials 	= true;
+	ray.rx_o 				= ray.o;
+	ray.ry_o 				= ray.o;
+	ray.rx_d 				= ray_direction(Point2D(pp.x + vp.s, pp.y), lp);
+	ray.ry_d 				= ray_direction(Point2D(pp.x, pp.y + vp.s), lp);
+}
+
+
+// ----------------------------------------------------------------------------- get_rays
+
+void
+ThinLens::get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const {
+	if (lens_radius == 0.0) {
+		for (int j = 0; j < n; j++) {
+			rays[j].o = eye;
+			rays[j].d = ray_direction(pp[j], Point2D(0.0));
+		}
+		return;
+	}
+
+	Sampler& lens_sampler = sampler.get();
+
+	for (int j = 0; j < n; j++) {
+		Point2D dp = lens_sampler.sample_unit_disk();
+		Point2D lp(dp.x * lens_radius, dp.y * lens_radius);
+
+		rays[j].o = eye + lp.x * u + lp.y * v;
+		rays[j].d = ray_direction(pp[j], lp);
+	}
+}
@@ -0,0 +1,105 @@
+#ifndef __THIN_LENS__
+#define __THIN_LENS__
+
+// This file contains the declaration of the class ThinLens, a camera with a lens of finite size, for
+// depth of field
+// Points on the focal plane, at the focal distance f along -w, are in focus; the rays of a view plane
+// point start from samples on the lens, which is a disk of radius lens_radius about the eye, and all
+// go through the point on the focal plane that the ray from the centre of the lens would hit.
+// The lens samples come from the camera's own sampler, mapped to the unit disk; each render thread
+// draws from its own copy. It should have the view plane's number of samples, so that every pixel
+// uses a whole set. With a lens radius of 0 the camera is a pinhole camera.
+
+#include "Camera.h"
+#include "../Samplers/PerThreadSampler.h"
+
+//--------------------------------------------------------------------- class ThinLens
+
+class ThinLens: public Camera {
+	public:
+
+		ThinLens();
+
+		ThinLens(const ThinLens& tl);
+
+		virtual Camera*
+		clone(void) const;
+
+		ThinLens&
+		operator= (const ThinLens& rhs);
+
+		virtual
+		~ThinLens();
+
+		void
+		set_lens_radius(const float radius);
+
+		void
+		set_view_distance(const float vpd);
+
+		void
+		set_focal_distance(const float fd);
+
+		void
+		set_zoom(const float zoom_factor);
+
+		void									// takes ownership
+		set_sampler(Sampler* sampler_ptr);
+
+		void									// a Jittered sampler with n samples
+		set_num_samples(const int n);
+
+		Vector3D								// the direction from the lens point lp to the one on the focal plane for pp
+		ray_direction(const Point2D& pp, const Point2D& lp) const;
+
+		virtual Ray
+		get_ray(const ViewPlane& vp, const Point2D& pp) const;
+
+		virtual void
+		get_rays(const ViewPlane& vp, const Point2D* pp, Ray* rays, const int n) const;
+
+		virtual void							// from the ray's own point on the lens
+		get_differentials(const ViewPlane& vp, const Point2D& pp, Ray& ray) const;
+
+	private:
+
+		float				lens_radius;
+		float				d;				// view plane distance
+		float				f;				// focal distance
+		float				zoom;			// zoom factor
+		PerThreadSampler	sampler;		// on the unit disk
+};
+
+
+//-------------------------------------------------------------------------- set_lens_radius
+
+inline void
+ThinLens::set_lens_radius(const float radius) {
+	lens_radius = radius;
+}
+
+
+//-------------------------------------------------------------------------- set_view_distance
+
+inline void
+ThinLens::set_view_distance(const float vpd) {
+	d = vpd;
+}
+
+
+//-------------------------------------------------------------------------- set_focal_distance
+
+inline void
+ThinLens::set_focal_distance(const float fd) {
+	f = fd;
+}
+
+
+//-------------------------------------------------------------------------- set_zoom
+
+inline void
+ThinLens::set_zoom(const float zoom_factor) {
+	zoom = zoom_factor;
+}
+
+#endif
@@ -9,13 +9,16 @@
 
 
 GeometricObject::GeometricObject(void)
-	: material_ptr(NULL)
+	: 	material_ptr(NULL),
+		shadows(true)
 {}
 
 
 // ---------------------------------------------------------------------- copy constructor
 
-GeometricObject::GeometricObject (const GeometricObject& object) {
+GeometricObject::GeometricObject (const GeometricObject& object)
+	: 	shadows(object.shadows)
+{
 	if(object.material_ptr)
 		material_ptr = object.material_ptr->clone(); 
 	else  material_ptr = NULL;
@@ -37,6 +40,8 @@ GeometricObject::operator= (const GeometricObject& rhs) {
 	if (rhs.material_ptr)
 		material_ptr = rhs.material_ptr->clone();
 
+	shadows = rhs.shadows;
+
 	return (*this);
 }
 
@@ -59,4 +64,57 @@ GeometricObject::set_material(Material* mPtr) {
 }
 
 
-								
\ No newline at end of file
+// ---------------------------------------------------------------- shadow_hit
+// objects that don't override this never block shadow rays
+
+bool
+GeometricObject::shadow_hit(const Ray& ray, double& t) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------- get_bounds
+
+bool
+GeometricObject::get_bounds(BBox& bounds) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------- get_motion_bounds
+
+bool
+GeometricObject::get_motion_bounds(const double t0, const double t1, BBox& b0, BBox& b1) const {
+	if (!get_bounds(b0))
+		return (false);
+
+	b1 = b0;
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- object_vector
+// an object that isn't an instance is in world space
+
+Vector3D
+GeometricObject::object_vector(const Vector3D& v, const double time) const {
+	return (v);
+}
+
+
+// ---------------------------------------------------------------- sample
+
+Point3D
+GeometricObject::sample(const Point2D& u, Normal& normal) const {
+	normal = Normal();
+	return (Point3D(0.0));
+}
+
+
+// ---------------------------------------------------------------- pdf
+
+float
+GeometricObject::pdf(const ShadeRec& sr) const {
+	return (1.0);
+}
@@ -3,6 +3,8 @@
 
 class Material;
 	
+#include "../Utilities/BBox.h"
+#include "../Utilities/Point2D.h"
 #include "../Utilities/Point3D.h"
 #include "../Utilities/Ray.h"
 #include "../Utilities/ShadeRec.h"
@@ -26,6 +28,32 @@ class GeometricObject {
 			
 		virtual bool 												 
 		hit(const Ray& ray, double& t, ShadeRec& s) const = 0;
+
+		virtual bool 							// hit without the shading data, for shadow rays
+		shadow_hit(const Ray& ray, double& t) const;
+
+		virtual bool							// false for unbounded objects, which the object BVH tests for every ray
+		get_bounds(BBox& bounds) const;
+
+		virtual bool							// boxes at t0 and t1 whose interpolation bounds the object at every time between;
+		get_motion_bounds(const double t0, const double t1, BBox& b0, BBox& b1) const;	// both are the bounds unless it moves
+
+		virtual Vector3D						// a vector at a hit, at the ray's time, in the space of the hit's local_hit_point
+		object_vector(const Vector3D& v, const double time) const;
+
+		void
+		set_shadows(const bool s);
+
+		bool
+		casts_shadows(void) const;
+
+		// the following functions are only needed by objects that are used as area lights
+
+		virtual Point3D							// maps u in the unit square to a point on the surface, and its normal
+		sample(const Point2D& u, Normal& normal) const;
+
+		virtual float							// the density of sample over the surface area
+		pdf(const ShadeRec& sr) const;
 				
 		Material*						
 		get_material(void) const;
@@ -37,6 +65,7 @@ class GeometricObject {
 	protected:
 	
 		mutable Material*   material_ptr;   	// mutable allows Compound::hit, Instance::hit and Grid::hit to assign to material_ptr. hit functions are const
+		bool				shadows;			// does the object block shadow rays?
 	
 		GeometricObject&						// assignment operator
 		operator= (const GeometricObject& rhs);
@@ -50,4 +79,20 @@ GeometricObject::get_material(void) const {
 	return (material_ptr);
 }
 
+
+// ------------------------------------------------------------------------- set_shadows
+
+inline void
+GeometricObject::set_shadows(const bool s) {
+	shadows = s;
+}
+
+
+// ------------------------------------------------------------------------- casts_shadows
+
+inline bool
+GeometricObject::casts_shadows(void) const {
+	return (shadows);
+}
+
 #endif
\ No newline at end of file
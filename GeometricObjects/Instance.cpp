@@ -0,0 +1,306 @@
+// This file contains the definition of the class Instance
+// An instance without a material of its own shares its object's, and leaves it to the object to
+// delete. The material is taken when the object is set, rather than in hit as the book does, so that
+// the render threads don't write to the instance.
+
+#include <math.h>
+#include <utility>
+
+#include "Instance.h"
+#include "../Materials/Material.h"
+#include "../Utilities/Constants.h"
+
+
+// ----------------------------------------------------------------  default constructor
+
+Instance::Instance(void)
+	: 	GeometricObject(),
+		object_ptr(NULL),
+		inv_matrix(),
+		forward_matrix()
+{}
+
+
+// ----------------------------------------------------------------  constructor
+
+Instance::Instance(GeometricObject* obj_ptr)
+	: 	GeometricObject(),
+		object_ptr(NULL),
+		inv_matrix(),
+		forward_matrix()
+{
+	set_object(obj_ptr);
+}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Instance::Instance(const Instance& instance)
+	: 	GeometricObject(),
+		object_ptr(NULL),
+		inv_matrix(instance.inv_matrix),
+		forward_matrix(instance.forward_matrix)
+{
+	shadows = instance.shadows;
+
+	if (instance.object_ptr)
+		set_object(instance.object_ptr->clone());
+
+	if (instance.object_ptr && instance.material_ptr != instance.object_ptr->get_material())
+		material_ptr = instance.material_ptr->clone();
+}
+
+
+// ---------------------------------------------------------------- clone
+
+Instance*
+Instance::clone(void) const {
+	return (new Instance(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Instance&
+Instance::operator= (const Instance& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Instance copy(rhs);
+
+	std::swap(object_ptr, copy.object_ptr);
+	std::swap(material_ptr, copy.material_ptr);
+	std::swap(inv_matrix, copy.inv_matrix);
+	std::swap(forward_matrix, copy.forward_matrix);
+	shadows = rhs.shadows;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Instance::~Instance(void) {
+	if (object_ptr && material_ptr == object_ptr->get_material())
+		material_ptr = NULL;
+
+	delete object_ptr;
+}
+
+
+// ---------------------------------------------------------------- set_object
+
+void
+Instance::set_object(GeometricObject* obj_ptr) {
+	if (object_ptr && material_ptr == object_ptr->get_material())
+		material_ptr = NULL;
+
+	object_ptr = obj_ptr;
+
+	if (object_ptr && !material_ptr)
+		material_ptr = object_ptr->get_material();
+}
+
+
+// ---------------------------------------------------------------- hit
+// local_hit_point is left in the object's space, where textures would be applied
+
+bool
+Instance::hit(const Ray& ray, double& t, ShadeRec& sr) const {
+	Ray inv_ray;
+
+	inv_ray.o 		= inv_matrix * ray.o;
+	inv_ray.d 		= inv_matrix * ray.d;
+	inv_ray.time 	= ray.time;
+
+	if (object_ptr->hit(inv_ray, t, sr)) {
+		sr.normal = inv_matrix * sr.normal;
+		sr.normal.normalize();
+
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ---------------------------------------------------------------- object_vector
+
+Vector3D
+Instance::object_vector(const Vector3D& v, const double time) const {
+	return (object_ptr->object_vector(inv_matrix * v, time));
+}
+
+
+// ---------------------------------------------------------------- shadow_hit
+
+bool
+Instance::shadow_hit(const Ray& ray, double& t) const {
+	Ray inv_ray;
+
+	inv_ray.o 		= inv_matrix * ray.o;
+	inv_ray.d 		= inv_matrix * ray.d;
+	inv_ray.time 	= ray.time;
+
+	return (object_ptr->shadow_hit(inv_ray, t));
+}
+
+
+// ---------------------------------------------------------------- get_bounds
+// the box of the transformed corners of the object's box
+
+bool
+Instance::get_bounds(BBox& bounds) const {
+	BBox object_bounds;
+
+	if (!object_ptr || !object_ptr->get_bounds(object_bounds))
+		return (false);
+
+	bounds = BBox();
+
+	for (int j = 0; j < 8; j++) {
+		Point3D corner(j & 1 ? object_bounds.p_max.x : object_bounds.p_min.x,
+					   j & 2 ? object_bounds.p_max.y : object_bounds.p_min.y,
+					   j & 4 ? object_bounds.p_max.z : object_bounds.p_min.z);
+
+		bounds = bbox_union(bounds, forward_matrix * corner);
+	}
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- set_identity
+
+void
+Instance::set_identity(void) {
+	inv_matrix.set_identity();
+	forward_matrix.set_identity();
+}
+
+
+// ---------------------------------------------------------------- translate
+// each transformation multiplies the inverse on the right by its own inverse, and the forward
+// transformation on the left by itself
+
+void
+Instance::translate(const double dx, const double dy, const double dz) {
+	Matrix inv_translation_matrix;
+
+	inv_translation_matrix.m[0][3] = -dx;
+	inv_translation_matrix.m[1][3] = -dy;
+	inv_translation_matrix.m[2][3] = -dz;
+
+	inv_matrix = inv_matrix * inv_translation_matrix;
+
+	Matrix translation_matrix;
+
+	translation_matrix.m[0][3] = dx;
+	translation_matrix.m[1][3] = dy;
+	translation_matrix.m[2][3] = dz;
+
+	forward_matrix = translation_matrix * forward_matrix;
+}
+
+
+// ---------------------------------------------------------------- scale
+
+void
+Instance::scale(const double a, const double b, const double c) {
+	Matrix inv_scaling_matrix;
+
+	inv_scaling_matrix.m[0][0] = 1.0 / a;
+	inv_scaling_matrix.m[1][1] = 1.0 / b;
+	inv_scaling_matrix.m[2][2] = 1.0 / c;
+
+	inv_matrix = inv_matrix * inv_scaling_matrix;
+
+	Matrix scaling_matrix;
+
+	scaling_matrix.m[0][0] = a;
+	scaling_matrix.m[1][1] = b;
+	scaling_matrix.m[2][2] = c;
+
+	forward_matrix = scaling_matrix * forward_matrix;
+}
+
+
+// ---------------------------------------------------------------- rotate_x
+
+void
+Instance::rotate_x(const double theta) {
+	double sin_theta = sin(theta * PI_ON_180);
+	double cos_theta = cos(theta * PI_ON_180);
+
+	Matrix inv_x_rotation_matrix;
+
+	inv_x_rotation_matrix.m[1][1] = cos_theta;
+	inv_x_rotation_matrix.m[1][2] = sin_theta;
+	inv_x_rotation_matrix.m[2][1] = -sin_theta;
+	inv_x_rotation_matrix.m[2][2] = cos_theta;
+
+	inv_matrix = inv_matrix * inv_x_rotation_matrix;
+
+	Matrix x_rotation_matrix;
+
+	x_rotation_matrix.m[1][1] = cos_theta;
+	x_rotation_matrix.m[1][2] = -sin_theta;
+	x_rotation_matrix.m[2][1] = sin_theta;
+	x_rotation_matrix.m[2][2] = cos_theta;
+
+	forward_matrix = x_rotation_matrix * forward_matrix;
+}
+
+
+// ---------------------------------------------------------------- rotate_y
+
+void
+Instance::rotate_y(const double theta) {
+	double sin_theta = sin(theta * PI_ON_180);
+	double cos_theta = cos(theta * PI_ON_180);
+
+	Matrix inv_y_rotation_matrix;
+
+	inv_y_rotation_matrix.m[0][0] = cos_theta;
+	inv_y_rotation_matrix.m[0][2] = -sin_theta;
+	inv_y_rotation_matrix.m[2][0] = sin_theta;
+	inv_y_rotation_matrix.m[2][2] = cos_theta;
+
+	inv_matrix = inv_matrix * inv_y_rotation_matrix;
+
+	Matrix y_rotation_matrix;
+
+	y_rotation_matrix.m[0][0] = cos_theta;
+	y_rotation_matrix.m[0][2] = sin_theta;
+	y_rotation_matrix.m[2][0] = -sin_theta;
+	y_rotation_matrix.m[2][2] = cos_theta;
+
+	forward_matrix = y_rotation_matrix * forward_matrix;
+}
+
+
+// ---------------------------------------------------------------- rotate_z
+
+void
+Instance::rotate_z(const double theta) {
+	double sin_theta = sin(theta * PI_ON_180);
+	double cos_theta = cos(theta * PI_ON_180);
+
+	Matrix inv_z_rotation_matrix;
+
+	inv_z_rotation_matrix.m[0][0] = cos_theta;
+	inv_z_rotation_matrix.m[0][1] = sin_theta;
+	inv_z_rotation_matrix.m[1][0] = -sin_theta;
+	inv_z_rotation_matrix.m[1][1] = cos_theta;
+
+	inv_matrix = inv_matrix * inv_z_rotation_matrix;
+
+	Matrix z_rotation_matrix;
+
+	z_rotation_matrix.m[0][0] = cos_theta;
+	z_rotation_matrix.m[0][1] = -sin_theta;
+	z_rotation_matrix.m[1][0] = sin_theta;
+	z_rotation_matrix.m[1][1] = cos_theta;
+
+	forward_matrix = z_rotation_matrix * forward_matrix;
+}
@@ -0,0 +1,99 @@
+#ifndef __INSTANCE__
+#define __INSTANCE__
+
+// This file contains the declaration of the class Instance, which places an object in the scene
+// with an affine transformation
+// The hit functions transform the ray into the object's space by the inverse transformation and test
+// it against the object; the direction isn't renormalised, so t is the same in both spaces. Normals
+// are transformed by the transpose of the inverse. The forward transformation is only kept for the
+// bounds.
+// The transformations are applied in the order in which they are called: scale, then rotate, then
+// translate places the object as expected. The instance owns its object.
+
+#include "GeometricObject.h"
+#include "../Utilities/Matrix.h"
+
+//-------------------------------------------------------------------------------- class Instance
+
+class Instance: public GeometricObject {
+
+	public:
+
+		Instance(void);
+
+		Instance(GeometricObject* obj_ptr);
+
+		Instance(const Instance& instance);
+
+		virtual Instance*
+		clone(void) const;
+
+		Instance&
+		operator= (const Instance& rhs);
+
+		virtual
+		~Instance(void);
+
+		void									// the instance takes the object's material if it has none of its own
+		set_object(GeometricObject* obj_ptr);
+
+		GeometricObject*
+		get_object(void) const;
+
+		virtual bool
+		hit(const Ray& ray, double& t, ShadeRec& sr) const;
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& t) const;
+
+		virtual bool
+		get_bounds(BBox& bounds) const;
+
+		virtual Vector3D						// by the inverse transformation, then into the object's own space
+		object_vector(const Vector3D& v, const double time) const;
+
+		void
+		set_identity(void);
+
+		void
+		translate(const Vector3D& trans);
+
+		void
+		translate(const double dx, const double dy, const double dz);
+
+		void
+		scale(const double a, const double b, const double c);
+
+		void									// theta in degrees
+		rotate_x(const double theta);
+
+		void
+		rotate_y(const double theta);
+
+		void
+		rotate_z(const double theta);
+
+	protected:
+
+		GeometricObject*	object_ptr;
+		Matrix				inv_matrix;			// the inverse of the transformation
+		Matrix				forward_matrix;		// the transformation
+};
+
+
+// ------------------------------------------------------------------------- get_object
+
+inline GeometricObject*
+Instance::get_object(void) const {
+	return (object_ptr);
+}
+
+
+// ------------------------------------------------------------------------- translate
+
+inline void
+Instance::translate(const Vector3D& trans) {
+	translate(trans.x, trans.y, trans.z);
+}
+
+#endif
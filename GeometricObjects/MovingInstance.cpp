@@ -0,0 +1,375 @@
+// This file contains the definition of the class MovingInstance
+
+#include <math.h>
+#include <algorithm>
+
+#include "MovingInstance.h"
+#include "../Utilities/Constants.h"
+
+static const int kMotionSamples = 16;		// per key interval, for the motion bounds
+
+// ---------------------------------------------------------------- scale_matrix
+
+static Matrix
+scale_matrix(const Vector3D& scale, const bool inverse) {
+	Matrix matrix;
+
+	matrix.m[0][0] = inverse ? 1.0 / scale.x : scale.x;
+	matrix.m[1][1] = inverse ? 1.0 / scale.y : scale.y;
+	matrix.m[2][2] = inverse ? 1.0 / scale.z : scale.z;
+
+	return (matrix);
+}
+
+
+// ---------------------------------------------------------------- rotation_matrix
+// about axis 0, 1 or 2 by theta degrees; the inverse is the rotation by -theta
+
+static Matrix
+rotation_matrix(const int axis, const double theta, const bool inverse) {
+	double 	sin_theta 	= sin((inverse ? -theta : theta) * PI_ON_180);
+	double 	cos_theta 	= cos(theta * PI_ON_180);
+	int 	a 			= (axis + 1) % 3;
+	int 	b 			= (axis + 2) % 3;
+	Matrix 	matrix;
+
+	matrix.m[a][a] = cos_theta;
+	matrix.m[a][b] = -sin_theta;
+	matrix.m[b][a] = sin_theta;
+	matrix.m[b][b] = cos_theta;
+
+	return (matrix);
+}
+
+
+// ---------------------------------------------------------------- linear_part
+// the scale and rotation, or their inverse
+
+static Matrix
+linear_part(const Vector3D& scale, const Vector3D& rotation, const bool inverse) {
+	if (inverse)
+		return (scale_matrix(scale, true) * rotation_matrix(0, rotation.x, true)
+				* rotation_matrix(1, rotation.y, true) * rotation_matrix(2, rotation.z, true));
+
+	return (rotation_matrix(2, rotation.z, false) * rotation_matrix(1, rotation.y, false)
+			* rotation_matrix(0, rotation.x, false) * scale_matrix(scale, false));
+}
+
+
+// ----------------------------------------------------------------  default constructor
+
+MovingInstance::MovingInstance(void)
+	: 	Instance(),
+		keys(),
+		linear(true),
+		linear_inverse()
+{}
+
+
+// ----------------------------------------------------------------  constructor
+
+MovingInstance::MovingInstance(GeometricObject* obj_ptr)
+	: 	Instance(obj_ptr),
+		keys(),
+		linear(true),
+		linear_inverse()
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+MovingInstance::MovingInstance(const MovingInstance& instance)
+	: 	Instance(instance),
+		keys(instance.keys),
+		linear(instance.linear),
+		linear_inverse(instance.linear_inverse)
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+MovingInstance*
+MovingInstance::clone(void) const {
+	return (new MovingInstance(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+MovingInstance&
+MovingInstance::operator= (const MovingInstance& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Instance::operator= (rhs);
+
+	keys 			= rhs.keys;
+	linear 			= rhs.linear;
+	linear_inverse 	= rhs.linear_inverse;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+MovingInstance::~MovingInstance(void) {}
+
+
+// ---------------------------------------------------------------- add_key
+
+void
+MovingInstance::add_key(const double time, const Vector3D& scale, const Vector3D& rotation,
+						const Vector3D& translation) {
+	insert_key(keys, TransformKey{time, scale, rotation, translation});
+
+	const TransformKey& first = keys[0];
+
+	linear = true;
+
+	for (const TransformKey& k : keys)
+		if (k.scale.x != first.scale.x || k.scale.y != first.scale.y || k.scale.z != first.scale.z
+			|| k.rotation.x != first.rotation.x || k.rotation.y != first.rotation.y || k.rotation.z != first.rotation.z)
+			linear = false;
+
+	if (linear)
+		linear_inverse = linear_part(first.scale, first.rotation, true);
+}
+
+
+// ---------------------------------------------------------------- set_linear_motion
+
+void
+MovingInstance::set_linear_motion(const Vector3D& start, const Vector3D& end) {
+	keys.clear();
+	add_key(0.0, Vector3D(1.0), Vector3D(0.0), start);
+	add_key(1.0, Vector3D(1.0), Vector3D(0.0), end);
+}
+
+
+// ---------------------------------------------------------------- hit
+// the ray is taken back through the motion at its time, and then through the instance's transformation;
+// the normal comes out through the transposes of the two inverses, in the other order
+
+bool
+MovingInstance::hit(const Ray& ray, double& t, ShadeRec& sr) const {
+	Matrix 	inverse;
+	Ray 	inv_ray;
+
+	motion_matrix(ray.time, true, inverse);
+
+	inv_ray.o 		= inv_matrix * (inverse * ray.o);
+	inv_ray.d 		= inv_matrix * (inverse * ray.d);
+	inv_ray.time 	= ray.time;
+
+	if (object_ptr->hit(inv_ray, t, sr)) {
+		sr.normal = inverse * (inv_matrix * sr.normal);
+		sr.normal.normalize();
+
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ---------------------------------------------------------------- object_vector
+
+Vector3D
+MovingInstance::object_vector(const Vector3D& v, const double time) const {
+	Matrix inverse;
+
+	motion_matrix(time, true, inverse);
+
+	return (object_ptr->object_vector(inv_matrix * (inverse * v), time));
+}
+
+
+// ---------------------------------------------------------------- shadow_hit
+
+bool
+MovingInstance::shadow_hit(const Ray& ray, double& t) const {
+	Matrix 	inverse;
+	Ray 	inv_ray;
+
+	motion_matrix(ray.time, true, inverse);
+
+	inv_ray.o 		= inv_matrix * (inverse * ray.o);
+	inv_ray.d 		= inv_matrix * (inverse * ray.d);
+	inv_ray.time 	= ray.time;
+
+	return (object_ptr->shadow_hit(inv_ray, t));
+}
+
+
+// ---------------------------------------------------------------- get_bounds
+
+bool
+MovingInstance::get_bounds(BBox& bounds) const {
+	BBox b0, b1;
+
+	if (!get_motion_bounds(0.0, 1.0, b0, b1))
+		return (false);
+
+	bounds = bbox_union(b0, b1);
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- get_motion_bounds
+// The boxes start as the bounds at t0 and t1, and are grown until their interpolation holds the
+// bounds at kMotionSamples times in each key interval. Between the samples, the scale and translation
+// move the box corners along straight lines, which the interpolation holds; a rotation moves them
+// along curves, which stray from the lines by at most h^2 / 8 times their acceleration, for samples
+// h apart, and the boxes are padded by that. A linear motion only moves the box, so it is only
+// sampled at the keys.
+
+bool
+MovingInstance::get_motion_bounds(const double t0, const double t1, BBox& b0, BBox& b1) const {
+	BBox object_bounds;
+
+	if (!object_ptr || !object_ptr->get_bounds(object_bounds))
+		return (false);
+
+	b0 = bounds_at(object_bounds, t0);
+	b1 = bounds_at(object_bounds, t1);
+
+	if (keys.size() < 2 || t1 <= t0)
+		return (true);
+
+	std::vector<double> times(1, t0);
+
+	for (const TransformKey& key : keys)
+		if (key.time > t0 && key.time < t1)
+			times.push_back(key.time);
+
+	times.push_back(t1);
+
+	double radius 		= 0.0;		// of the instance's box corners, about the origin the motion rotates about
+	double max_scale 	= 0.0;
+
+	if (!linear) {
+		for (int j = 0; j < 8; j++) {
+			Point3D corner(j & 1 ? object_bounds.p_max.x : object_bounds.p_min.x,
+						   j & 2 ? object_bounds.p_max.y : object_bounds.p_min.y,
+						   j & 4 ? object_bounds.p_max.z : object_bounds.p_min.z);
+
+			radius = std::max(radius, (forward_matrix * corner).distance(Point3D(0.0)));
+		}
+
+		for (const TransformKey& key : keys)
+			max_scale = std::max(max_scale, std::max(fabs(key.scale.x), std::max(fabs(key.scale.y), fabs(key.scale.z))));
+	}
+
+	int 	num_samples = linear ? 1 : kMotionSamples;
+	double 	pad 		= 0.0;
+
+	for (int span = 0; span + 1 < (int)times.size(); span++) {
+		double a = times[span];
+		double h = (times[span + 1] - a) / num_samples;
+
+		for (int s = 1; s <= num_samples; s++) {
+			double 	time 	= a + s * h;
+			BBox 	bounds 	= bounds_at(object_bounds, time);
+			BBox 	held 	= bbox_lerp(b0, b1, (time - t0) / (t1 - t0));
+
+			Vector3D low(std::max(0.0, held.p_min.x - bounds.p_min.x), std::max(0.0, held.p_min.y - bounds.p_min.y),
+						 std::max(0.0, held.p_min.z - bounds.p_min.z));
+			Vector3D high(std::max(0.0, bounds.p_max.x - held.p_max.x), std::max(0.0, bounds.p_max.y - held.p_max.y),
+						  std::max(0.0, bounds.p_max.z - held.p_max.z));
+
+			b0 = BBox(b0.p_min - low, b0.p_max + high);
+			b1 = BBox(b1.p_min - low, b1.p_max + high);
+		}
+
+		double middle = a + 0.5 * (times[span + 1] - a);
+
+		if (linear || middle <= keys.front().time || middle >= keys.back().time)
+			continue;
+
+		int 	j;
+		double 	f;
+
+		find_keys(keys, middle, j, f);
+
+		const TransformKey& k0 	= keys[j];
+		const TransformKey& k1 	= keys[j + 1];
+		double 	duration 		= k1.time - k0.time;
+		double 	angular_speed 	= (fabs(k1.rotation.x - k0.rotation.x) + fabs(k1.rotation.y - k0.rotation.y)
+								   + fabs(k1.rotation.z - k0.rotation.z)) * PI_ON_180 / duration;
+		double 	scale_speed 	= std::max(fabs(k1.scale.x - k0.scale.x),
+										   std::max(fabs(k1.scale.y - k0.scale.y), fabs(k1.scale.z - k0.scale.z))) / duration;
+		double 	acceleration 	= radius * angular_speed * (angular_speed * max_scale + 2.0 * scale_speed);
+
+		pad = std::max(pad, h * h / 8.0 * acceleration);
+	}
+
+	b0 = BBox(b0.p_min - Vector3D(pad), b0.p_max + Vector3D(pad));
+	b1 = BBox(b1.p_min - Vector3D(pad), b1.p_max + Vector3D(pad));
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- motion_matrix
+// the identity without keys; a linear motion's inverse only needs the translation column set
+
+void
+MovingInstance::motion_matrix(const double time, const bool inverse, Matrix& matrix) const {
+	matrix.set_identity();
+
+	if (keys.empty())
+		return;
+
+	TransformKey key = interpolate(keys, time);
+
+	if (linear && inverse) {
+		Vector3D offset = linear_inverse * key.translation;
+
+		matrix = linear_inverse;
+		matrix.m[0][3] = -offset.x;
+		matrix.m[1][3] = -offset.y;
+		matrix.m[2][3] = -offset.z;
+
+		return;
+	}
+
+	matrix = linear_part(key.scale, key.rotation, inverse);
+
+	if (inverse) {
+		Vector3D offset = matrix * key.translation;
+
+		matrix.m[0][3] = -offset.x;
+		matrix.m[1][3] = -offset.y;
+		matrix.m[2][3] = -offset.z;
+	}
+	else {
+		matrix.m[0][3] = key.translation.x;
+		matrix.m[1][3] = key.translation.y;
+		matrix.m[2][3] = key.translation.z;
+	}
+}
+
+
+// ---------------------------------------------------------------- bounds_at
+// the box of the object's box corners, placed by the instance's transformation and the motion at time
+
+BBox
+MovingInstance::bounds_at(const BBox& object_bounds, const double time) const {
+	Matrix 	motion;
+	BBox 	bounds;
+
+	motion_matrix(time, false, motion);
+	motion = motion * forward_matrix;
+
+	for (int j = 0; j < 8; j++) {
+		Point3D corner(j & 1 ? object_bounds.p_max.x : object_bounds.p_min.x,
+					   j & 2 ? object_bounds.p_max.y : object_bounds.p_min.y,
+					   j & 4 ? object_bounds.p_max.z : object_bounds.p_min.z);
+
+		bounds = bbox_union(bounds, motion * corner);
+	}
+
+	return (bounds);
+}
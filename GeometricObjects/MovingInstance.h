@@ -0,0 +1,75 @@
+#ifndef __MOVING_INSTANCE__
+#define __MOVING_INSTANCE__
+
+// This file contains the declaration of the class MovingInstance, an Instance that moves while the
+// shutter is open, for motion blur
+// The motion is given by transform keys (Utilities/Keyframes.h), as Animation's objects are, over the
+// ray times from 0, when the shutter opens, to 1, when it closes; it is interpolated linearly between
+// the keys and held outside them. It is applied after the instance's own transformation.
+// The hit functions build the inverse transformation at the ray's time. When every key has the same
+// scale and rotation, the motion is linear, and its inverse is a fixed matrix and a translation.
+// get_motion_bounds samples the motion; when the object rotates, the boxes are padded by a bound on
+// how far the object's box corners can stray from straight lines between the samples.
+
+#include <vector>
+
+#include "Instance.h"
+#include "../Utilities/Keyframes.h"
+#include "../Utilities/Vector3D.h"
+
+//-------------------------------------------------------------------------------- class MovingInstance
+
+class MovingInstance: public Instance {
+
+	public:
+
+		MovingInstance(void);
+
+		MovingInstance(GeometricObject* obj_ptr);
+
+		MovingInstance(const MovingInstance& instance);
+
+		virtual MovingInstance*
+		clone(void) const;
+
+		MovingInstance&
+		operator= (const MovingInstance& rhs);
+
+		virtual
+		~MovingInstance(void);
+
+		void									// rotation in degrees about x, then y, then z; the keys can be added in any order
+		add_key(const double time, const Vector3D& scale, const Vector3D& rotation, const Vector3D& translation);
+
+		void									// replaces the keys with a translation from start, at time 0, to end, at time 1
+		set_linear_motion(const Vector3D& start, const Vector3D& end);
+
+		virtual bool
+		hit(const Ray& ray, double& t, ShadeRec& sr) const;
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& t) const;
+
+		virtual bool							// over the whole shutter interval
+		get_bounds(BBox& bounds) const;
+
+		virtual bool
+		get_motion_bounds(const double t0, const double t1, BBox& b0, BBox& b1) const;
+
+		virtual Vector3D						// by the inverse of the motion at time, then as Instance
+		object_vector(const Vector3D& v, const double time) const;
+
+	private:
+
+		std::vector<TransformKey>	keys;
+		bool						linear;				// do all the keys have the same scale and rotation?
+		Matrix						linear_inverse;		// the inverse of their scale and rotation, if so
+
+		void									// the motion's transformation at time, or its inverse
+		motion_matrix(const double time, const bool inverse, Matrix& matrix) const;
+
+		BBox
+		bounds_at(const BBox& object_bounds, const double time) const;
+};
+
+#endif
@@ -1,6 +1,5 @@
 #include "Plane.h"
 
-const double Plane::kEpsilon = 0.001;
 
 // ----------------------------------------------------------------------  default constructor
 
@@ -60,22 +59,3 @@ Plane::operator= (const Plane& rhs)	{
 
 Plane::~Plane(void)				
 {}
-
-
-// ----------------------------------------------------------------- hit
-
-bool 															 
-Plane::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {	
-	float t = (a - ray.o) * n / (ray.d * n); 
-														
-	if (t > kEpsilon) {
-		tmin = t;
-		sr.normal = n;
-		sr.local_hit_point = ray.o + t * ray.d;
-		
-		return (true);	
-	}
-
-	return(false);
-}
-
@@ -1,7 +1,12 @@
 #ifndef __PLANE__
 #define __PLANE__
 
+#include <math.h>
+
 #include "GeometricObject.h"
+#include "../Utilities/Epsilon.h"
+
+// The point and normal are stored in float and the hit function works in float; see Utilities/Epsilon.h
 
 //-------------------------------------------------------------------- class Plane
 
@@ -26,13 +31,62 @@ class Plane: public GeometricObject {
 					
 		virtual bool 																								 
 		hit(const Ray& ray, double& tmin, ShadeRec& sr) const;
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& tmin) const;
 		
 	private:
 	
-		Point3D 	a;   				// point through which plane passes 
-		Normal 		n;					// normal to the plane
+		Point3F 	a;   				// point through which plane passes 
+		NormalF 	n;					// normal to the plane
 				
-		static const double kEpsilon;   // for shadows and secondary rays
+		static constexpr int kErrorTerms = 8;	// rounded operations in the computation of t, for the hit epsilon
 };
 
+
+// ----------------------------------------------------------------- hit
+// the vector from the ray origin to the plane's point is formed in double and rounded to float once
+// a hit is accepted if t is beyond the error bound of the division, which scales with the
+// magnitudes of the dot product's terms
+
+inline bool 															 
+Plane::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {	
+	Vector3F	oa(Point3D(a) - ray.o);
+	Vector3F	d(ray.d);
+	float		denom	= d * n;
+	float 		t 		= (oa * n) / denom;
+	float		t_eps	= error_gamma<float>(kErrorTerms)
+						  * (fabsf(oa.x * n.x) + fabsf(oa.y * n.y) + fabsf(oa.z * n.z)) / fabsf(denom);
+														
+	if (t > t_eps) {
+		tmin = t;
+		sr.normal = Normal(n);
+		sr.local_hit_point = ray.o + tmin * ray.d;
+		
+		return (true);	
+	}
+
+	return(false);
+}
+
+
+// ----------------------------------------------------------------- shadow_hit
+
+inline bool
+Plane::shadow_hit(const Ray& ray, double& tmin) const {
+	Vector3F	oa(Point3D(a) - ray.o);
+	Vector3F	d(ray.d);
+	float		denom	= d * n;
+	float 		t 		= (oa * n) / denom;
+	float		t_eps	= error_gamma<float>(kErrorTerms)
+						  * (fabsf(oa.x * n.x) + fabsf(oa.y * n.y) + fabsf(oa.z * n.z)) / fabsf(denom);
+
+	if (t > t_eps) {
+		tmin = t;
+		return (true);
+	}
+
+	return (false);
+}
+
 #endif
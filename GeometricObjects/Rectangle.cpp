@@ -0,0 +1,199 @@
+// This file contains the definition of the class Rectangle
+
+#include <math.h>
+
+#include "Rectangle.h"
+#include "../Utilities/Epsilon.h"
+
+
+// ----------------------------------------------------------------------  default constructor
+// a unit square in the zx plane, facing +y
+
+Rectangle::Rectangle(void)	
+	: 	GeometricObject(),
+		p0(-1, 0, -1),
+		a(0, 0, 2),
+		b(2, 0, 0),
+		normal(0, 1, 0)
+{
+	set_area();
+}
+
+
+// ----------------------------------------------------------------------  constructor
+
+Rectangle::Rectangle(const Point3D& _p0, const Vector3D& _a, const Vector3D& _b)
+	:	GeometricObject(),
+		p0(_p0),
+		a(_a),
+		b(_b),
+		normal(Normal(_a ^ _b))
+{
+	normal.normalize();
+	set_area();
+}
+
+
+// ----------------------------------------------------------------------  constructor
+
+Rectangle::Rectangle(const Point3D& _p0, const Vector3D& _a, const Vector3D& _b, const Normal& n)
+	:	GeometricObject(),
+		p0(_p0),
+		a(_a),
+		b(_b),
+		normal(n)
+{
+	normal.normalize();
+	set_area();
+}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Rectangle::Rectangle(const Rectangle& rectangle) 
+	:	GeometricObject(rectangle),
+		p0(rectangle.p0),
+		a(rectangle.a),
+		b(rectangle.b),
+		a_len_squared(rectangle.a_len_squared),
+		b_len_squared(rectangle.b_len_squared),
+		normal(rectangle.normal),
+		inv_area(rectangle.inv_area)
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+Rectangle* 
+Rectangle::clone(void) const {
+	return (new Rectangle(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Rectangle& 
+Rectangle::operator= (const Rectangle& rhs)	{
+	if (this == &rhs)
+		return (*this);
+
+	GeometricObject::operator= (rhs);
+
+	p0 				= rhs.p0;
+	a 				= rhs.a;
+	b 				= rhs.b;
+	a_len_squared 	= rhs.a_len_squared;
+	b_len_squared 	= rhs.b_len_squared;
+	normal 			= rhs.normal;
+	inv_area 		= rhs.inv_area;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Rectangle::~Rectangle(void) {}
+
+
+// ---------------------------------------------------------------- set_area
+
+void
+Rectangle::set_area(void) {
+	a_len_squared 	= a.len_squared();
+	b_len_squared 	= b.len_squared();
+	inv_area 		= 1.0f / (a ^ b).length();
+}
+
+
+// ----------------------------------------------------------------- intersect
+// t is found as for Plane::hit, then the hit point, relative to p0, is projected onto the sides
+
+bool
+Rectangle::intersect(const Ray& ray, float& t) const {
+	Vector3F	op(Point3D(p0) - ray.o);
+	Vector3F	d(ray.d);
+	float		denom	= d * normal;
+	float		t_eps	= error_gamma<float>(kErrorTerms)
+						  * (fabsf(op.x * normal.x) + fabsf(op.y * normal.y) + fabsf(op.z * normal.z)) / fabsf(denom);
+
+	t = (op * normal) / denom;
+
+	if (!(t > t_eps))
+		return (false);
+
+	Vector3F 	p 		= d * t - op;
+	float 		ddota 	= p * a;
+
+	if (ddota < 0.0f || ddota > a_len_squared)
+		return (false);
+
+	float ddotb = p * b;
+
+	return (ddotb >= 0.0f && ddotb <= b_len_squared);
+}
+
+
+// ----------------------------------------------------------------- hit
+
+bool 															 
+Rectangle::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {	
+	float t;
+
+	if (intersect(ray, t)) {
+		tmin = t;
+		sr.normal = Normal(normal);
+		sr.local_hit_point = ray.o + tmin * ray.d;
+
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ----------------------------------------------------------------- shadow_hit
+
+bool 															 
+Rectangle::shadow_hit(const Ray& ray, double& tmin) const {	
+	float t;
+
+	if (intersect(ray, t)) {
+		tmin = t;
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ----------------------------------------------------------------- get_bounds
+
+bool
+Rectangle::get_bounds(BBox& bounds) const {
+	Point3D 	p(p0.x, p0.y, p0.z);
+	Vector3D 	side_a(a.x, a.y, a.z);
+	Vector3D 	side_b(b.x, b.y, b.z);
+
+	bounds = bbox_union(bbox_union(BBox(p, p), p + side_a), p + side_b);
+	bounds = bbox_union(bounds, p + side_a + side_b);
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------- sample
+
+Point3D
+Rectangle::sample(const Point2D& u, Normal& n) const {
+	n = Normal(normal);
+	return (Point3D(p0) + u.x * Vector3D(a) + u.y * Vector3D(b));
+}
+
+
+// ----------------------------------------------------------------- pdf
+
+float
+Rectangle::pdf(const ShadeRec& sr) const {
+	return (inv_area);
+}
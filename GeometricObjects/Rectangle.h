@@ -0,0 +1,67 @@
+#ifndef __RECTANGLE__
+#define __RECTANGLE__
+
+// This file contains the declaration of the class Rectangle, a parallelogram p0 + s a + t b with
+// s and t in [0, 1], which can be used as an area light
+// The corner and edges are stored in float and the hit function works in float; see Utilities/Epsilon.h
+
+#include "GeometricObject.h"
+
+//-------------------------------------------------------------------- class Rectangle
+
+class Rectangle: public GeometricObject {
+	
+	public:
+	
+		Rectangle(void);   									
+		
+		Rectangle(const Point3D& p0, const Vector3D& a, const Vector3D& b);		// the normal is a ^ b
+	
+		Rectangle(const Point3D& p0, const Vector3D& a, const Vector3D& b, const Normal& n);
+
+		Rectangle(const Rectangle& rectangle); 
+		
+		virtual Rectangle* 									
+		clone(void) const;
+
+		Rectangle& 											
+		operator= (const Rectangle& rhs);	
+		
+		virtual												
+		~Rectangle(void);   											
+					
+		virtual bool 																								 
+		hit(const Ray& ray, double& tmin, ShadeRec& sr) const;
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& tmin) const;
+
+		virtual bool
+		get_bounds(BBox& bounds) const;
+
+		virtual Point3D										// uniform over the area
+		sample(const Point2D& u, Normal& normal) const;
+
+		virtual float
+		pdf(const ShadeRec& sr) const;
+		
+	private:
+	
+		Point3F 	p0;   				// corner vertex 
+		Vector3F	a;					// side
+		Vector3F	b;					// side
+		float		a_len_squared;		// square of the length of side a
+		float		b_len_squared;		// square of the length of side b
+		NormalF 	normal;
+		float		inv_area;			// for the pdf
+				
+		static constexpr int kErrorTerms = 8;	// rounded operations in the computation of t, for the hit epsilon
+
+		bool
+		intersect(const Ray& ray, float& t) const;
+
+		void
+		set_area(void);
+};
+
+#endif
@@ -1,9 +1,10 @@
 // This file contains the definition of the class sphere
 
+#include <algorithm>
+
 #include "Sphere.h"
-#include "math.h"
+#include "../Utilities/Constants.h"
 
-const double Sphere::kEpsilon = 0.001;
 					
 // ---------------------------------------------------------------- default constructor
 
@@ -63,47 +64,34 @@ Sphere::operator= (const Sphere& rhs)
 Sphere::~Sphere(void) {}
 
 
-//---------------------------------------------------------------- hit
+// ---------------------------------------------------------------- get_bounds
 
 bool
-Sphere::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {
-	double 		t;
-	Vector3D	temp 	= ray.o - center;
-	double 		a 		= ray.d * ray.d;
-	double 		b 		= 2.0 * temp * ray.d;
-	double 		c 		= temp * temp - radius * radius;
-	double 		disc	= b * b - 4.0 * a * c;
-	
-	if (disc < 0.0)
-		return(false);
-	else {	
-		double e = sqrt(disc);
-		double denom = 2.0 * a;
-		t = (-b - e) / denom;    // smaller root
-	
-		if (t > kEpsilon) {
-			tmin = t;
-			sr.normal 	 = (temp + t * ray.d) / radius;
-			sr.local_hit_point = ray.o + t * ray.d;
-			return (true);
-		} 
-	
-		t = (-b + e) / denom;    // larger root
-	
-		if (t > kEpsilon) {
-			tmin = t;
-			sr.normal   = (temp + t * ray.d) / radius;
-			sr.local_hit_point = ray.o + t * ray.d;
-			return (true);
-		} 
-	}
-	
-	return (false);
+Sphere::get_bounds(BBox& bounds) const {
+	bounds = BBox(Point3D(center.x - radius, center.y - radius, center.z - radius),
+				  Point3D(center.x + radius, center.y + radius, center.z + radius));
+	return (true);
 }
 
 
+//---------------------------------------------------------------- sample
+// z is uniform in [-1, 1], which makes the area uniform (Archimedes' hat-box theorem)
+
+Point3D
+Sphere::sample(const Point2D& u, Normal& normal) const {
+	double z 	= 1.0 - 2.0 * u.x;
+	double r 	= sqrt(std::max(0.0, 1.0 - z * z));
+	double phi 	= TWO_PI * u.y;
 
+	normal = Normal(r * cos(phi), r * sin(phi), z);
 
+	return (Point3D(center) + (double)radius * Vector3D(normal));
+}
 
 
+//---------------------------------------------------------------- pdf
 
+float
+Sphere::pdf(const ShadeRec& sr) const {
+	return (1.0 / (4.0 * PI * radius * radius));
+}
@@ -2,8 +2,12 @@
 #define __SPHERE__
 
 // This file contains the declaration of the class Sphere
+// The center and radius are stored in float and the hit function works in float; see Utilities/Epsilon.h
+
+#include <math.h>
 
 #include "GeometricObject.h"
+#include "../Utilities/Epsilon.h"
 
 //-------------------------------------------------------------------------------- class Sphere
 
@@ -37,20 +41,35 @@ class Sphere: public GeometricObject {
 						
 		virtual bool 												 
 		hit(const Ray& ray, double& t, ShadeRec& s) const;	
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& t) const;
+
+		virtual bool
+		get_bounds(BBox& bounds) const;
+
+		virtual Point3D										// uniform over the whole surface
+		sample(const Point2D& u, Normal& normal) const;
+
+		virtual float
+		pdf(const ShadeRec& sr) const;
 		
 	private:
 	
-		Point3D 	center;   			// center coordinates as a point  
-		double 		radius;				// the radius 
+		Point3F 	center;   			// center coordinates as a point  
+		float 		radius;				// the radius 
 		
-		static const double kEpsilon;   // for shadows and secondary rays
+		static constexpr int kErrorTerms = 16;	// rounded operations in the computation of t, for the hit epsilon
+
+		bool												// the nearest root beyond the hit epsilon, temp is ray.o - center
+		nearest_root(const Ray& ray, const Vector3D& temp, float& t) const;
 };
 
 
 
 inline void
 Sphere::set_center(const Point3D& c) {
-	center = c;
+	center = Point3F(c);
 }
 		
 inline void
@@ -65,4 +84,80 @@ Sphere::set_radius(const double r) {
 	radius = r;
 }
 
+
+//---------------------------------------------------------------- nearest_root
+// The ray origin is moved into the sphere's frame in double, so that only the difference is rounded
+// to float, and the roots use the form of the quadratic formula that doesn't cancel -b against the
+// square root. A root is accepted if it is beyond the error bound of t, which scales with the
+// distance to the center and the radius.
+
+inline bool
+Sphere::nearest_root(const Ray& ray, const Vector3D& temp_d, float& t) const {
+	Vector3F	temp(temp_d);
+	Vector3F	d(ray.d);
+	float 		a 		= d * d;
+	float 		b 		= 2.0f * (temp * d);
+	float 		c 		= temp * temp - radius * radius;
+	float 		disc	= b * b - 4.0f * a * c;
+	
+	if (disc < 0.0f)
+		return(false);
+
+	float e = sqrtf(disc);
+	float q = (b < 0.0f) ? -0.5f * (b - e) : -0.5f * (b + e);
+
+	if (q == 0.0f)
+		return (false);
+
+	float t0 = q / a;
+	float t1 = c / q;
+
+	if (t0 > t1) {				// t0 is the smaller root
+		float swap = t0;
+		t0 = t1;
+		t1 = swap;
+	}
+
+	float d_max = fmaxf(fabsf(d.x), fmaxf(fabsf(d.y), fabsf(d.z)));
+	float t_eps = error_gamma<float>(kErrorTerms) * (fabsf(temp.x) + fabsf(temp.y) + fabsf(temp.z) + radius) / d_max;
+
+	t = (t0 > t_eps) ? t0 : t1;
+
+	return (t > t_eps);
+}
+
+
+//---------------------------------------------------------------- hit
+
+inline bool
+Sphere::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {
+	Vector3D	temp_d	= ray.o - Point3D(center);
+	float		t;
+
+	if (nearest_root(ray, temp_d, t)) {
+		tmin = t;
+		sr.normal 	 = (temp_d + tmin * ray.d) / (double)radius;
+		sr.local_hit_point = ray.o + tmin * ray.d;
+
+		return (true);
+	}
+	
+	return (false);
+}
+
+
+//---------------------------------------------------------------- shadow_hit
+
+inline bool
+Sphere::shadow_hit(const Ray& ray, double& tmin) const {
+	float t;
+
+	if (nearest_root(ray, ray.o - Point3D(center), t)) {
+		tmin = t;
+		return (true);
+	}
+
+	return (false);
+}
+
 #endif
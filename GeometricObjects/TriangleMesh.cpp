@@ -0,0 +1,217 @@
+// This file contains the definition of the class TriangleMesh
+
+#include <algorithm>
+#include <math.h>
+
+#include "TriangleMesh.h"
+#include "../Utilities/Constants.h"
+#include "../Utilities/Epsilon.h"
+
+
+// ----------------------------------------------------------------------  default constructor
+
+TriangleMesh::TriangleMesh(void)	
+	: 	GeometricObject()
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+TriangleMesh::TriangleMesh(const TriangleMesh& mesh) 
+	:	GeometricObject(mesh),
+		vertices(mesh.vertices),
+		triangles(mesh.triangles),
+		cdf(mesh.cdf)
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+TriangleMesh* 
+TriangleMesh::clone(void) const {
+	return (new TriangleMesh(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+TriangleMesh& 
+TriangleMesh::operator= (const TriangleMesh& rhs)	{
+	if (this == &rhs)
+		return (*this);
+
+	GeometricObject::operator= (rhs);
+
+	vertices 	= rhs.vertices;
+	triangles 	= rhs.triangles;
+	cdf 		= rhs.cdf;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+TriangleMesh::~TriangleMesh(void) {}
+
+
+// ---------------------------------------------------------------- add_vertex
+
+int
+TriangleMesh::add_vertex(const Point3D& p) {
+	vertices.push_back(Point3F(p));
+	return ((int)vertices.size() - 1);
+}
+
+
+// ---------------------------------------------------------------- add_triangle
+
+void
+TriangleMesh::add_triangle(const int i0, const int i1, const int i2) {
+	Vector3D 	n 		= (Point3D(vertices[i1]) - Point3D(vertices[i0])) ^ (Point3D(vertices[i2]) - Point3D(vertices[i0]));
+	float 		area 	= 0.5 * n.length();
+	Triangle 	triangle;
+
+	triangle.v0 	= i0;
+	triangle.v1 	= i1;
+	triangle.v2 	= i2;
+	triangle.normal = NormalF(Normal(n.hat()));
+
+	triangles.push_back(triangle);
+	cdf.push_back(cdf.empty() ? area : cdf.back() + area);
+}
+
+
+// ----------------------------------------------------------------- nearest_triangle
+// Moller and Trumbore's test, with the ray origin moved to each triangle's first vertex in double so
+// that only the difference is rounded to float
+// As for Sphere::hit, a hit is accepted if it is beyond an error bound on t that scales with the
+// distance to the vertex
+
+int
+TriangleMesh::nearest_triangle(const Ray& ray, float& tmin) const {
+	Vector3F	d(ray.d);
+	float		d_max 		= fmaxf(fabsf(d.x), fmaxf(fabsf(d.y), fabsf(d.z)));
+	int			nearest 	= -1;
+	int			num_triangles = triangles.size();
+
+	tmin = kHugeValue;
+
+	for (int j = 0; j < num_triangles; j++) {
+		const Triangle& triangle = triangles[j];
+		const Point3F&	v0 		 = vertices[triangle.v0];
+		Vector3F 		e1 		 = vertices[triangle.v1] - v0;
+		Vector3F 		e2 		 = vertices[triangle.v2] - v0;
+		Vector3F 		pvec 	 = d ^ e2;
+		float 			det 	 = e1 * pvec;
+
+		if (det == 0.0f)
+			continue;
+
+		float 		inv_det = 1.0f / det;
+		Vector3F 	tvec(ray.o - Point3D(v0));
+		float 		u 		= (tvec * pvec) * inv_det;
+
+		if (u < 0.0f || u > 1.0f)
+			continue;
+
+		Vector3F 	qvec 	= tvec ^ e1;
+		float 		v 		= (d * qvec) * inv_det;
+
+		if (v < 0.0f || u + v > 1.0f)
+			continue;
+
+		float t 	= (e2 * qvec) * inv_det;
+		float t_eps = error_gamma<float>(kErrorTerms) * (fabsf(tvec.x) + fabsf(tvec.y) + fabsf(tvec.z)) / d_max;
+
+		if (t > t_eps && t < tmin) {
+			tmin 	= t;
+			nearest = j;
+		}
+	}
+
+	return (nearest);
+}
+
+
+// ----------------------------------------------------------------- hit
+
+bool 															 
+TriangleMesh::hit(const Ray& ray, double& tmin, ShadeRec& sr) const {	
+	float 	t;
+	int 	nearest = nearest_triangle(ray, t);
+
+	if (nearest >= 0) {
+		tmin = t;
+		sr.normal = Normal(triangles[nearest].normal);
+		sr.local_hit_point = ray.o + tmin * ray.d;
+
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ----------------------------------------------------------------- shadow_hit
+
+bool 															 
+TriangleMesh::shadow_hit(const Ray& ray, double& tmin) const {	
+	float t;
+
+	if (nearest_triangle(ray, t) >= 0) {
+		tmin = t;
+		return (true);
+	}
+
+	return (false);
+}
+
+
+// ----------------------------------------------------------------- get_bounds
+// the box of all the vertices, whether or not triangles use them
+
+bool
+TriangleMesh::get_bounds(BBox& bounds) const {
+	bounds = BBox();
+
+	for (const Point3F& v : vertices)
+		bounds = bbox_union(bounds, Point3D(v.x, v.y, v.z));
+
+	return (!vertices.empty());
+}
+
+
+// ----------------------------------------------------------------- sample
+// u.x picks a triangle in proportion to its area and is then rescaled to [0, 1) within it; the
+// square root mapping makes the point uniform over the triangle
+
+Point3D
+TriangleMesh::sample(const Point2D& u, Normal& normal) const {
+	float 	total 	= cdf.back();
+	float	x 		= u.x * total;
+	int 	j 		= std::min((int)(std::upper_bound(cdf.begin(), cdf.end(), x) - cdf.begin()), (int)cdf.size() - 1);
+	float 	lower 	= j > 0 ? cdf[j - 1] : 0.0f;
+	float 	s 		= std::min((x - lower) / (cdf[j] - lower), 0.99999994f);
+	float 	su 		= sqrtf(s);
+	double	b0 		= 1.0 - su;
+	double	b1 		= u.y * su;
+
+	const Triangle& triangle = triangles[j];
+
+	normal = Normal(triangle.normal);
+
+	Point3D v0(vertices[triangle.v0]);
+	Point3D v1(vertices[triangle.v1]);
+	Point3D v2(vertices[triangle.v2]);
+
+	return (v2 + b0 * (v0 - v2) + b1 * (v1 - v2));
+}
+
+
+// ----------------------------------------------------------------- pdf
+
+float
+TriangleMesh::pdf(const ShadeRec& sr) const {
+	return (1.0f / cdf.back());
+}
@@ -0,0 +1,83 @@
+#ifndef __TRIANGLE_MESH__
+#define __TRIANGLE_MESH__
+
+// This file contains the declaration of the class TriangleMesh, a list of flat-shaded triangles that
+// share a vertex list, which can be used as an area light
+// hit tests every triangle, so a mesh should be small; larger meshes need an acceleration structure.
+// A triangle's normal is (v1 - v0) ^ (v2 - v0), so it faces the side from which v0, v1, v2 run
+// counterclockwise.
+// The vertices are stored in float and the hit function works in float; see Utilities/Epsilon.h
+
+#include <vector>
+
+#include "GeometricObject.h"
+
+//-------------------------------------------------------------------- class TriangleMesh
+
+class TriangleMesh: public GeometricObject {
+	
+	public:
+	
+		TriangleMesh(void);   									
+
+		TriangleMesh(const TriangleMesh& mesh); 
+		
+		virtual TriangleMesh* 									
+		clone(void) const;
+
+		TriangleMesh& 											
+		operator= (const TriangleMesh& rhs);	
+		
+		virtual												
+		~TriangleMesh(void);   											
+
+		int													// returns the vertex's index
+		add_vertex(const Point3D& p);
+
+		void												// the vertices must have been added
+		add_triangle(const int i0, const int i1, const int i2);
+
+		int
+		get_num_triangles(void) const;
+					
+		virtual bool 																								 
+		hit(const Ray& ray, double& tmin, ShadeRec& sr) const;
+
+		virtual bool
+		shadow_hit(const Ray& ray, double& tmin) const;
+
+		virtual bool
+		get_bounds(BBox& bounds) const;
+
+		virtual Point3D										// uniform over the total area
+		sample(const Point2D& u, Normal& normal) const;
+
+		virtual float
+		pdf(const ShadeRec& sr) const;
+		
+	private:
+
+		struct Triangle {
+			int			v0, v1, v2;		// indices into vertices
+			NormalF		normal;
+		};
+	
+		std::vector<Point3F>	vertices;
+		std::vector<Triangle>	triangles;
+		std::vector<float>		cdf;				// cdf[j] is the area of triangles 0 to j
+				
+		static constexpr int kErrorTerms = 16;	// rounded operations in the computation of t, for the hit epsilon
+
+		int													// the nearest triangle hit beyond the hit epsilon, or -1
+		nearest_triangle(const Ray& ray, float& t) const;
+};
+
+
+// ---------------------------------------------------------------- get_num_triangles
+
+inline int
+TriangleMesh::get_num_triangles(void) const {
+	return ((int)triangles.size());
+}
+
+#endif
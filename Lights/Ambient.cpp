@@ -46,23 +46,3 @@ Ambient::operator= (const Ambient& rhs) {
 // ---------------------------------------------------------------------- destructor																			
 
 Ambient::~Ambient (void) {}
-
-
-// ---------------------------------------------------------------------- get_direction	
-
-Vector3D								
-Ambient::get_direction(ShadeRec& s) {
-	return (Vector3D(0.0));
-}
-
-
-// ---------------------------------------------------------------------- L
-
-RGBColor
-Ambient::L(ShadeRec& sr) {	
-	return (ls * color);
-}
-
-
-
-
@@ -77,4 +77,20 @@ Ambient::set_color(const float r, const float g, const float b) {
 }
 
 
+// ---------------------------------------------------------------------- get_direction
+// get_direction and L are inlined so that the static dispatch path can call them directly
+
+inline Vector3D
+Ambient::get_direction(ShadeRec& s) {
+	return (Vector3D(0.0));
+}
+
+
+// ---------------------------------------------------------------------- L
+
+inline RGBColor
+Ambient::L(ShadeRec& sr) {	
+	return (ls * color);
+}
+
 #endif
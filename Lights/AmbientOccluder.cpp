@@ -0,0 +1,121 @@
+// This file contains the definition of the class AmbientOccluder
+
+#include "AmbientOccluder.h"
+#include "../Samplers/Jittered.h"
+#include "../Utilities/Constants.h"
+#include "../World/World.h"
+
+// ---------------------------------------------------------------------- default constructor
+
+AmbientOccluder::AmbientOccluder (void)
+	: 	Light(),
+		ls(1.0),
+		color(1.0),
+		min_amount(0.0),
+		max_distance(kHugeValue)
+{
+	set_num_samples(16);
+}
+
+
+// ---------------------------------------------------------------------- copy constructor
+
+AmbientOccluder::AmbientOccluder (const AmbientOccluder& ao)
+	: 	Light(ao),
+		ls(ao.ls),
+		color(ao.color),
+		min_amount(ao.min_amount),
+		max_distance(ao.max_distance),
+		sampler(ao.sampler)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+Light* 
+AmbientOccluder::clone(void) const {
+	return (new AmbientOccluder(*this));
+}	
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+AmbientOccluder& 
+AmbientOccluder::operator= (const AmbientOccluder& rhs) {
+	if (this == &rhs)
+		return (*this);
+			
+	Light::operator= (rhs);
+	
+	ls 				= rhs.ls;
+	color 			= rhs.color;
+	min_amount 		= rhs.min_amount;
+	max_distance 	= rhs.max_distance;
+	sampler 		= rhs.sampler;
+	
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------------- destructor																			
+
+AmbientOccluder::~AmbientOccluder (void) {}
+
+
+// ---------------------------------------------------------------------- set_sampler
+
+void
+AmbientOccluder::set_sampler(Sampler* sampler_ptr) {
+	sampler_ptr->map_samples_to_hemisphere(1);
+	sampler.set_sampler(sampler_ptr);
+}
+
+
+// ---------------------------------------------------------------------- set_num_samples
+
+void
+AmbientOccluder::set_num_samples(const int n) {
+	set_sampler(new Jittered(n));
+}
+
+
+// ---------------------------------------------------------------------- get_direction
+// the hemisphere sample is moved into an orthonormal frame (u, v, w) with w along the normal; the
+// jitter in the up vector avoids a degenerate frame for normals along y
+
+Vector3D								
+AmbientOccluder::get_direction(ShadeRec& sr) {
+	Vector3D w(sr.normal);
+	Vector3D v = w ^ Vector3D(0.0072, 1.0, 0.0034);
+	v.normalize();
+	Vector3D u = v ^ w;
+
+	Point3D sp = sampler.get().sample_hemisphere();
+
+	return (sp.x * u + sp.y * v + sp.z * w);
+}
+
+
+// ---------------------------------------------------------------------- L
+
+RGBColor
+AmbientOccluder::L(ShadeRec& sr) {	
+	int num_samples = sampler.get_num_samples();
+	int num_visible = 0;
+
+	for (int j = 0; j < num_samples; j++)
+		if (!sr.w.any_hit(sr.spawn_ray(get_direction(sr)), max_distance))
+			num_visible++;
+
+	float visibility = (float)num_visible / num_samples;
+
+	return ((min_amount + (1.0f - min_amount) * visibility) * ls * color);
+}
+
+
+// ---------------------------------------------------------------------- get_num_samples
+
+int
+AmbientOccluder::get_num_samples(void) const {
+	return (sampler.get_num_samples());
+}
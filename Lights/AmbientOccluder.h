@@ -0,0 +1,121 @@
+#ifndef __AMBIENT_OCCLUDER__
+#define __AMBIENT_OCCLUDER__
+
+// This file contains the declaration of the class AmbientOccluder, an ambient light that is dimmed
+// where nearby objects block the sky
+// L casts get_num_samples() rays from the hit point in cosine-weighted directions about the normal,
+// and scales the ambient radiance by the fraction of them that reach max_distance unblocked, down to
+// min_amount where all are blocked. The rays use World::any_hit, which stops at the first blocker.
+// The stratified sample sets are mapped onto the hemisphere once and cloned per render thread; see
+// Samplers/PerThreadSampler.h
+
+#include "Light.h"
+#include "../Samplers/PerThreadSampler.h"
+#include "../Utilities/ShadeRec.h"
+
+class AmbientOccluder: public Light {
+	public:
+	
+		AmbientOccluder(void);   							
+
+		AmbientOccluder(const AmbientOccluder& ao); 					 
+	
+		virtual Light* 									
+		clone(void) const;	
+		
+		AmbientOccluder& 									
+		operator= (const AmbientOccluder& rhs);									
+		
+		virtual 									
+		~AmbientOccluder(void);
+				
+		void
+		scale_radiance(const float b);
+		
+		void
+		set_color(const float c);
+		
+		void
+		set_color(const RGBColor& c);
+		
+		void
+		set_color(const float r, const float g, const float b); 
+
+		void											// the fraction of the radiance that fully occluded points get
+		set_min_amount(const float m);
+
+		void											// objects further away than this don't occlude
+		set_max_distance(const double d);
+
+		void											// takes ownership; the samples are mapped onto the hemisphere
+		set_sampler(Sampler* sampler_ptr);
+
+		void											// jittered; n is the rays per hit
+		set_num_samples(const int n);
+		
+		virtual Vector3D								// a new cosine-weighted direction about the normal
+		get_direction(ShadeRec& sr); 
+		
+		virtual RGBColor
+		L(ShadeRec& sr);
+
+		virtual int
+		get_num_samples(void) const;
+	
+	private:
+	
+		float				ls;
+		RGBColor			color;
+		float				min_amount;
+		double				max_distance;
+		PerThreadSampler	sampler;
+};
+
+
+// ------------------------------------------------------------------------------- scale_radiance
+
+inline void
+AmbientOccluder::scale_radiance(const float b) { 
+	ls = b;
+}
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+AmbientOccluder::set_color(const float c) {
+	color.r = c; color.g = c; color.b = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+AmbientOccluder::set_color(const RGBColor& c) {
+	color = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+AmbientOccluder::set_color(const float r, const float g, const float b) {
+	color.r = r; color.g = g; color.b = b;
+}
+
+
+// ------------------------------------------------------------------------------- set_min_amount
+
+inline void
+AmbientOccluder::set_min_amount(const float m) {
+	min_amount = m;
+}
+
+
+// ------------------------------------------------------------------------------- set_max_distance
+
+inline void
+AmbientOccluder::set_max_distance(const double d) {
+	max_distance = d;
+}
+
+#endif
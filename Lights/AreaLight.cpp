@@ -0,0 +1,188 @@
+// This file contains the definition of the class AreaLight
+
+#include <algorithm>
+
+#include "AreaLight.h"
+#include "../GeometricObjects/GeometricObject.h"
+#include "../Materials/Material.h"
+#include "../Samplers/Jittered.h"
+#include "../World/World.h"
+
+thread_local AreaLight::Sample AreaLight::sample;
+
+
+// ---------------------------------------------------------------------- default constructor
+
+AreaLight::AreaLight(void)
+	: 	Light(),
+		object_ptr(nullptr),
+		material_ptr(nullptr),
+		sampler(new Jittered(1))
+{}
+
+
+// ---------------------------------------------------------------------- copy constructor
+
+AreaLight::AreaLight(const AreaLight& al)
+	: 	Light(al),
+		object_ptr(al.object_ptr),
+		material_ptr(al.material_ptr),
+		sampler(al.sampler)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+Light* 
+AreaLight::clone(void) const {
+	return (new AreaLight(*this));
+}
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+AreaLight& 
+AreaLight::operator= (const AreaLight& rhs) {
+	if (this == &rhs)
+		return (*this);
+			
+	Light::operator= (rhs);
+	
+	object_ptr 		= rhs.object_ptr;
+	material_ptr 	= rhs.material_ptr;
+	sampler 		= rhs.sampler;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------------- destructor
+
+AreaLight::~AreaLight(void) {}
+
+
+// ---------------------------------------------------------------------- set_object
+
+void
+AreaLight::set_object(GeometricObject* obj_ptr) {
+	object_ptr 		= obj_ptr;
+	material_ptr 	= obj_ptr->get_material();
+	object_ptr->set_shadows(false);
+}
+
+
+// ---------------------------------------------------------------------- set_sampler
+
+void
+AreaLight::set_sampler(Sampler* sampler_ptr) {
+	sampler.set_sampler(sampler_ptr);
+}
+
+
+// ---------------------------------------------------------------------- set_num_samples
+
+void
+AreaLight::set_num_samples(const int n) {
+	sampler.set_sampler(new Jittered(std::max(1, n)));
+}
+
+
+// ---------------------------------------------------------------------- get_direction
+
+Vector3D								
+AreaLight::get_direction(ShadeRec& sr) {
+	sample.point 	= object_ptr->sample(sampler.get().sample_unit_square(), sample.normal);
+	sample.wi 		= sample.point - sr.hit_point;
+	sample.wi.normalize();
+
+	return (sample.wi);
+}	
+
+
+// ---------------------------------------------------------------------- L
+// only the front of the surface emits
+
+RGBColor
+AreaLight::L(ShadeRec& sr) {	
+	float ndotd = -sample.normal * sample.wi;
+
+	if (ndotd > 0.0 && material_ptr)
+		return (material_ptr->get_Le(sr));
+	else
+		return (black);
+}
+
+
+// ---------------------------------------------------------------------- in_shadow
+// only the objects in front of the sample point can block it
+
+bool
+AreaLight::in_shadow(const Ray& ray, const ShadeRec& sr) const {
+	double d = (sample.point - ray.o) * ray.d;
+
+	return (sr.w.any_hit(ray, d));
+}
+
+
+// ---------------------------------------------------------------------- G
+// converts the pdf, which is over area, to solid angle at the hit point
+
+float
+AreaLight::G(const ShadeRec& sr) const {
+	float ndotd = -sample.normal * sample.wi;
+	float d2 	= sample.point.d_squared(sr.hit_point);
+
+	return (ndotd / d2);
+}
+
+
+// ---------------------------------------------------------------------- pdf
+
+float
+AreaLight::pdf(const ShadeRec& sr) const {
+	return (object_ptr->pdf(sr));
+}
+
+
+// ---------------------------------------------------------------------- get_num_samples
+
+int
+AreaLight::get_num_samples(void) const {
+	return (sampler.get_num_samples());
+}
+
+
+// ---------------------------------------------------------------------- is_delta
+
+bool
+AreaLight::is_delta(void) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------------- L_along
+// the ray must hit the front of the light's surface, with nothing in front of it if the light casts
+// shadows, as for in_shadow; the pdf over area
+// is converted to solid angle by the inverse of G
+
+RGBColor
+AreaLight::L_along(const Ray& ray, const ShadeRec& sr, float& pdf) const {
+	double 		t;
+	ShadeRec 	light_sr(sr.w);
+
+	pdf = 0.0;
+
+	if (!material_ptr || !object_ptr->hit(ray, t, light_sr))
+		return (black);
+
+	float ndotd = -light_sr.normal * ray.d;
+
+	if (ndotd <= 0.0 || (shadows && sr.w.any_hit(ray, t)))
+		return (black);
+
+	light_sr.hit_point 	= ray.o + t * ray.d;
+	light_sr.ray 		= ray;
+	pdf 				= object_ptr->pdf(light_sr) * t * t / ndotd;
+
+	return (material_ptr->get_Le(light_sr));
+}
@@ -0,0 +1,87 @@
+#ifndef __AREA_LIGHT__
+#define __AREA_LIGHT__
+
+// This file contains the declaration of the class AreaLight, which lights the scene from the surface
+// of a GeometricObject with an Emissive material: a Rectangle, a Sphere or a TriangleMesh
+// Every call to get_direction picks a new point on the surface with the light's sampler, and the
+// following calls to in_shadow, L, G and pdf on the same thread refer to that point. Shading takes
+// get_num_samples() such points per hit and weights each by G / pdf, which gives soft shadows.
+// The sample sets are cloned per render thread; see Samplers/PerThreadSampler.h
+
+#include "Light.h"
+#include "../Samplers/PerThreadSampler.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Normal.h"
+#include "../Utilities/Vector3D.h"
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/ShadeRec.h"
+
+class GeometricObject;
+class Material;
+
+
+class AreaLight: public Light {
+	public:
+	
+		AreaLight(void);   							
+
+		AreaLight(const AreaLight& al); 
+		
+		virtual Light* 									
+		clone(void) const;			
+
+		AreaLight& 									
+		operator= (const AreaLight& rhs); 
+			
+		virtual											
+		~AreaLight(void); 
+
+		void											// the world owns the object; it stops casting shadows, so that it doesn't shadow itself
+		set_object(GeometricObject* obj_ptr);
+
+		void											// takes ownership
+		set_sampler(Sampler* sampler_ptr);
+
+		void											// jittered samples; n below one is taken as one
+		set_num_samples(const int n);
+		
+		virtual Vector3D								
+		get_direction(ShadeRec& sr);
+				
+		virtual RGBColor		
+		L(ShadeRec& sr);
+
+		virtual bool
+		in_shadow(const Ray& ray, const ShadeRec& sr) const;
+
+		virtual float
+		G(const ShadeRec& sr) const;
+
+		virtual float
+		pdf(const ShadeRec& sr) const;
+
+		virtual int
+		get_num_samples(void) const;
+
+		virtual bool
+		is_delta(void) const;
+
+		virtual RGBColor
+		L_along(const Ray& ray, const ShadeRec& sr, float& pdf) const;
+		
+	private:
+
+		struct Sample {
+			Point3D		point;			// on the light's surface
+			Normal		normal;			// the surface normal there
+			Vector3D	wi;				// the unit direction from the hit point to the sample
+		};
+
+		GeometricObject*	object_ptr;
+		Material*			material_ptr;	// the object's material, which must be emissive
+		PerThreadSampler	sampler;
+
+		static thread_local Sample	sample;		// set by get_direction
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "Directional.h"
+#include "../Utilities/Constants.h"
 
 // ---------------------------------------------------------------------- default constructor
 
@@ -51,19 +52,10 @@ Directional::operator= (const Directional& rhs)
 Directional::~Directional(void) {}
 
 
-// ---------------------------------------------------------------------- get_direction
-// as this function is virtual, it shouldn't be inlined 
+// ---------------------------------------------------------------------- in_shadow
+// the light is at infinity, so any object along the ray blocks it
 
-Vector3D								
-Directional::get_direction(ShadeRec& sr) {
-	return (dir);
-}	
-
-// ------------------------------------------------------------------------------  L
-
-RGBColor
-Directional::L(ShadeRec& s) {	
-	return (ls * color);
+bool
+Directional::in_shadow(const Ray& ray, const ShadeRec& sr) const {
+	return (sr.w.any_hit(ray, kHugeValue));
 }
-
-
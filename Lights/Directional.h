@@ -48,6 +48,9 @@ class Directional: public Light {
 				
 		virtual RGBColor		
 		L(ShadeRec& sr);	
+
+		virtual bool
+		in_shadow(const Ray& ray, const ShadeRec& sr) const;
 		
 	private:
 
@@ -109,4 +112,21 @@ Directional::set_direction(float dx, float dy, float dz) {
 }
 
 
+// ---------------------------------------------------------------------- get_direction
+// get_direction and L are virtual, but are inlined so that the static dispatch path can call
+// them directly; see World/StaticScene.h
+
+inline Vector3D
+Directional::get_direction(ShadeRec& sr) {
+	return (dir);
+}	
+
+
+// ------------------------------------------------------------------------------  L
+
+inline RGBColor
+Directional::L(ShadeRec& s) {	
+	return (ls * color);
+}
+
 #endif
@@ -4,11 +4,15 @@
 
 // ---------------------------------------------------------------------- default constructor
 
-Light::Light(void) {}
+Light::Light(void)
+	: 	shadows(false)
+{}
 
 // ---------------------------------------------------------------------- dopy constructor
 
-Light::Light(const Light& ls) {}
+Light::Light(const Light& ls)
+	: 	shadows(ls.shadows)
+{}
 
 
 // ---------------------------------------------------------------------- assignment operator
@@ -18,6 +22,8 @@ Light::operator= (const Light& rhs) {
 	if (this == &rhs)
 		return (*this);
 
+	shadows = rhs.shadows;
+
 	return (*this);
 }
 
@@ -37,3 +43,61 @@ Light::L(ShadeRec& s) {
 }
 
 
+// ---------------------------------------------------------------------- get_bounds
+// lights at infinity, such as Ambient and Directional, have no bounds and are never put in the
+// light BVH
+
+bool
+Light::get_bounds(LightBounds& bounds) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------------- in_shadow
+
+bool
+Light::in_shadow(const Ray& ray, const ShadeRec& sr) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------------- G
+// 1 for the lights that aren't sampled, so that shading can weight every light by G / pdf
+
+float
+Light::G(const ShadeRec& sr) const {
+	return (1.0);
+}
+
+
+// ---------------------------------------------------------------------- pdf
+
+float
+Light::pdf(const ShadeRec& sr) const {
+	return (1.0);
+}
+
+
+// ---------------------------------------------------------------------- get_num_samples
+
+int
+Light::get_num_samples(void) const {
+	return (1);
+}
+
+
+// ---------------------------------------------------------------------- is_delta
+
+bool
+Light::is_delta(void) const {
+	return (true);
+}
+
+
+// ---------------------------------------------------------------------- L_along
+
+RGBColor
+Light::L_along(const Ray& ray, const ShadeRec& sr, float& pdf) const {
+	pdf = 0.0;
+	return (black);
+}
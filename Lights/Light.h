@@ -4,6 +4,7 @@
 #include "../Utilities/Vector3D.h"
 #include "../Utilities/RGBColor.h"
 #include "../Utilities/Ray.h"
+#include "LightBounds.h"
 
 class ShadeRec;
 
@@ -31,6 +32,53 @@ class Light {
 																
 		virtual RGBColor														
 		L(ShadeRec& sr);								
+
+		virtual bool									// false for lights that can't go in the light BVH
+		get_bounds(LightBounds& bounds) const;
+
+		void
+		set_shadows(const bool s);
+
+		bool
+		casts_shadows(void) const;
+
+		virtual bool									// is the light blocked along the ray from sr.hit_point?
+		in_shadow(const Ray& ray, const ShadeRec& sr) const;
+
+		virtual float									// the geometric factor of an area light's sample
+		G(const ShadeRec& sr) const;
+
+		virtual float									// the probability density of an area light's sample
+		pdf(const ShadeRec& sr) const;
+
+		virtual int										// samples per shading point; get_direction picks a new one each call
+		get_num_samples(void) const;
+
+		virtual bool									// lights from a point or a direction, which no ray can hit
+		is_delta(void) const;
+
+		virtual RGBColor								// the unblocked radiance reaching sr.hit_point along ray from the
+		L_along(const Ray& ray, const ShadeRec& sr, float& pdf) const;	// light, and get_direction's pdf of ray.d over solid angle
+
+	protected:
+
+		bool	shadows;								// false by default, so that existing scenes render as before
 };
 
+
+// ---------------------------------------------------------------------- set_shadows
+
+inline void
+Light::set_shadows(const bool s) {
+	shadows = s;
+}
+
+
+// ---------------------------------------------------------------------- casts_shadows
+
+inline bool
+Light::casts_shadows(void) const {
+	return (shadows);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+// This file contains the definition of the class LightBVH
+
+#include <algorithm>
+
+#include "LightBVH.h"
+#include "../Utilities/Constants.h"
+#include "../Utilities/Stats.h"
+
+// ---------------------------------------------------------------- constructor
+// lights with zero power are left out: they can't contribute
+
+LightBVH::LightBVH(const std::vector<Light*>& lights, const int _num_samples)
+	: 	num_samples(std::max(1, _num_samples))
+{
+	std::vector<std::pair<int, LightBounds> > entries;
+
+	for (Light* light_ptr : lights) {
+		LightBounds bounds;
+
+		if (!light_ptr->get_bounds(bounds))
+			infinite.push_back(light_ptr);
+		else if (bounds.phi > 0.0f) {
+			entries.push_back(std::make_pair((int)bounded.size(), bounds));
+			bounded.push_back(light_ptr);
+		}
+	}
+
+	if (!entries.empty()) {
+		nodes.reserve(2 * entries.size() - 1);
+		build(entries, 0, (int)entries.size());
+	}
+}
+
+
+// ---------------------------------------------------------------- build
+// splits at the median centroid along the axis where the centroids spread most, which keeps the
+// tree balanced, so that every light is reached in about log2(n) steps
+
+int
+LightBVH::build(std::vector<std::pair<int, LightBounds> >& entries, const int begin, const int end) {
+	int index = (int)nodes.size();
+
+	nodes.push_back(Node());
+
+	if (end - begin == 1) {
+		nodes[index].bounds 		= entries[begin].second;
+		nodes[index].child_or_light = entries[begin].first;
+		nodes[index].is_leaf 		= true;
+		return (index);
+	}
+
+	Point3D c_min(kHugeValue), c_max(-kHugeValue);
+
+	for (int j = begin; j < end; j++) {
+		Point3D c = entries[j].second.centroid();
+		c_min = Point3D(std::min(c_min.x, c.x), std::min(c_min.y, c.y), std::min(c_min.z, c.z));
+		c_max = Point3D(std::max(c_max.x, c.x), std::max(c_max.y, c.y), std::max(c_max.z, c.z));
+	}
+
+	Vector3D 	extent 	= c_max - c_min;
+	int 		axis 	= (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+	int 		mid 	= (begin + end) / 2;
+
+	std::nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end,
+		[axis](const std::pair<int, LightBounds>& a, const std::pair<int, LightBounds>& b) {
+			Point3D ca = a.second.centroid();
+			Point3D cb = b.second.centroid();
+			return (axis == 0 ? ca.x < cb.x : (axis == 1 ? ca.y < cb.y : ca.z < cb.z));
+		});
+
+	build(entries, begin, mid);
+	int second = build(entries, mid, end);
+
+	nodes[index].bounds 		= light_bounds_union(nodes[index + 1].bounds, nodes[second].bounds);
+	nodes[index].child_or_light = second;
+	nodes[index].is_leaf 		= false;
+
+	return (index);
+}
+
+
+// ---------------------------------------------------------------- sample
+// u is reused at each level, rescaled to [0, 1) within the chosen child's share
+
+Light*
+LightBVH::sample(const Point3D& p, const Normal& n, float u, float& pmf) const {
+	pmf = 1.0f;
+
+	if (nodes.empty())
+		return (nullptr);
+
+	int index = 0;
+
+	if (nodes[0].bounds.importance(p, n) == 0.0f)
+		return (nullptr);
+
+	while (!nodes[index].is_leaf) {
+		STATS_INC(STAT_LIGHT_BVH_STEPS);
+
+		int 	first 			= index + 1;
+		int 	second 			= nodes[index].child_or_light;
+		float 	ci_first 		= nodes[first].bounds.importance(p, n);
+		float 	ci_second 		= nodes[second].bounds.importance(p, n);
+
+		if (ci_first == 0.0f && ci_second == 0.0f)
+			return (nullptr);
+
+		float p_first = ci_first / (ci_first + ci_second);
+
+		if (u < p_first) {
+			index 	= first;
+			pmf 	*= p_first;
+			u 		= std::min(u / p_first, 0.99999994f);
+		}
+		else {
+			index 	= second;
+			pmf 	*= 1.0f - p_first;
+			u 		= std::min((u - p_first) / (1.0f - p_first), 0.99999994f);
+		}
+	}
+
+	return (bounded[nodes[index].child_or_light]);
+}
@@ -0,0 +1,80 @@
+#ifndef __LIGHT_BVH__
+#define __LIGHT_BVH__
+
+// This file contains the declaration of the class LightBVH, which picks lights to sample at a shading
+// point when there are too many to loop over
+// The lights with bounds (Light::get_bounds) go in a binary tree whose nodes carry the union of their
+// lights' LightBounds. sample walks from the root to one light, at each node choosing a child with
+// probability proportional to its importance at the shading point, and returns the product of those
+// probabilities as the pmf, so that the cost of choosing a light is logarithmic in the number of
+// lights. Lights without bounds are returned by infinite_lights, to be sampled every time.
+// The tree does not own the lights; the World does.
+
+#include <vector>
+
+#include "Light.h"
+#include "LightBounds.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Normal.h"
+
+//----------------------------------------------------------------------------- class LightBVH
+
+class LightBVH {
+	public:
+
+		LightBVH(const std::vector<Light*>& lights, const int num_samples = 1);
+
+		Light*									// NULL if no light can reach p; u is uniform in [0, 1)
+		sample(const Point3D& p, const Normal& n, float u, float& pmf) const;
+
+		const std::vector<Light*>&
+		infinite_lights(void) const;
+
+		int										// lights sampled per shading point
+		get_num_samples(void) const;
+
+		int
+		num_bounded_lights(void) const;
+
+	private:
+
+		struct Node {
+			LightBounds		bounds;
+			int				child_or_light;		// the second child of an interior node, or a leaf's light
+			bool			is_leaf;			// the first child of an interior node is the next node
+		};
+
+		std::vector<Node>		nodes;
+		std::vector<Light*>		bounded;
+		std::vector<Light*>		infinite;
+		int						num_samples;
+
+		int										// builds the subtree over entries [begin, end), returns its root
+		build(std::vector<std::pair<int, LightBounds> >& entries, const int begin, const int end);
+};
+
+
+// ---------------------------------------------------------------- infinite_lights
+
+inline const std::vector<Light*>&
+LightBVH::infinite_lights(void) const {
+	return (infinite);
+}
+
+
+// ---------------------------------------------------------------- get_num_samples
+
+inline int
+LightBVH::get_num_samples(void) const {
+	return (num_samples);
+}
+
+
+// ---------------------------------------------------------------- num_bounded_lights
+
+inline int
+LightBVH::num_bounded_lights(void) const {
+	return ((int)bounded.size());
+}
+
+#endif
@@ -0,0 +1,202 @@
+// This file contains the definition of the struct LightBounds
+// The cone arithmetic follows the light BVH of Conty Estevez and Kulla, "Importance Sampling of Many
+// Lights with Adaptive Tree Splitting" (2018), in the form given in pbrt-v4.
+
+#include <algorithm>
+#include <cmath>
+
+#include "LightBounds.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------------- safe_sqrt
+
+static inline float
+safe_sqrt(const float x) {
+	return (std::sqrt(std::max(0.0f, x)));
+}
+
+
+// ---------------------------------------------------------------- cos_sub_clamped
+// cos(max(0, theta_a - theta_b)), from the sines and cosines of the angles
+
+static inline float
+cos_sub_clamped(const float sin_a, const float cos_a, const float sin_b, const float cos_b) {
+	if (cos_a > cos_b)
+		return (1.0f);
+
+	return (cos_a * cos_b + sin_a * sin_b);
+}
+
+
+// ---------------------------------------------------------------- sin_sub_clamped
+// sin(max(0, theta_a - theta_b))
+
+static inline float
+sin_sub_clamped(const float sin_a, const float cos_a, const float sin_b, const float cos_b) {
+	if (cos_a > cos_b)
+		return (0.0f);
+
+	return (sin_a * cos_b - cos_a * sin_b);
+}
+
+
+// ---------------------------------------------------------------- default constructor
+// empty bounds, with no power
+
+LightBounds::LightBounds(void)
+	: 	p_min(kHugeValue),
+		p_max(-kHugeValue),
+		w(0, 0, 1),
+		phi(0.0f),
+		cos_theta_o(1.0f),
+		cos_theta_e(1.0f),
+		two_sided(false)
+{}
+
+
+// ---------------------------------------------------------------- constructor
+
+LightBounds::LightBounds(const Point3D& _p_min, const Point3D& _p_max, const Vector3D& _w, const float _phi,
+						 const float _cos_theta_o, const float _cos_theta_e, const bool _two_sided)
+	: 	p_min(_p_min),
+		p_max(_p_max),
+		w(_w),
+		phi(_phi),
+		cos_theta_o(_cos_theta_o),
+		cos_theta_e(_cos_theta_e),
+		two_sided(_two_sided)
+{}
+
+
+// ---------------------------------------------------------------- importance
+// an upper bound on the power arriving at p: phi over the squared distance, times the cosine of the
+// smallest angle that any emitter in the box can make with its cone, and with n if n isn't zero
+
+float
+LightBounds::importance(const Point3D& p, const Normal& n) const {
+	Point3D		pc 			= centroid();
+	Vector3D	diagonal 	= p_max - p_min;
+	float		d2 			= std::max(p.d_squared(pc), 0.5 * diagonal.length());
+
+	d2 = std::max(d2, 1.0e-6f);
+
+	// the cosine of the angle between the cone axis and the direction from the box to p
+
+	Vector3D 	wi 			= p - pc;
+	double		wi_length	= wi.length();
+
+	if (wi_length > 0.0)
+		wi = wi / wi_length;
+
+	float cos_theta_w = w * wi;
+
+	if (two_sided)
+		cos_theta_w = std::fabs(cos_theta_w);
+
+	float sin_theta_w = safe_sqrt(1.0f - cos_theta_w * cos_theta_w);
+
+	// the cosine of the half angle that the box subtends from p, through its bounding sphere
+
+	float cos_theta_b 	= -1.0f;
+	bool  inside 		= p.x >= p_min.x && p.y >= p_min.y && p.z >= p_min.z
+						  && p.x <= p_max.x && p.y <= p_max.y && p.z <= p_max.z;
+
+	if (!inside) {
+		float r2 		= pc.d_squared(p_max);
+		float sin2_b 	= r2 / p.d_squared(pc);
+
+		if (sin2_b < 1.0f)
+			cos_theta_b = safe_sqrt(1.0f - sin2_b);
+	}
+
+	float sin_theta_b = safe_sqrt(1.0f - cos_theta_b * cos_theta_b);
+
+	// theta' = max(0, theta_w - theta_o - theta_b), the smallest angle to the cone from p
+
+	float sin_theta_o = safe_sqrt(1.0f - cos_theta_o * cos_theta_o);
+	float cos_theta_x = cos_sub_clamped(sin_theta_w, cos_theta_w, sin_theta_o, cos_theta_o);
+	float sin_theta_x = sin_sub_clamped(sin_theta_w, cos_theta_w, sin_theta_o, cos_theta_o);
+	float cos_theta_p = cos_sub_clamped(sin_theta_x, cos_theta_x, sin_theta_b, cos_theta_b);
+
+	if (cos_theta_p <= cos_theta_e)
+		return (0.0f);
+
+	float importance = phi * cos_theta_p / d2;
+
+	// the smallest angle between n and the directions to the box
+
+	if (n.x != 0.0 || n.y != 0.0 || n.z != 0.0) {
+		float cos_theta_i 	= std::fabs(n * wi);
+		float sin_theta_i 	= safe_sqrt(1.0f - cos_theta_i * cos_theta_i);
+
+		importance *= cos_sub_clamped(sin_theta_i, cos_theta_i, sin_theta_b, cos_theta_b);
+	}
+
+	return (std::max(importance, 0.0f));
+}
+
+
+// ---------------------------------------------------------------- cone_union
+// the smallest cone (w, cos_theta) that contains the cones a and b
+
+static void
+cone_union(const Vector3D& w_a, const float cos_a, const Vector3D& w_b, const float cos_b,
+		   Vector3D& w, float& cos_theta) {
+	float theta_a = std::acos(std::max(-1.0f, std::min(1.0f, cos_a)));
+	float theta_b = std::acos(std::max(-1.0f, std::min(1.0f, cos_b)));
+	float theta_d = std::acos(std::max(-1.0, std::min(1.0, w_a * w_b)));
+
+	if (std::min(theta_d + theta_b, (float)PI) <= theta_a) {		// a contains b
+		w 			= w_a;
+		cos_theta 	= cos_a;
+		return;
+	}
+
+	if (std::min(theta_d + theta_a, (float)PI) <= theta_b) {		// b contains a
+		w 			= w_b;
+		cos_theta 	= cos_b;
+		return;
+	}
+
+	float 		theta_o = 0.5f * (theta_a + theta_d + theta_b);
+	Vector3D	axis 	= w_a ^ w_b;
+
+	if (theta_o >= PI || axis.len_squared() == 0.0) {				// all directions
+		w 			= w_a;
+		cos_theta 	= -1.0f;
+		return;
+	}
+
+	// rotate w_a towards w_b by theta_r, about their common normal (Rodrigues' formula)
+
+	float theta_r = theta_o - theta_a;
+
+	axis.normalize();
+	w = w_a * std::cos(theta_r) + (axis ^ w_a) * std::sin(theta_r) + axis * ((axis * w_a) * (1.0 - std::cos(theta_r)));
+	w.normalize();
+	cos_theta = std::cos(theta_o);
+}
+
+
+// ---------------------------------------------------------------- light_bounds_union
+
+LightBounds
+light_bounds_union(const LightBounds& a, const LightBounds& b) {
+	if (a.phi == 0.0f)
+		return (b);
+
+	if (b.phi == 0.0f)
+		return (a);
+
+	LightBounds u;
+
+	u.p_min 		= Point3D(std::min(a.p_min.x, b.p_min.x), std::min(a.p_min.y, b.p_min.y), std::min(a.p_min.z, b.p_min.z));
+	u.p_max 		= Point3D(std::max(a.p_max.x, b.p_max.x), std::max(a.p_max.y, b.p_max.y), std::max(a.p_max.z, b.p_max.z));
+	u.phi 			= a.phi + b.phi;
+	u.cos_theta_e 	= std::min(a.cos_theta_e, b.cos_theta_e);
+	u.two_sided 	= a.two_sided || b.two_sided;
+
+	cone_union(a.w, a.cos_theta_o, b.w, b.cos_theta_o, u.w, u.cos_theta_o);
+
+	return (u);
+}
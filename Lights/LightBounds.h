@@ -0,0 +1,49 @@
+#ifndef __LIGHT_BOUNDS__
+#define __LIGHT_BOUNDS__
+
+// This file contains the declaration of the struct LightBounds, the bounds of one light or of a node of
+// the light BVH (LightBVH.h)
+// A LightBounds bounds where light is emitted (a box), in which directions (a cone of half angle
+// theta_o around w, plus a falloff of theta_e beyond that) and how much (the total power phi).
+// importance estimates how much the bounded lights contribute at a shading point; it is conservative,
+// so a LightBounds with zero importance at a point cannot light it.
+
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Vector3D.h"
+#include "../Utilities/Normal.h"
+
+//----------------------------------------------------------------------------- struct LightBounds
+
+struct LightBounds {
+	Point3D		p_min, p_max;			// the box the lights are in
+	Vector3D	w;						// the axis of the emission cone
+	float		phi;					// the total emitted power
+	float		cos_theta_o;			// the cosine of the cone's half angle, -1 for all directions
+	float		cos_theta_e;			// the cosine of the falloff angle beyond theta_o
+	bool		two_sided;				// emits along -w as well as w
+
+	LightBounds(void);
+
+	LightBounds(const Point3D& p_min, const Point3D& p_max, const Vector3D& w, const float phi,
+				const float cos_theta_o, const float cos_theta_e, const bool two_sided);
+
+	Point3D
+	centroid(void) const;
+
+	float								// at p, on a surface with normal n
+	importance(const Point3D& p, const Normal& n) const;
+};
+
+
+// ---------------------------------------------------------------- centroid
+
+inline Point3D
+LightBounds::centroid(void) const {
+	return (Point3D(0.5 * (p_min.x + p_max.x), 0.5 * (p_min.y + p_max.y), 0.5 * (p_min.z + p_max.z)));
+}
+
+
+LightBounds								// bounds both a and b
+light_bounds_union(const LightBounds& a, const LightBounds& b);
+
+#endif
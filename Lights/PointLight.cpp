@@ -0,0 +1,94 @@
+// This file contains the definition of the class PointLight
+
+#include <algorithm>
+
+#include "PointLight.h"
+#include "../World/World.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------------------- default constructor
+
+PointLight::PointLight(void)
+	: 	Light(),
+		ls(1.0),
+		color(1.0),
+		location(0.0)
+{}
+
+
+// ---------------------------------------------------------------------- copy constructor
+
+PointLight::PointLight(const PointLight& pl)
+	: 	Light(pl),
+		ls(pl.ls),
+		color(pl.color),
+		location(pl.location)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+Light* 
+PointLight::clone(void) const {
+	return (new PointLight(*this));
+}
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+PointLight& 
+PointLight::operator= (const PointLight& rhs) {
+	if (this == &rhs)
+		return (*this);
+			
+	Light::operator= (rhs);
+	
+	ls			= rhs.ls;
+	color 		= rhs.color;
+	location 	= rhs.location;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------------- destructor
+
+PointLight::~PointLight(void) {}
+
+
+// ---------------------------------------------------------------------- get_direction
+
+Vector3D								
+PointLight::get_direction(ShadeRec& sr) {
+	return ((location - sr.hit_point).hat());
+}	
+
+
+// ---------------------------------------------------------------------- L
+
+RGBColor
+PointLight::L(ShadeRec& sr) {	
+	return (ls * color / (float)location.d_squared(sr.hit_point));
+}
+
+
+// ---------------------------------------------------------------------- get_bounds
+// a point that emits in all directions, with power 4 pi ls times the brightest component
+
+bool
+PointLight::get_bounds(LightBounds& bounds) const {
+	float phi = 4.0 * PI * ls * std::max(color.r, std::max(color.g, color.b));
+
+	bounds = LightBounds(location, location, Vector3D(0, 0, 1), phi, -1.0f, 0.0f, false);
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------------- in_shadow
+// only the objects between the hit point and the light can block it
+
+bool
+PointLight::in_shadow(const Ray& ray, const ShadeRec& sr) const {
+	return (sr.w.any_hit(ray, location.distance(ray.o)));
+}
@@ -0,0 +1,118 @@
+#ifndef __POINT_LIGHT__
+#define __POINT_LIGHT__
+
+// This file contains the declaration of the class PointLight
+// The radiance falls off with the inverse square of the distance, so that scenes with many small
+// lights stay bounded and the light BVH's importance estimates hold.
+
+#include "Light.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Vector3D.h"
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/ShadeRec.h"
+
+
+class PointLight: public Light {
+	public:
+	
+		PointLight(void);   							
+
+		PointLight(const PointLight& pl); 
+		
+		virtual Light* 									
+		clone(void) const;			
+
+		PointLight& 									
+		operator= (const PointLight& rhs); 
+			
+		virtual											
+		~PointLight(void); 
+				
+		void
+		scale_radiance(const float b);
+		
+		void
+		set_color(const float c);
+		
+		void
+		set_color(const RGBColor& c);
+		
+		void
+		set_color(const float r, const float g, const float b); 		
+			
+		void
+		set_location(const Point3D& p);
+		
+		void
+		set_location(const double x, const double y, const double z);
+		
+		virtual Vector3D								
+		get_direction(ShadeRec& sr);
+				
+		virtual RGBColor		
+		L(ShadeRec& sr);	
+
+		virtual bool
+		get_bounds(LightBounds& bounds) const;
+
+		virtual bool
+		in_shadow(const Ray& ray, const ShadeRec& sr) const;
+		
+	private:
+
+		float		ls;			
+		RGBColor	color;
+		Point3D		location;
+};
+
+
+// inlined access functions
+
+// ------------------------------------------------------------------------------- scale_radiance
+
+inline void
+PointLight::scale_radiance(const float b) { 
+	ls = b;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+PointLight::set_color(const float c) {
+	color.r = c; color.g = c; color.b = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+PointLight::set_color(const RGBColor& c) {
+	color = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+PointLight::set_color(const float r, const float g, const float b) {
+	color.r = r; color.g = g; color.b = b;
+}
+
+
+// ---------------------------------------------------------------------- set_location
+
+inline void
+PointLight::set_location(const Point3D& p) {
+	location = p;
+}
+
+
+// ---------------------------------------------------------------------- set_location
+
+inline void
+PointLight::set_location(const double x, const double y, const double z) {
+	location.x = x; location.y = y; location.z = z;
+}
+
+#endif
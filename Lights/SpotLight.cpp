@@ -0,0 +1,137 @@
+// This file contains the definition of the class SpotLight
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpotLight.h"
+#include "../Utilities/Constants.h"
+#include "../World/World.h"
+
+// ---------------------------------------------------------------------- default constructor
+// a 30 degree cone pointing down, with a 5 degree falloff
+
+SpotLight::SpotLight(void)
+	: 	Light(),
+		ls(1.0),
+		color(1.0),
+		location(0.0),
+		dir(0, -1, 0),
+		cos_total_width(cos(30.0 * PI_ON_180)),
+		cos_falloff_start(cos(25.0 * PI_ON_180))
+{}
+
+
+// ---------------------------------------------------------------------- copy constructor
+
+SpotLight::SpotLight(const SpotLight& sl)
+	: 	Light(sl),
+		ls(sl.ls),
+		color(sl.color),
+		location(sl.location),
+		dir(sl.dir),
+		cos_total_width(sl.cos_total_width),
+		cos_falloff_start(sl.cos_falloff_start)
+{}
+
+
+// ---------------------------------------------------------------------- clone
+
+Light* 
+SpotLight::clone(void) const {
+	return (new SpotLight(*this));
+}
+
+
+// ---------------------------------------------------------------------- assignment operator
+
+SpotLight& 
+SpotLight::operator= (const SpotLight& rhs) {
+	if (this == &rhs)
+		return (*this);
+			
+	Light::operator= (rhs);
+	
+	ls					= rhs.ls;
+	color 				= rhs.color;
+	location 			= rhs.location;
+	dir 				= rhs.dir;
+	cos_total_width 	= rhs.cos_total_width;
+	cos_falloff_start 	= rhs.cos_falloff_start;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------------- destructor
+
+SpotLight::~SpotLight(void) {}
+
+
+// ---------------------------------------------------------------------- set_cone
+
+void
+SpotLight::set_cone(const float total_width, const float falloff_start) {
+	cos_total_width 	= cos(total_width * PI_ON_180);
+	cos_falloff_start 	= cos(std::min(falloff_start, total_width) * PI_ON_180);
+}
+
+
+// ---------------------------------------------------------------------- falloff
+// w is the unit direction from the light; smoothstep on the cosine between the two angles
+
+float
+SpotLight::falloff(const Vector3D& w) const {
+	float cos_theta = w * dir;
+
+	if (cos_theta >= cos_falloff_start)
+		return (1.0);
+
+	if (cos_theta <= cos_total_width)
+		return (0.0);
+
+	float s = (cos_theta - cos_total_width) / (cos_falloff_start - cos_total_width);
+
+	return (s * s * (3.0f - 2.0f * s));
+}
+
+
+// ---------------------------------------------------------------------- get_direction
+
+Vector3D								
+SpotLight::get_direction(ShadeRec& sr) {
+	return ((location - sr.hit_point).hat());
+}	
+
+
+// ---------------------------------------------------------------------- L
+
+RGBColor
+SpotLight::L(ShadeRec& sr) {	
+	Vector3D w = (sr.hit_point - location).hat();
+
+	return (ls * falloff(w) * color / (float)location.d_squared(sr.hit_point));
+}
+
+
+// ---------------------------------------------------------------------- get_bounds
+// the power is ls times the brightest component, integrated over the falloff:
+// 2 pi ((1 - cos falloff_start) + (cos falloff_start - cos total_width) / 2)
+
+bool
+SpotLight::get_bounds(LightBounds& bounds) const {
+	float scale 		= ls * std::max(color.r, std::max(color.g, color.b));
+	float phi 			= scale * TWO_PI * ((1.0f - cos_falloff_start) + (cos_falloff_start - cos_total_width) / 2.0f);
+	float cos_theta_e 	= cos(acos(cos_total_width) - acos(cos_falloff_start));
+
+	bounds = LightBounds(location, location, dir, phi, cos_falloff_start, cos_theta_e, false);
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------------- in_shadow
+
+bool
+SpotLight::in_shadow(const Ray& ray, const ShadeRec& sr) const {
+	return (sr.w.any_hit(ray, location.distance(ray.o)));
+}
@@ -0,0 +1,152 @@
+#ifndef __SPOT_LIGHT__
+#define __SPOT_LIGHT__
+
+// This file contains the declaration of the class SpotLight, a PointLight that only lights a cone
+// around its direction
+// The radiance is full within falloff_start degrees of the direction and falls smoothly to zero at
+// total_width degrees, and, as for a PointLight, with the inverse square of the distance.
+
+#include "Light.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Vector3D.h"
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/ShadeRec.h"
+
+
+class SpotLight: public Light {
+	public:
+	
+		SpotLight(void);   							
+
+		SpotLight(const SpotLight& sl); 
+		
+		virtual Light* 									
+		clone(void) const;			
+
+		SpotLight& 									
+		operator= (const SpotLight& rhs); 
+			
+		virtual											
+		~SpotLight(void); 
+				
+		void
+		scale_radiance(const float b);
+		
+		void
+		set_color(const float c);
+		
+		void
+		set_color(const RGBColor& c);
+		
+		void
+		set_color(const float r, const float g, const float b); 		
+			
+		void
+		set_location(const Point3D& p);
+		
+		void
+		set_location(const double x, const double y, const double z);
+
+		void											// the direction the light points in
+		set_direction(const Vector3D& d);
+
+		void
+		set_direction(const double dx, const double dy, const double dz);
+
+		void											// half angles, in degrees
+		set_cone(const float total_width, const float falloff_start);
+		
+		virtual Vector3D								
+		get_direction(ShadeRec& sr);
+				
+		virtual RGBColor		
+		L(ShadeRec& sr);	
+
+		virtual bool
+		get_bounds(LightBounds& bounds) const;
+
+		virtual bool
+		in_shadow(const Ray& ray, const ShadeRec& sr) const;
+		
+	private:
+
+		float		ls;			
+		RGBColor	color;
+		Point3D		location;
+		Vector3D	dir;
+		float		cos_total_width;
+		float		cos_falloff_start;
+
+		float											// 1 inside the falloff start, 0 outside the total width
+		falloff(const Vector3D& w) const;
+};
+
+
+// inlined access functions
+
+// ------------------------------------------------------------------------------- scale_radiance
+
+inline void
+SpotLight::scale_radiance(const float b) { 
+	ls = b;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+SpotLight::set_color(const float c) {
+	color.r = c; color.g = c; color.b = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+SpotLight::set_color(const RGBColor& c) {
+	color = c;
+}
+
+
+// ------------------------------------------------------------------------------- set_color
+
+inline void
+SpotLight::set_color(const float r, const float g, const float b) {
+	color.r = r; color.g = g; color.b = b;
+}
+
+
+// ---------------------------------------------------------------------- set_location
+
+inline void
+SpotLight::set_location(const Point3D& p) {
+	location = p;
+}
+
+
+// ---------------------------------------------------------------------- set_location
+
+inline void
+SpotLight::set_location(const double x, const double y, const double z) {
+	location.x = x; location.y = y; location.z = z;
+}
+
+
+// ---------------------------------------------------------------------- set_direction
+
+inline void
+SpotLight::set_direction(const Vector3D& d) {
+	dir = d;
+	dir.normalize();
+}
+
+
+// ---------------------------------------------------------------------- set_direction
+
+inline void
+SpotLight::set_direction(const double dx, const double dy, const double dz) {
+	dir.x = dx; dir.y = dy; dir.z = dz;
+	dir.normalize();
+}
+
+#endif
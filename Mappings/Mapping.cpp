@@ -0,0 +1,28 @@
+// This file contains the definition of the class Mapping
+
+#include "Mapping.h"
+
+// ---------------------------------------------------------------- default constructor
+
+Mapping::Mapping(void) {}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Mapping::Mapping(const Mapping& mapping) {}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Mapping&
+Mapping::operator= (const Mapping& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Mapping::~Mapping(void) {}
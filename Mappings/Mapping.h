@@ -0,0 +1,35 @@
+#ifndef __MAPPING__
+#define __MAPPING__
+
+// This file contains the declaration of the base class Mapping, which maps the local hit points of
+// an object onto texture coordinates u and v, for image textures (Textures/ImageTexture.h)
+// u runs from 0 at the left of the image to 1 at its right, and v from 0 at the bottom to 1 at the
+// top; u wraps around, and v is clamped.
+
+#include "../Utilities/Point3D.h"
+
+//------------------------------------------------------------------------------------ class Mapping
+
+class Mapping {
+	public:
+
+		Mapping(void);
+
+		Mapping(const Mapping& mapping);
+
+		virtual Mapping*
+		clone(void) const = 0;
+
+		virtual
+		~Mapping(void);
+
+		virtual void
+		get_uv(const Point3D& local_hit_point, float& u, float& v) const = 0;
+
+	protected:
+
+		Mapping&
+		operator= (const Mapping& rhs);
+};
+
+#endif
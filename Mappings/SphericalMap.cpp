@@ -0,0 +1,69 @@
+// This file contains the definition of the class SphericalMap
+
+#include <math.h>
+
+#include "SphericalMap.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------------- default constructor
+
+SphericalMap::SphericalMap(void)
+	: 	Mapping(),
+		center(0.0)
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+SphericalMap::SphericalMap(const SphericalMap& map)
+	: 	Mapping(map),
+		center(map.center)
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+SphericalMap*
+SphericalMap::clone(void) const {
+	return (new SphericalMap(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+SphericalMap&
+SphericalMap::operator= (const SphericalMap& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Mapping::operator=(rhs);
+	center = rhs.center;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+SphericalMap::~SphericalMap(void) {}
+
+
+// ---------------------------------------------------------------- get_uv
+// the point is only used for its direction from the centre, so any point off the centre maps
+
+void
+SphericalMap::get_uv(const Point3D& local_hit_point, float& u, float& v) const {
+	Vector3D d = local_hit_point - center;
+	double length = d.length();
+
+	if (length == 0.0) {
+		u = v = 0.5f;
+		return;
+	}
+
+	double theta 	= acos(fmax(-1.0, fmin(1.0, d.y / length)));
+	double phi 		= atan2(d.x, d.z);
+
+	u = (float)((phi + PI) * invTWO_PI);
+	v = (float)(1.0 - theta * invPI);
+}
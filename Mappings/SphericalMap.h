@@ -0,0 +1,47 @@
+#ifndef __SPHERICAL_MAP__
+#define __SPHERICAL_MAP__
+
+// This file contains the declaration of the class SphericalMap, which wraps an image around a sphere
+// as an equirectangular map: u is the longitude about the y axis through the centre, from -z round
+// through -x, +z and +x, and v the latitude, from the bottom pole to the top one.
+
+#include "Mapping.h"
+
+//------------------------------------------------------------------------------------ class SphericalMap
+
+class SphericalMap: public Mapping {
+	public:
+
+		SphericalMap(void);
+
+		SphericalMap(const SphericalMap& map);
+
+		virtual SphericalMap*
+		clone(void) const;
+
+		SphericalMap&
+		operator= (const SphericalMap& rhs);
+
+		virtual
+		~SphericalMap(void);
+
+		void									// of the sphere, in the space of the local hit points; the origin by default
+		set_center(const Point3D& c);
+
+		virtual void
+		get_uv(const Point3D& local_hit_point, float& u, float& v) const;
+
+	private:
+
+		Point3D		center;
+};
+
+
+// ---------------------------------------------------------------- set_center
+
+inline void
+SphericalMap::set_center(const Point3D& c) {
+	center = c;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "Emissive.h"
+
+// ---------------------------------------------------------------- default constructor
+
+Emissive::Emissive (void)
+	:	Material(),
+		ls(1.0),
+		ce(1.0)
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Emissive::Emissive(const Emissive& m)
+	: 	Material(m),
+		ls(m.ls),
+		ce(m.ce)
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+Material*										
+Emissive::clone(void) const {
+	return (new Emissive(*this));
+}	
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Emissive& 
+Emissive::operator= (const Emissive& rhs) {
+	if (this == &rhs)
+		return (*this);
+		
+	Material::operator=(rhs);
+
+	ls = rhs.ls;
+	ce = rhs.ce;
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Emissive::~Emissive(void) {}
+
+
+// ---------------------------------------------------------------- get_Le
+
+RGBColor
+Emissive::get_Le(ShadeRec& sr) const {
+	return (ls * ce);
+}
+
+
+// ---------------------------------------------------------------- shade
+
+RGBColor
+Emissive::shade(ShadeRec& sr) {
+	if (-sr.normal * sr.ray.d > 0.0)
+		return (ls * ce);
+	else
+		return (black);
+}
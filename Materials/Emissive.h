@@ -0,0 +1,83 @@
+#ifndef __EMISSIVE__
+#define __EMISSIVE__
+
+// This file contains the declaration of the class Emissive, the material of the objects used as
+// area lights
+// It emits radiance ls * ce from the side its object's normal faces, and none from the back.
+
+#include "Material.h"
+
+//----------------------------------------------------------------------------- class Emissive
+
+class Emissive: public Material {	
+	public:
+			
+		Emissive(void);											
+
+		Emissive(const Emissive& m);
+		
+		virtual Material*										
+		clone(void) const;									
+
+		Emissive& 
+		operator= (const Emissive& rhs);							
+
+		~Emissive(void);											
+		
+		void 													
+		scale_radiance(const float _ls);
+		
+		void													
+		set_ce(const RGBColor c);
+		
+		void													
+		set_ce(const float r, const float g, const float b);
+		
+		void																						
+		set_ce(const float c);
+
+		virtual RGBColor
+		get_Le(ShadeRec& sr) const;
+				
+		virtual RGBColor										// what a ray sees when it hits the light
+		shade(ShadeRec& sr);
+		
+	private:
+		
+		float		ls;			// radiance scaling factor
+		RGBColor 	ce;			// color
+};
+
+
+// ---------------------------------------------------------------- scale_radiance
+
+inline void								
+Emissive::scale_radiance(const float _ls) {
+	ls = _ls;
+}
+
+
+// ---------------------------------------------------------------- set_ce
+
+inline void												
+Emissive::set_ce(const RGBColor c) {
+	ce = c;
+}
+
+
+// ---------------------------------------------------------------- set_ce
+
+inline void													
+Emissive::set_ce(const float r, const float g, const float b) {
+	ce.r = r; ce.g = g; ce.b = b;
+}
+
+
+// ---------------------------------------------------------------- set_ce
+
+inline void													
+Emissive::set_ce(const float c) {
+	ce.r = c; ce.g = c; ce.b = c;
+}
+
+#endif
@@ -36,4 +36,27 @@ Material::shade(ShadeRec& sr) {
 }
 
 
+// ---------------------------------------------------------------- path_shade
 
+RGBColor
+Material::path_shade(ShadeRec& sr) {
+	return (black);
+}
+
+
+// ---------------------------------------------------------------- finalize
+// a material that shades as ambient plus Lambertian diffuse reflection, with terms that don't
+// change after the scene is built, fills in the record and returns true
+
+bool
+Material::finalize(MaterialRecord& record) const {
+	return (false);
+}
+
+
+// ---------------------------------------------------------------- get_Le
+
+RGBColor
+Material::get_Le(ShadeRec& sr) const {
+	return (black);
+}
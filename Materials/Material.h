@@ -4,6 +4,7 @@
 #include "../World/World.h"			// required for the shade function in all derived classes
 #include "../Utilities/RGBColor.h"
 #include "../Utilities/ShadeRec.h"
+#include "MaterialRecord.h"
 
 class Material {	
 	public:
@@ -20,6 +21,15 @@ class Material {
 				
 		virtual RGBColor
 		shade(ShadeRec& sr);	
+
+		virtual RGBColor						// the reflected radiance, for path tracing (Tracers/PathTrace.h)
+		path_shade(ShadeRec& sr);
+
+		virtual bool							// bakes the constant shading terms, if the material has them
+		finalize(MaterialRecord& record) const;
+
+		virtual RGBColor						// the emitted radiance, for the materials of area lights
+		get_Le(ShadeRec& sr) const;
 		
 	protected:
 	
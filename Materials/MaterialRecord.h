@@ -0,0 +1,19 @@
+#ifndef __MATERIAL_RECORD__
+#define __MATERIAL_RECORD__
+
+// This file contains the declaration of the struct MaterialRecord
+// A MaterialRecord holds the shading terms of a material that don't change after the scene is built,
+// so that the shading loop reads two colors instead of calling into the material's BRDFs.
+// Material::finalize fills it in. The StaticScene keeps one per material in a table indexed by
+// material id, two records to a cache line.
+
+#include "../Utilities/RGBColor.h"
+
+//----------------------------------------------------------------------------- struct MaterialRecord
+
+struct alignas(32) MaterialRecord {
+	RGBColor	ambient_rho;			// rho of the ambient BRDF, ka * cd for a Matte
+	RGBColor	diffuse_f;				// f of the diffuse BRDF, kd * cd / pi for a Matte
+};
+
+#endif
@@ -1,4 +1,7 @@
 #include "Matte.h"
+#include "../Lights/LightBVH.h"
+#include "../Utilities/Maths.h"
+#include "../Utilities/Stats.h"
 
 // ---------------------------------------------------------------- default constructor
 
@@ -78,24 +81,143 @@ Matte::~Matte(void) {
 }
 
 
+// ---------------------------------------------------------------- set_cd
+
+void
+Matte::set_cd(Texture* texture_ptr) {
+	ambient_brdf->set_cd(texture_ptr->clone());
+	diffuse_brdf->set_cd(texture_ptr);
+}
+
+
 // ---------------------------------------------------------------- shade
 
 RGBColor
 Matte::shade(ShadeRec& sr) {
-	Vector3D 	wo 			= -sr.ray.d;
-	RGBColor 	L 			= ambient_brdf->rho(sr, wo) * sr.w.ambient_ptr->L(sr);
-	int 		num_lights	= sr.w.lights.size();
+	Vector3D wo = -sr.ray.d;
+
+	return (ambient_brdf->rho(sr, wo) * sr.w.ambient_ptr->L(sr) + lights_L(sr, wo, false));
+}
+
+
+// ---------------------------------------------------------------- path_shade
+// the ambient light is left out: the bounce gathers the indirect light that it stands in for
+// the bounced ray doesn't add the emission it hits, which the lights' samples have accounted for
+
+RGBColor
+Matte::path_shade(ShadeRec& sr) {
+	Vector3D 	wo 		= -sr.ray.d;
+	RGBColor 	L 		= lights_L(sr, wo, true);
+	Vector3D 	wi;
+	float		pdf;
+	RGBColor 	f 		= diffuse_brdf->sample_f(sr, wo, wi, pdf);
+	float 		ndotwi 	= sr.normal * wi;
+
+	if (pdf > 0.0 && ndotwi > 0.0) {
+		RGBColor weight = f * (ndotwi / pdf);
+		L += weight * sr.w.tracer_ptr->trace_path(sr.spawn_ray(wi), sr.throughput * weight, false, sr.depth + 1);
+	}
+
+	return (L);
+}
+
+
+// ---------------------------------------------------------------- lights_L
+
+RGBColor
+Matte::lights_L(ShadeRec& sr, const Vector3D& wo, const bool mis) const {
+	RGBColor L;
+
+	if (!sr.w.light_bvh_ptr) {
+		int num_lights = sr.w.lights.size();
 	
-	for (int j = 0; j < num_lights; j++) {
-		Vector3D wi = sr.w.lights[j]->get_direction(sr);    
-		float ndotwi = sr.normal * wi;
+		for (int j = 0; j < num_lights; j++)
+			L += direct_L(sr, wo, *sr.w.lights[j], mis);
 	
-		if (ndotwi > 0.0) 
-			L += diffuse_brdf->f(sr, wo, wi) * sr.w.lights[j]->L(sr) * ndotwi;
+		return (L);
+	}
+
+	// with a light BVH, the lights at infinity are sampled every time, and num_samples of the others
+	// are picked in proportion to their importance at the hit point, each weighted by 1 / (pmf * num_samples)
+
+	const LightBVH& 	bvh 			= *sr.w.light_bvh_ptr;
+	int 				num_samples 	= bvh.get_num_samples();
+
+	for (Light* light_ptr : bvh.infinite_lights())
+		L += direct_L(sr, wo, *light_ptr, mis);
+
+	for (int s = 0; s < num_samples; s++) {
+		float 	pmf;
+		Light* 	light_ptr = bvh.sample(sr.hit_point, sr.normal, random_float(), pmf);
+
+		if (light_ptr)
+			L += direct_L(sr, wo, *light_ptr, mis) / (pmf * num_samples);
 	}
 	
 	return (L);
 }
 
 
+// ---------------------------------------------------------------- finalize
+// a textured matte has no constant terms
+
+bool
+Matte::finalize(MaterialRecord& record) const {
+	if (diffuse_brdf->has_texture())
+		return (false);
+
+	record.ambient_rho 	= ambient_brdf->constant_rho();
+	record.diffuse_f 	= diffuse_brdf->constant_f();
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- direct_L
+// each sample is weighted by G / pdf, which are 1 for the lights that aren't sampled, and the shadow
+// ray is only cast if the light would otherwise reach the hit point
+// with mis, every sample of a light with a surface is paired with a direction from the BRDF, and both
+// are weighted by the power heuristic, which keeps the noise down both where the light is small or
+// far, which the light's samples handle well, and where it is large and close, which the BRDF's do
+
+RGBColor
+Matte::direct_L(ShadeRec& sr, const Vector3D& wo, Light& light, const bool mis) const {
+	int 		num_samples = light.get_num_samples();
+	bool		weighted	= mis && !light.is_delta();
+	RGBColor 	L;
+
+	for (int s = 0; s < num_samples; s++) {
+		STATS_INC(STAT_LIGHT_SAMPLES);
+		Vector3D wi = light.get_direction(sr);
+		float ndotwi = sr.normal * wi;
+
+		if (ndotwi > 0.0 && !(light.casts_shadows() && light.in_shadow(sr.spawn_ray(wi), sr))) {
+			float G = light.G(sr);
+
+			if (!weighted)
+				L += diffuse_brdf->f(sr, wo, wi) * light.L(sr) * (G * ndotwi / light.pdf(sr));
+			else if (G > 0.0) {
+				float light_pdf = light.pdf(sr) / G;
+				float brdf_pdf 	= diffuse_brdf->pdf(sr, wo, wi);
+
+				L += diffuse_brdf->f(sr, wo, wi) * light.L(sr) * (ndotwi * power_heuristic(light_pdf, brdf_pdf) / light_pdf);
+			}
+		}
+
+		if (weighted) {
+			float 		brdf_pdf, light_pdf;
+			RGBColor 	f = diffuse_brdf->sample_f(sr, wo, wi, brdf_pdf);
 
+			ndotwi = sr.normal * wi;
+
+			if (brdf_pdf > 0.0 && ndotwi > 0.0) {
+				RGBColor Li = light.L_along(sr.spawn_ray(wi), sr, light_pdf);
+
+				if (light_pdf > 0.0)
+					L += f * Li * (ndotwi * power_heuristic(brdf_pdf, light_pdf) / brdf_pdf);
+			}
+		}
+	}
+
+	return (num_samples == 1 ? L : L / num_samples);
+}
@@ -3,6 +3,7 @@
 
 #include "Material.h"
 #include "../BRDFs/Lambertian.h"
+#include "../Utilities/Stats.h"
 
 //----------------------------------------------------------------------------- class Matte
 
@@ -35,14 +36,33 @@ class Matte: public Material {
 		
 		void																						
 		set_cd(const float c);
+
+		void													// takes ownership
+		set_cd(Texture* texture_ptr);
 				
 		virtual RGBColor										
 		shade(ShadeRec& sr);
+
+		virtual RGBColor										// direct light with MIS, plus one cosine weighted bounce
+		path_shade(ShadeRec& sr);
+
+		virtual bool
+		finalize(MaterialRecord& record) const;
+
+		template <typename Lights>								// shade from a finalized record, without virtual calls
+		static RGBColor
+		shade_baked(ShadeRec& sr, const MaterialRecord& record, const Lights& lights);
 		
 	private:
 		
 		Lambertian*		ambient_brdf;
 		Lambertian*		diffuse_brdf;
+
+		RGBColor												// the diffuse reflection of all the lights
+		lights_L(ShadeRec& sr, const Vector3D& wo, const bool mis) const;
+
+		RGBColor												// the diffuse reflection of one light, over its samples
+		direct_L(ShadeRec& sr, const Vector3D& wo, Light& light, const bool mis) const;
 };
 
 
@@ -91,4 +111,29 @@ Matte::set_cd(const float c) {
 	diffuse_brdf->set_cd(c);
 }
 
-#endif
\ No newline at end of file
+
+// ---------------------------------------------------------------- shade_baked
+// the same computation as shade, for the static dispatch path (World/StaticScene.h)
+// the BRDF terms come from the record that finalize filled in, and the lights from a StaticScene,
+// which dispatches them without virtual calls
+
+template <typename Lights>
+inline RGBColor
+Matte::shade_baked(ShadeRec& sr, const MaterialRecord& record, const Lights& lights) {
+	Vector3D 	wo 			= -sr.ray.d;
+	RGBColor 	L 			= record.ambient_rho * lights.ambient_L(sr);
+	int 		num_lights	= lights.num_lights();
+	
+	for (int j = 0; j < num_lights; j++) {
+		STATS_INC(STAT_LIGHT_SAMPLES);
+		Vector3D wi = lights.get_direction(j, sr);    
+		float ndotwi = sr.normal * wi;
+	
+		if (ndotwi > 0.0) 
+			L += record.diffuse_f * lights.L(j, sr) * ndotwi;
+	}
+	
+	return (L);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "Reflective.h"
+
+// ---------------------------------------------------------------- default constructor
+
+Reflective::Reflective (void)
+	:	Matte(),
+		reflective_brdf(new PerfectSpecular)
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Reflective::Reflective(const Reflective& rm)
+	: 	Matte(rm)
+{
+	if(rm.reflective_brdf)
+		reflective_brdf = rm.reflective_brdf->clone(); 
+	else  reflective_brdf = NULL;
+}
+
+
+// ---------------------------------------------------------------- clone
+
+Material*										
+Reflective::clone(void) const {
+	return (new Reflective(*this));
+}	
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Reflective& 
+Reflective::operator= (const Reflective& rhs) {
+	if (this == &rhs)
+		return (*this);
+		
+	Matte::operator=(rhs);
+	
+	if (reflective_brdf) {
+		delete reflective_brdf;
+		reflective_brdf = NULL;
+	}
+
+	if (rhs.reflective_brdf)
+		reflective_brdf = rhs.reflective_brdf->clone();
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Reflective::~Reflective(void) {
+	if (reflective_brdf) {
+		delete reflective_brdf;
+		reflective_brdf = NULL;
+	}
+}
+
+
+// ---------------------------------------------------------------- shade
+// the reflected ray's throughput is its weight here times the throughput of the ray that hit
+
+RGBColor
+Reflective::shade(ShadeRec& sr) {	
+	RGBColor 	L(Matte::shade(sr));
+	Vector3D 	wo 		= -sr.ray.d;
+	Vector3D 	wi;	
+	RGBColor 	fr 		= reflective_brdf->sample_f(sr, wo, wi); 
+	RGBColor	weight 	= fr * fabs(sr.normal * wi);
+	
+	L += weight * sr.w.tracer_ptr->trace_ray(sr.spawn_ray(wi), sr.throughput * weight, sr.depth + 1);
+	
+	return (L);
+}
+
+
+// ---------------------------------------------------------------- path_shade
+// the lights aren't sampled along a mirror direction, so the reflected ray adds the emission it hits
+
+RGBColor
+Reflective::path_shade(ShadeRec& sr) {	
+	RGBColor 	L(Matte::path_shade(sr));
+	Vector3D 	wo 		= -sr.ray.d;
+	Vector3D 	wi;	
+	RGBColor 	fr 		= reflective_brdf->sample_f(sr, wo, wi); 
+	RGBColor	weight 	= fr * fabs(sr.normal * wi);
+	
+	L += weight * sr.w.tracer_ptr->trace_path(sr.spawn_ray(wi), sr.throughput * weight, true, sr.depth + 1);
+	
+	return (L);
+}
+
+
+// ---------------------------------------------------------------- finalize
+
+bool
+Reflective::finalize(MaterialRecord& record) const {
+	return (false);
+}
@@ -0,0 +1,86 @@
+#ifndef __REFLECTIVE__
+#define __REFLECTIVE__
+
+// This file contains the declaration of the class Reflective, a Matte material with mirror reflection
+// on top; the reflected ray is traced by the world's tracer, which must be recursive (Tracers/Whitted.h)
+
+#include "Matte.h"
+#include "../BRDFs/PerfectSpecular.h"
+
+//----------------------------------------------------------------------------- class Reflective
+
+class Reflective: public Matte {	
+	public:
+			
+		Reflective(void);											
+
+		Reflective(const Reflective& rm);
+		
+		virtual Material*										
+		clone(void) const;									
+
+		Reflective& 
+		operator= (const Reflective& rhs);							
+
+		~Reflective(void);
+		
+		void
+		set_kr(const float k);
+				
+		void													
+		set_cr(const RGBColor& c);
+		
+		void
+		set_cr(const float r, const float g, const float b);
+		
+		void
+		set_cr(const float c);
+		
+		virtual RGBColor										
+		shade(ShadeRec& sr);
+
+		virtual RGBColor
+		path_shade(ShadeRec& sr);
+
+		virtual bool											// false: the reflection can't be baked
+		finalize(MaterialRecord& record) const;
+		
+	private:
+	
+		PerfectSpecular* reflective_brdf;		
+};
+
+
+// ---------------------------------------------------------------- set_kr
+
+inline void
+Reflective::set_kr(const float k) {
+	reflective_brdf->set_kr(k);
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void
+Reflective::set_cr(const RGBColor& c) {
+	reflective_brdf->set_cr(c);
+	
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void
+Reflective::set_cr(const float r, const float g, const float b) {
+	reflective_brdf->set_cr(r, g, b);
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void
+Reflective::set_cr(const float c) {
+	reflective_brdf->set_cr(c);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "Transparent.h"
+
+// ---------------------------------------------------------------- default constructor
+
+Transparent::Transparent (void)
+	:	Matte(),
+		reflective_brdf(new PerfectSpecular),
+		specular_btdf(new PerfectTransmitter)
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Transparent::Transparent(const Transparent& tm)
+	: 	Matte(tm)
+{
+	if(tm.reflective_brdf)
+		reflective_brdf = tm.reflective_brdf->clone(); 
+	else  reflective_brdf = NULL;
+
+	if(tm.specular_btdf)
+		specular_btdf = tm.specular_btdf->clone(); 
+	else  specular_btdf = NULL;
+}
+
+
+// ---------------------------------------------------------------- clone
+
+Material*										
+Transparent::clone(void) const {
+	return (new Transparent(*this));
+}	
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Transparent& 
+Transparent::operator= (const Transparent& rhs) {
+	if (this == &rhs)
+		return (*this);
+		
+	Matte::operator=(rhs);
+	
+	if (reflective_brdf) {
+		delete reflective_brdf;
+		reflective_brdf = NULL;
+	}
+
+	if (rhs.reflective_brdf)
+		reflective_brdf = rhs.reflective_brdf->clone();
+
+	if (specular_btdf) {
+		delete specular_btdf;
+		specular_btdf = NULL;
+	}
+
+	if (rhs.specular_btdf)
+		specular_btdf = rhs.specular_btdf->clone();
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Transparent::~Transparent(void) {
+	if (reflective_brdf) {
+		delete reflective_brdf;
+		reflective_brdf = NULL;
+	}
+
+	if (specular_btdf) {
+		delete specular_btdf;
+		specular_btdf = NULL;
+	}
+}
+
+
+// ---------------------------------------------------------------- shade
+// each secondary ray's throughput is its weight here times the throughput of the ray that hit
+
+RGBColor
+Transparent::shade(ShadeRec& sr) {	
+	RGBColor 	L(Matte::shade(sr));
+	Vector3D 	wo 		= -sr.ray.d;
+	Vector3D 	wi;	
+	RGBColor 	fr 		= reflective_brdf->sample_f(sr, wo, wi);
+	
+	if (specular_btdf->tir(sr)) {
+		L += sr.w.tracer_ptr->trace_ray(sr.spawn_ray(wi), sr.throughput, sr.depth + 1);
+		return (L);
+	}
+
+	Vector3D 	wt;
+	RGBColor 	ft 			= specular_btdf->sample_f(sr, wo, wt);
+	RGBColor	weight_r 	= fr * fabs(sr.normal * wi);
+	RGBColor	weight_t 	= ft * fabs(sr.normal * wt);
+
+	L += weight_r * sr.w.tracer_ptr->trace_ray(sr.spawn_ray(wi), sr.throughput * weight_r, sr.depth + 1);
+	L += weight_t * sr.w.tracer_ptr->trace_ray(sr.spawn_ray(wt), sr.throughput * weight_t, sr.depth + 1);
+	
+	return (L);
+}
+
+
+// ---------------------------------------------------------------- path_shade
+// as shade, with the reflected and transmitted rays adding the emission they hit, as in Reflective
+
+RGBColor
+Transparent::path_shade(ShadeRec& sr) {	
+	RGBColor 	L(Matte::path_shade(sr));
+	Vector3D 	wo 		= -sr.ray.d;
+	Vector3D 	wi;	
+	RGBColor 	fr 		= reflective_brdf->sample_f(sr, wo, wi);
+	
+	if (specular_btdf->tir(sr)) {
+		L += sr.w.tracer_ptr->trace_path(sr.spawn_ray(wi), sr.throughput, true, sr.depth + 1);
+		return (L);
+	}
+
+	Vector3D 	wt;
+	RGBColor 	ft 			= specular_btdf->sample_f(sr, wo, wt);
+	RGBColor	weight_r 	= fr * fabs(sr.normal * wi);
+	RGBColor	weight_t 	= ft * fabs(sr.normal * wt);
+
+	L += weight_r * sr.w.tracer_ptr->trace_path(sr.spawn_ray(wi), sr.throughput * weight_r, true, sr.depth + 1);
+	L += weight_t * sr.w.tracer_ptr->trace_path(sr.spawn_ray(wt), sr.throughput * weight_t, true, sr.depth + 1);
+	
+	return (L);
+}
+
+
+// ---------------------------------------------------------------- finalize
+
+bool
+Transparent::finalize(MaterialRecord& record) const {
+	return (false);
+}
@@ -0,0 +1,90 @@
+#ifndef __TRANSPARENT__
+#define __TRANSPARENT__
+
+// This file contains the declaration of the class Transparent, a Matte material with mirror reflection
+// and refraction on top, for glass and water
+// Where the refracted ray would be totally internally reflected, all the light is reflected. The
+// reflected and transmitted rays are traced by the world's tracer, which must be recursive
+// (Tracers/Whitted.h).
+
+#include "Matte.h"
+#include "../BRDFs/PerfectSpecular.h"
+#include "../BTDFs/PerfectTransmitter.h"
+
+//----------------------------------------------------------------------------- class Transparent
+
+class Transparent: public Matte {	
+	public:
+			
+		Transparent(void);											
+
+		Transparent(const Transparent& tm);
+		
+		virtual Material*										
+		clone(void) const;									
+
+		Transparent& 
+		operator= (const Transparent& rhs);							
+
+		~Transparent(void);
+		
+		void
+		set_kr(const float k);
+				
+		void													
+		set_cr(const RGBColor& c);
+
+		void
+		set_kt(const float k);
+
+		void
+		set_ior(const float eta);
+		
+		virtual RGBColor										
+		shade(ShadeRec& sr);
+
+		virtual RGBColor
+		path_shade(ShadeRec& sr);
+
+		virtual bool											// false: the reflection can't be baked
+		finalize(MaterialRecord& record) const;
+		
+	private:
+	
+		PerfectSpecular* 		reflective_brdf;		
+		PerfectTransmitter* 	specular_btdf;
+};
+
+
+// ---------------------------------------------------------------- set_kr
+
+inline void
+Transparent::set_kr(const float k) {
+	reflective_brdf->set_kr(k);
+}
+
+
+// ---------------------------------------------------------------- set_cr
+
+inline void
+Transparent::set_cr(const RGBColor& c) {
+	reflective_brdf->set_cr(c);
+}
+
+
+// ---------------------------------------------------------------- set_kt
+
+inline void
+Transparent::set_kt(const float k) {
+	specular_btdf->set_kt(k);
+}
+
+
+// ---------------------------------------------------------------- set_ior
+
+inline void
+Transparent::set_ior(const float eta) {
+	specular_btdf->set_ior(eta);
+}
+
+#endif
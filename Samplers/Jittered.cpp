@@ -8,15 +8,31 @@ Jittered::Jittered(int samples) : Sampler(samples) {
     setup_shuffled_indices();
 }
 
+/*!
+ * Jitters one sample in every cell of an n by n grid, for each set. A count that isn't a square gets the
+ * next larger grid, and that many cells, picked at random, are dropped from each set, so every set
+ * still holds num_samples samples for next_index to step through.
+ */
 void Jittered::generate_samples() {
-    int n = (int) sqrt(num_samples);
+    int n = (int) ceil(sqrt(num_samples));
+    std::vector<Point2D> set;
 
     for (int p = 0; p < num_sets; p++) {
+        set.clear();
         for (int j = 0; j < n; j++) {
             for (int k = 0; k < n; k++) {
                 Point2D sp(((float)k + random_float()) / (float)n, ((float)j + random_float()) / (float)n);
-                samples.push_back(sp);
+                set.push_back(sp);
             }
         }
+        while ((int)set.size() > num_samples) {
+            set[random_int() % set.size()] = set.back();
+            set.pop_back();
+        }
+        samples.insert(samples.end(), set.begin(), set.end());
     }
 }
+
+Jittered* Jittered::clone() const {
+    return new Jittered(*this);
+}
@@ -9,6 +9,7 @@ private:
     void generate_samples() override;
 public:
     explicit Jittered(int);
+    Jittered* clone() const override;
 };
 
 
@@ -0,0 +1,43 @@
+#include "PerThreadSampler.h"
+#include <atomic>
+#include <vector>
+
+static std::atomic<int> next_id {0};
+
+PerThreadSampler::PerThreadSampler() = default;
+
+PerThreadSampler::PerThreadSampler(Sampler* sampler) {
+    set_sampler(sampler);
+}
+
+PerThreadSampler::PerThreadSampler(const PerThreadSampler& other)
+    : prototype{other.prototype}, num_samples{other.num_samples}, id{other.prototype ? next_id++ : -1} {}
+
+PerThreadSampler& PerThreadSampler::operator=(const PerThreadSampler& other) {
+    if (this != &other) {
+        prototype = other.prototype;
+        num_samples = other.num_samples;
+        id = prototype ? next_id++ : -1;
+    }
+    return *this;
+}
+
+void PerThreadSampler::set_sampler(Sampler* sampler) {
+    num_samples = sampler->get_num_samples();
+    prototype.reset(sampler);
+    id = next_id++;
+}
+
+/*!
+ * Returns this thread's clone of the prototype, cloning it on the first call.
+ * The clones live until the thread exits; ids aren't reused, so a clone never outlives its meaning.
+ */
+Sampler& PerThreadSampler::get() const {
+    thread_local std::vector<std::unique_ptr<Sampler>> clones;
+
+    if (id >= (int) clones.size())
+        clones.resize(id + 1);
+    if (!clones[id])
+        clones[id].reset(prototype->clone());
+    return *clones[id];
+}
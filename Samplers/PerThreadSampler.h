@@ -0,0 +1,37 @@
+#ifndef RAY_TRACING_FROM_THE_GROUND_UP_PERTHREADSAMPLER_H
+#define RAY_TRACING_FROM_THE_GROUND_UP_PERTHREADSAMPLER_H
+
+
+#include <memory>
+#include "Sampler.h"
+
+// A Sampler can't be shared between render threads, because sample_unit_square advances its position
+// in the sample sets. A PerThreadSampler holds a prototype and gives each thread its own clone, made
+// the first time the thread asks for it, so lights and materials can draw samples during shading
+// without locking, and without allocating after the first call on each thread.
+// Each thread should draw whole sets of get_num_samples() samples at a time; the clone then picks its
+// sets with the thread's random engine, which render_scene reseeds per tile, so images don't depend on
+// which thread rendered which tile.
+class PerThreadSampler {
+public:
+    PerThreadSampler();
+    explicit PerThreadSampler(Sampler* sampler);                // takes ownership
+    PerThreadSampler(const PerThreadSampler& other);            // shares the prototype, not the clones
+    PerThreadSampler& operator=(const PerThreadSampler& other);
+
+    void set_sampler(Sampler* sampler);                         // takes ownership
+    Sampler& get() const;                                       // this thread's clone
+    int get_num_samples() const;
+
+private:
+    std::shared_ptr<const Sampler> prototype {};
+    int num_samples {0};
+    int id {-1};                            // indexes the thread's clones; every prototype and copy gets a new one
+};
+
+inline int PerThreadSampler::get_num_samples() const {
+    return num_samples;
+}
+
+
+#endif //RAY_TRACING_FROM_THE_GROUND_UP_PERTHREADSAMPLER_H
@@ -4,9 +4,25 @@
 
 PureRandom::PureRandom(int samples) : Sampler(samples) {}
 
+PureRandom* PureRandom::clone() const {
+    return new PureRandom(*this);
+}
+
 void PureRandom::generate_samples() {}
 
 
 Point2D PureRandom::sample_unit_square() {
     return Point2D{random_float(), random_float()};     // Ska det verkligen vara + jump två gånger?
+}
+
+Point2D PureRandom::sample_unit_disk() {
+    return concentric_map(sample_unit_square());
+}
+
+Point3D PureRandom::sample_hemisphere() {
+    return hemisphere_map(sample_unit_square(), hemisphere_exp);
+}
+
+float PureRandom::sample_time() {
+    return random_float();
 }
\ No newline at end of file
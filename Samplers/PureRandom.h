@@ -17,8 +17,20 @@ class PureRandom : public Sampler {
         explicit
         PureRandom(int);
 
+        PureRandom*
+        clone() const override;
+
         Point2D
         sample_unit_square();
+
+        float
+        sample_time() override;
+
+        Point2D
+        sample_unit_disk() override;
+
+        Point3D
+        sample_hemisphere() override;
 };
 
 
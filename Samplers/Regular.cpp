@@ -8,7 +8,9 @@
 
 // ---------------------------------------------------------------- default constructor
 	
-Regular::Regular() : Sampler() {}
+Regular::Regular() : Sampler() {
+    generate_samples();
+}
 
 
 // ---------------------------------------------------------------- constructor
@@ -40,12 +42,38 @@ Regular* Regular::clone() const {
 Regular::~Regular() = default;
 
 
-// ---------------------------------------------------------------- generate_samples
+// ---------------------------------------------------------------- sample_unit_square
 
 Point2D Regular::sample_unit_square() {
     return Point2D{0.5, 0.5};
 }
 
-void Regular::generate_samples() {}
+// ---------------------------------------------------------------- sample_unit_disk
+// the mapped tables hold the image of the one sample, the middle of the pixel, which for the disk is
+// its centre; the lookups don't pick sets, as there is only one
+
+Point2D Regular::sample_unit_disk() {
+    return disk_samples[0];
+}
+
+// ---------------------------------------------------------------- sample_hemisphere
+
+Point3D Regular::sample_hemisphere() {
+    return hemisphere_samples[0];
+}
+
+// ---------------------------------------------------------------- sample_time
+// the middle of the shutter interval, as the sample is the middle of the pixel
+
+float Regular::sample_time() {
+    return 0.5f;
+}
+
+// ---------------------------------------------------------------- generate_samples
+// the one sample, so that the disk and hemisphere tables can be mapped from it
+
+void Regular::generate_samples() {
+    samples.assign(1, Point2D(0.5, 0.5));
+}
 
 
@@ -9,9 +9,12 @@ public:
     Regular();
     Regular(const Regular& u);
     Regular& operator=(const Regular& rhs);
-    virtual Regular* clone() const;
+    Regular* clone() const override;
     ~Regular() override;
     Point2D sample_unit_square() override;
+    Point2D sample_unit_disk() override;
+    Point3D sample_hemisphere() override;
+    float sample_time() override;
     void generate_samples() override;
 };
 
@@ -4,8 +4,9 @@
 
 #include "Sampler.h"
 #include <algorithm>
+#include <cmath>
 #include <random>
-//#include "../Utilities/Maths.h"
+#include "../Utilities/Constants.h"
 
 Sampler::Sampler(int samples, int sets) : num_samples{samples}, num_sets{sets} {};
 Sampler::Sampler(int samples) : num_samples(samples), num_sets{86} {};
@@ -16,9 +17,126 @@ Sampler::Sampler() = default;
  * @return 2D sample point
  */
 Point2D Sampler::sample_unit_square() {
-    if (count % num_samples == 0)
-        jump = (random_int() % num_sets) * num_samples;
-    return samples[jump + shuffled_indices[jump + count++ % num_samples]];     // Ska det verkligen vara + jump två gånger?
+    return samples[next_index()];
+}
+
+/*!
+ * Maps a unit square point onto the unit disk with Shirley and Chiu's concentric mapping: squares about
+ * the centre go to circles, so the mapping keeps areas in proportion and strata compact.
+ * @param sp the point on the unit square
+ * @return the point on the unit disk
+ */
+Point2D Sampler::concentric_map(const Point2D& sp) {
+    double x = 2.0 * sp.x - 1.0;
+    double y = 2.0 * sp.y - 1.0;
+    double r, phi;
+
+    if (x > -y) {
+        if (x > y) {                    // sector 1
+            r = x;
+            phi = y / x;
+        }
+        else {                          // sector 2
+            r = y;
+            phi = 2.0 - x / y;
+        }
+    }
+    else {
+        if (x < y) {                    // sector 3
+            r = -x;
+            phi = 4.0 + y / x;
+        }
+        else {                          // sector 4
+            r = -y;
+            phi = y != 0.0 ? 6.0 - x / y : 0.0;
+        }
+    }
+    phi *= PI / 4.0;
+    return Point2D(r * cos(phi), r * sin(phi));
+}
+
+/*!
+ * Maps every unit square sample onto the unit disk, for lens and disk light sampling. The table is
+ * made once, for all the sets, and shared by the clones, so sample_unit_disk is a lookup.
+ */
+void Sampler::map_samples_to_unit_disk() {
+    disk_samples.clear();
+    disk_samples.reserve(samples.size());
+
+    for (const Point2D& sp : samples)
+        disk_samples.push_back(concentric_map(sp));
+}
+
+/*!
+ * Returns a randomly picked disk sample, in the same order as sample_unit_square.
+ * map_samples_to_unit_disk must have been called.
+ * @return 2D sample point on the unit disk
+ */
+Point2D Sampler::sample_unit_disk() {
+    return disk_samples[next_index()];
+}
+
+/*!
+ * Maps a unit square point onto the unit hemisphere about +z, with density proportional to cos^e of
+ * the polar angle: x sets the azimuth, and y the polar angle through cos_theta = (1 - y)^(1 / (e + 1)).
+ * The mapping keeps the stratification of the square samples.
+ * @param sp the point on the unit square
+ * @param e the exponent; 1 gives the cosine-weighted samples for diffuse lighting and ambient occlusion
+ * @return the point on the hemisphere
+ */
+Point3D Sampler::hemisphere_map(const Point2D& sp, const float e) {
+    double cos_phi = cos(2.0 * PI * sp.x);
+    double sin_phi = sin(2.0 * PI * sp.x);
+    double cos_theta = pow((1.0 - sp.y), 1.0 / (e + 1.0));
+    double sin_theta = sqrt(1.0 - cos_theta * cos_theta);
+    return Point3D(sin_theta * cos_phi, sin_theta * sin_phi, cos_theta);
+}
+
+/*!
+ * Maps every unit square sample onto the unit hemisphere, once, for all the sets, so that
+ * sample_hemisphere is a lookup.
+ * @param e the exponent of the cos^e density
+ */
+void Sampler::map_samples_to_hemisphere(const float e) {
+    hemisphere_exp = e;
+    hemisphere_samples.clear();
+    hemisphere_samples.reserve(samples.size());
+
+    for (const Point2D& sp : samples)
+        hemisphere_samples.push_back(hemisphere_map(sp, e));
+}
+
+/*!
+ * Returns a randomly picked hemisphere sample, in the same order as sample_unit_square.
+ * map_samples_to_hemisphere must have been called.
+ * @return 3D sample point on the unit hemisphere about +z
+ */
+Point3D Sampler::sample_hemisphere() {
+    return hemisphere_samples[next_index()];
+}
+
+/*!
+ * Returns a ray time for the last unit square sample, for motion blur. Every set holds one time in each
+ * of num_samples equal strata of [0, 1), in an order shuffled independently of the square samples, so
+ * the pixel samples cover the shutter interval evenly without tying times to positions in the pixel.
+ * The times come from a fixed seed, so every render thread's clone makes the same ones.
+ * @return the time, from 0 when the shutter opens to 1 when it closes
+ */
+float Sampler::sample_time() {
+    if (time_samples.empty()) {
+        std::mt19937 engine(num_samples * 7919 + num_sets);
+        std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+        std::vector<float> times(num_samples);
+
+        time_samples.reserve(num_samples * num_sets);
+        for (int p = 0; p < num_sets; p++) {
+            for (int j = 0; j < num_samples; j++)
+                times[j] = std::min((j + jitter(engine)) / num_samples, 1.0f - 1.0e-6f);
+            std::shuffle(times.begin(), times.end(), engine);
+            time_samples.insert(time_samples.end(), times.begin(), times.end());
+        }
+    }
+    return time_samples[jump + (count + num_samples - 1) % num_samples];
 }
 
 /*!
@@ -33,11 +151,47 @@ void Sampler::setup_shuffled_indices() {
     for (int j = 0; j < num_samples; j++)
         indices.push_back(j);
     for (int p = 0; p < num_sets; p++) {
-        std::shuffle(indices.begin(), indices.end(), std::mt19937(std::random_device()()));
+        std::shuffle(indices.begin(), indices.end(), rand_engine());
 
         for (int j = 0; j < num_samples; j++)
             shuffled_indices.push_back(indices[j]);
     }
  }
 
+/*!
+ * Shuffles the order of the samples within every set, taking the mapped disk and hemisphere tables
+ * along, so a table entry is still the image of the square sample at the same index. Samplers whose
+ * generate_samples lays the sets out in a fixed order, such as Jittered's row by row, can call this to
+ * break up patterns between the sets; sample_unit_square already visits each set in a shuffled order.
+ */
+void Sampler::shuffle_samples() {
+    std::vector<int> order(num_samples);
+
+    for (int p = 0; p < num_sets && (p + 1) * num_samples <= (int)samples.size(); p++) {
+        int start = p * num_samples;
+
+        for (int j = 0; j < num_samples; j++)
+            order[j] = start + j;
+        std::shuffle(order.begin(), order.end(), rand_engine());
+
+        std::vector<Point2D> set(num_samples);
+        for (int j = 0; j < num_samples; j++)
+            set[j] = samples[order[j]];
+        std::copy(set.begin(), set.end(), samples.begin() + start);
+
+        if (!disk_samples.empty()) {
+            for (int j = 0; j < num_samples; j++)
+                set[j] = disk_samples[order[j]];
+            std::copy(set.begin(), set.end(), disk_samples.begin() + start);
+        }
+
+        if (!hemisphere_samples.empty()) {
+            std::vector<Point3D> hemisphere_set(num_samples);
+            for (int j = 0; j < num_samples; j++)
+                hemisphere_set[j] = hemisphere_samples[order[j]];
+            std::copy(hemisphere_set.begin(), hemisphere_set.end(), hemisphere_samples.begin() + start);
+        }
+    }
+}
+
 Sampler::~Sampler() {}
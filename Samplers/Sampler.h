@@ -14,24 +14,52 @@ public:
     Sampler(int, int);
 
     virtual void generate_samples() = 0;
+    virtual Sampler* clone() const = 0;         // render threads each work on their own copy
     virtual ~Sampler();
     void setup_shuffled_indices();
-    void shuffle_samples();
+    void shuffle_samples();                     // reorders the samples within each set, and the mapped tables with them
 
     virtual Point2D sample_unit_square();
     int get_num_samples();
 
+    void map_samples_to_unit_disk();            // concentric, so the strata stay compact
+    virtual Point2D sample_unit_disk();         // from the same sets as sample_unit_square
+
+    void map_samples_to_hemisphere(float e);    // density cos^e about +z; e = 1 is cosine weighted
+    virtual Point3D sample_hemisphere();        // from the same sets as sample_unit_square
+    virtual float sample_time();                // in [0, 1), for the sample that sample_unit_square returned last
+
 
 protected:
     int num_samples {1};                        // Number of samplepoints in a pattern
     int num_sets {1};                           // The number of sample sets stored (we want different sets so we repeat less sample patterns)
     std::vector<Point2D> samples {};           // Sample points on a unit square
+    std::vector<Point2D> disk_samples {};       // The samples mapped onto the unit disk, if they have been
+    std::vector<Point3D> hemisphere_samples {}; // The samples mapped onto the unit hemisphere, if they have been
+    float hemisphere_exp {-1.0f};               // The exponent they were mapped with, -1 if they haven't been
+    std::vector<float> time_samples {};         // Stratified ray times, made on the first sample_time
     std::vector<int> shuffled_indices {};      // shuffled samples array indices
     unsigned long count {0};                // The current number of sample points used
     int jump {0};                           // random index jumps (to access a different set)
 
+    int next_index();                       // into samples and the mapped tables, for the next sample
+
+    static Point2D concentric_map(const Point2D& sp);                   // from the unit square onto the unit disk
+    static Point3D hemisphere_map(const Point2D& sp, const float e);    // from the unit square onto the hemisphere
 };
 
+/*!
+ * Picks a new set, at random, at the start of every num_samples samples, and steps through the set
+ * in its shuffled order. Every table lookup goes through this, so the unit square, disk and
+ * hemisphere samples all come from the same sets in the same order.
+ * @return the index of the next sample in samples, disk_samples and hemisphere_samples
+ */
+inline int Sampler::next_index() {
+    if (count % num_samples == 0)
+        jump = (random_int() % num_sets) * num_samples;
+    return jump + shuffled_indices[jump + count++ % num_samples];
+}
+
 inline int Sampler::get_num_samples() {
     return num_samples;
 }
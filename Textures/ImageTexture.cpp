@@ -0,0 +1,176 @@
+// This file contains the definition of the class ImageTexture
+
+#include <math.h>
+
+#include "ImageTexture.h"
+#include "../Mappings/SphericalMap.h"
+#include "../Utilities/Constants.h"
+
+// ---------------------------------------------------------------- wrap
+// the difference of two values of u, which wraps around, the short way
+
+static float
+wrap(const float du) {
+	return (du - floorf(du + 0.5f));
+}
+
+
+// ---------------------------------------------------------------- unpack
+
+static RGBColor
+unpack(const uint32_t texel) {
+	const float scale = 1.0f / 255.0f;
+
+	return (RGBColor((texel & 0xff) * scale, ((texel >> 8) & 0xff) * scale, ((texel >> 16) & 0xff) * scale));
+}
+
+
+// ---------------------------------------------------------------- default constructor
+
+ImageTexture::ImageTexture(void)
+	: 	Texture(),
+		cache_ptr(NULL),
+		texture_id(-1),
+		mapping_ptr(new SphericalMap)
+{}
+
+
+// ---------------------------------------------------------------- constructor
+
+ImageTexture::ImageTexture(TileCache* _cache_ptr, const int _texture_id)
+	: 	Texture(),
+		cache_ptr(_cache_ptr),
+		texture_id(_texture_id),
+		mapping_ptr(new SphericalMap)
+{}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+ImageTexture::ImageTexture(const ImageTexture& texture)
+	: 	Texture(texture),
+		cache_ptr(texture.cache_ptr),
+		texture_id(texture.texture_id),
+		mapping_ptr(texture.mapping_ptr->clone())
+{}
+
+
+// ---------------------------------------------------------------- clone
+
+ImageTexture*
+ImageTexture::clone(void) const {
+	return (new ImageTexture(*this));
+}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+ImageTexture&
+ImageTexture::operator= (const ImageTexture& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	Texture::operator=(rhs);
+
+	cache_ptr 	= rhs.cache_ptr;
+	texture_id 	= rhs.texture_id;
+
+	delete mapping_ptr;
+	mapping_ptr = rhs.mapping_ptr->clone();
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+ImageTexture::~ImageTexture(void) {
+	delete mapping_ptr;
+}
+
+
+// ---------------------------------------------------------------- set_mapping
+
+void
+ImageTexture::set_mapping(Mapping* _mapping_ptr) {
+	delete mapping_ptr;
+	mapping_ptr = _mapping_ptr;
+}
+
+
+// ---------------------------------------------------------------- get_color
+// a texture without a cache or texture is black
+
+RGBColor
+ImageTexture::get_color(const ShadeRec& sr) const {
+	if (!cache_ptr || texture_id < 0)
+		return (black);
+
+	float u, v;
+
+	mapping_ptr->get_uv(sr.local_hit_point, u, v);
+
+	float 	level 		= mip_level(sr, u, v);
+	int 	level0 		= (int)level;
+	float 	f 			= level - level0;
+
+	if (f == 0.0f)
+		return (bilinear(level0, u, v));
+
+	return ((1.0f - f) * bilinear(level0, u, v) + f * bilinear(level0 + 1, u, v));
+}
+
+
+// ---------------------------------------------------------------- mip_level
+
+float
+ImageTexture::mip_level(const ShadeRec& sr, const float u, const float v) const {
+	if (sr.dpdx * sr.dpdx == 0.0 || sr.dpdy * sr.dpdy == 0.0)
+		return (0.0f);
+
+	const TextureFile& 	file 	= cache_ptr->get_texture(texture_id);
+	float 				width 	= file.get_width(0);
+	float 				height 	= file.get_height(0);
+	float 				ux, vx, uy, vy;
+
+	mapping_ptr->get_uv(sr.local_hit_point + sr.dpdx, ux, vx);
+	mapping_ptr->get_uv(sr.local_hit_point + sr.dpdy, uy, vy);
+
+	float dx 		= hypotf(wrap(ux - u) * width, (vx - v) * height);
+	float dy 		= hypotf(wrap(uy - u) * width, (vy - v) * height);
+	float texels 	= fmaxf(dx, dy);
+
+	if (texels <= 1.0f)
+		return (0.0f);
+
+	return (fminf(log2f(texels), (float)(file.get_num_levels() - 1)));
+}
+
+
+// ---------------------------------------------------------------- bilinear
+// the texel centres are at half integers; u wraps around and v is clamped
+
+RGBColor
+ImageTexture::bilinear(const int level, const float u, const float v) const {
+	const TextureFile& 	file 	= cache_ptr->get_texture(texture_id);
+	int 				width 	= file.get_width(level);
+	int 				height 	= file.get_height(level);
+	float 				x 		= u * width - 0.5f;
+	float 				y 		= (1.0f - v) * height - 0.5f;
+	float 				x0 		= floorf(x);
+	float 				y0 		= floorf(y);
+	float 				fx 		= x - x0;
+	float 				fy 		= y - y0;
+
+	int c0 = ((int)x0 % width + width) % width;
+	int c1 = (c0 + 1) % width;
+	int r0 = (int)fminf(fmaxf(y0, 0.0f), (float)(height - 1));
+	int r1 = (int)fminf(fmaxf(y0 + 1.0f, 0.0f), (float)(height - 1));
+
+	RGBColor top 	= (1.0f - fx) * unpack(cache_ptr->texel(texture_id, level, c0, r0))
+					+ fx * unpack(cache_ptr->texel(texture_id, level, c1, r0));
+	RGBColor bottom = (1.0f - fx) * unpack(cache_ptr->texel(texture_id, level, c0, r1))
+					+ fx * unpack(cache_ptr->texel(texture_id, level, c1, r1));
+
+	return ((1.0f - fy) * top + fy * bottom);
+}
@@ -0,0 +1,56 @@
+#ifndef __IMAGE_TEXTURE__
+#define __IMAGE_TEXTURE__
+
+// This file contains the declaration of the class ImageTexture, an image read through a TileCache
+// The hit's local_hit_point is mapped onto the image's u and v by a mapping, spherical by default.
+// The MIP level is chosen from the footprint of the pixel on the image: the hit's differentials
+// (ShadeRec::dpdx and dpdy) are mapped as well, and the level is the log2 of the longer of the two
+// offsets, in texels of the full image, so that a texel of the level is about a pixel wide. The
+// colour is interpolated bilinearly within the two levels around that, and linearly between them.
+// Hits without differentials, such as those of reflected rays, take the full image.
+// The texture doesn't own the cache, which must outlive it; copies share the cache and the file.
+
+#include "Texture.h"
+#include "TileCache.h"
+#include "../Mappings/Mapping.h"
+
+//------------------------------------------------------------------------------------ class ImageTexture
+
+class ImageTexture: public Texture {
+	public:
+
+		ImageTexture(void);
+
+		ImageTexture(TileCache* cache_ptr, const int texture_id);		// texture_id from TileCache::open
+
+		ImageTexture(const ImageTexture& texture);
+
+		virtual ImageTexture*
+		clone(void) const;
+
+		ImageTexture&
+		operator= (const ImageTexture& rhs);
+
+		virtual
+		~ImageTexture(void);
+
+		void									// takes ownership
+		set_mapping(Mapping* mapping_ptr);
+
+		virtual RGBColor
+		get_color(const ShadeRec& sr) const;
+
+	private:
+
+		TileCache*	cache_ptr;
+		int			texture_id;
+		Mapping*	mapping_ptr;
+
+		float									// the MIP level for the hit at u, v, from 0 for the full image
+		mip_level(const ShadeRec& sr, const float u, const float v) const;
+
+		RGBColor
+		bilinear(const int level, const float u, const float v) const;
+};
+
+#endif
@@ -0,0 +1,28 @@
+// This file contains the definition of the class Texture
+
+#include "Texture.h"
+
+// ---------------------------------------------------------------- default constructor
+
+Texture::Texture(void) {}
+
+
+// ---------------------------------------------------------------- copy constructor
+
+Texture::Texture(const Texture& texture) {}
+
+
+// ---------------------------------------------------------------- assignment operator
+
+Texture&
+Texture::operator= (const Texture& rhs) {
+	if (this == &rhs)
+		return (*this);
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- destructor
+
+Texture::~Texture(void) {}
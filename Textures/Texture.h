@@ -0,0 +1,34 @@
+#ifndef __TEXTURE__
+#define __TEXTURE__
+
+// This file contains the declaration of the base class Texture, a colour that varies over the
+// surfaces it is applied to, which materials look up at each hit (see Lambertian::set_cd)
+
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/ShadeRec.h"
+
+//------------------------------------------------------------------------------------ class Texture
+
+class Texture {
+	public:
+
+		Texture(void);
+
+		Texture(const Texture& texture);
+
+		virtual Texture*
+		clone(void) const = 0;
+
+		virtual
+		~Texture(void);
+
+		virtual RGBColor						// the colour at the hit; safe to call from any thread
+		get_color(const ShadeRec& sr) const = 0;
+
+	protected:
+
+		Texture&
+		operator= (const Texture& rhs);
+};
+
+#endif
@@ -0,0 +1,267 @@
+// This file contains the definition of the class TextureFile
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "TextureFile.h"
+
+static const char 	kMagic[4] 		= {'R', 'T', 'T', 'X'};
+static const int 	kHeaderBytes 	= 24;
+
+
+// ----------------------------------------------------------------------------- put_uint32
+
+static void
+put_uint32(uint8_t* bytes, const uint32_t value) {
+	bytes[0] = value & 0xff;
+	bytes[1] = (value >> 8) & 0xff;
+	bytes[2] = (value >> 16) & 0xff;
+	bytes[3] = value >> 24;
+}
+
+
+// ----------------------------------------------------------------------------- get_uint32
+
+static uint32_t
+get_uint32(const uint8_t* bytes) {
+	return (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24));
+}
+
+
+// ----------------------------------------------------------------------------- read_ppm_token
+// the next whitespace separated token of a PPM header, skipping comments
+
+static std::string
+read_ppm_token(std::istream& in) {
+	std::string token;
+	int 		c;
+
+	while ((c = in.get()) != EOF) {
+		if (c == '#')
+			while ((c = in.get()) != EOF && c != '\n')
+				;
+		else if (isspace(c)) {
+			if (!token.empty())
+				break;
+		}
+		else
+			token += (char)c;
+	}
+
+	return (token);
+}
+
+
+// ----------------------------------------------------------------------------- read_ppm
+// reads a P3 or P6 image with a maximum value up to 255 into rows of r, g, b, 0 texels from the top
+
+static bool
+read_ppm(const std::string& file_name, int& width, int& height, std::vector<uint8_t>& texels) {
+	std::ifstream in(file_name, std::ios::binary);
+
+	if (!in)
+		return (false);
+
+	std::string format 	= read_ppm_token(in);
+	width 				= atoi(read_ppm_token(in).c_str());
+	height 				= atoi(read_ppm_token(in).c_str());
+	int max_value 		= atoi(read_ppm_token(in).c_str());
+
+	if ((format != "P3" && format != "P6") || width <= 0 || height <= 0 || max_value <= 0 || max_value > 255)
+		return (false);
+
+	texels.assign((std::size_t)width * height * 4, 0);
+
+	for (std::size_t j = 0; j < (std::size_t)width * height; j++)
+		for (int k = 0; k < 3; k++) {
+			int value;
+
+			if (format == "P6")
+				value = in.get();
+			else
+				in >> value;
+
+			if (!in)
+				return (false);
+
+			texels[4 * j + k] = (uint8_t)(std::min(value, max_value) * 255 / max_value);
+		}
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- downsample
+// the next MIP level: every texel is the average of the 2 by 2 texels above it, the last row or
+// column of an odd sized level being folded into the one before
+
+static void
+downsample(const std::vector<uint8_t>& texels, const int width, const int height, std::vector<uint8_t>& next,
+		   const int next_width, const int next_height) {
+	next.assign((std::size_t)next_width * next_height * 4, 0);
+
+	for (int y = 0; y < next_height; y++)
+		for (int x = 0; x < next_width; x++) {
+			int x1 = std::min(2 * x + 1, width - 1);
+			int y1 = std::min(2 * y + 1, height - 1);
+
+			for (int k = 0; k < 3; k++) {
+				int sum = texels[((std::size_t)2 * y * width + 2 * x) * 4 + k]
+						+ texels[((std::size_t)2 * y * width + x1) * 4 + k]
+						+ texels[((std::size_t)y1 * width + 2 * x) * 4 + k]
+						+ texels[((std::size_t)y1 * width + x1) * 4 + k];
+
+				next[((std::size_t)y * next_width + x) * 4 + k] = (uint8_t)((sum + 2) / 4);
+			}
+		}
+}
+
+
+// ----------------------------------------------------------------------------- default constructor
+
+TextureFile::TextureFile(void)
+	: 	fd(-1),
+		tile_size(0)
+{}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+TextureFile::~TextureFile(void) {
+	if (fd >= 0)
+		close(fd);
+}
+
+
+// ----------------------------------------------------------------------------- open
+
+bool
+TextureFile::open(const std::string& file_name) {
+	uint8_t header[kHeaderBytes];
+	int 	file = ::open(file_name.c_str(), O_RDONLY);
+
+	if (file < 0)
+		return (false);
+
+	if (pread(file, header, kHeaderBytes, 0) != kHeaderBytes || memcmp(header, kMagic, 4)
+		|| get_uint32(header + 4) != kVersion) {
+		close(file);
+		return (false);
+	}
+
+	int width 		= get_uint32(header + 8);
+	int height 		= get_uint32(header + 12);
+	int num_levels 	= get_uint32(header + 16);
+	int size 		= get_uint32(header + 20);
+
+	if (width <= 0 || height <= 0 || size <= 0 || num_levels <= 0 || num_levels > 32) {
+		close(file);
+		return (false);
+	}
+
+	if (fd >= 0)
+		close(fd);
+
+	fd 			= file;
+	tile_size 	= size;
+	levels.clear();
+
+	std::size_t offset = kHeaderBytes;
+
+	for (int j = 0; j < num_levels; j++) {
+		Level level = {width, height, (width + size - 1) / size, (height + size - 1) / size, offset};
+
+		levels.push_back(level);
+		offset 	+= (std::size_t)level.tiles_across * level.tiles_down * tile_bytes();
+		width 	= std::max(1, width / 2);
+		height 	= std::max(1, height / 2);
+	}
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- read_tile
+
+bool
+TextureFile::read_tile(const int level, const int tx, const int ty, uint32_t* texels) const {
+	const Level& 	l 		= levels[level];
+	std::size_t 	bytes 	= tile_bytes();
+	off_t 			offset 	= l.offset + ((std::size_t)ty * l.tiles_across + tx) * bytes;
+
+	if (pread(fd, texels, bytes, offset) != (ssize_t)bytes)
+		return (false);
+
+	const uint8_t* rgba = (const uint8_t*)texels;
+
+	for (int j = 0; j < tile_size * tile_size; j++)
+		texels[j] = get_uint32(rgba + 4 * j) & 0xffffff;
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- convert
+
+bool
+TextureFile::convert(const std::string& image_file, const std::string& texture_file, const int tile_size) {
+	int 					width, height;
+	std::vector<uint8_t> 	texels;
+
+	if (tile_size <= 0 || !read_ppm(image_file, width, height, texels))
+		return (false);
+
+	std::ofstream out(texture_file, std::ios::binary | std::ios::trunc);
+
+	int num_levels = 1;
+
+	while (width >> (num_levels - 1) > 1 || height >> (num_levels - 1) > 1)
+		num_levels++;
+
+	uint8_t header[kHeaderBytes];
+
+	memcpy(header, kMagic, 4);
+	put_uint32(header + 4, kVersion);
+	put_uint32(header + 8, width);
+	put_uint32(header + 12, height);
+	put_uint32(header + 16, num_levels);
+	put_uint32(header + 20, tile_size);
+	out.write((const char*)header, kHeaderBytes);
+
+	std::vector<uint8_t> tile((std::size_t)tile_size * tile_size * kTexelBytes);
+	std::vector<uint8_t> next;
+
+	for (int level = 0; level < num_levels; level++) {
+		for (int ty = 0; ty * tile_size < height; ty++)
+			for (int tx = 0; tx * tile_size < width; tx++) {
+				for (int y = 0; y < tile_size; y++)
+					for (int x = 0; x < tile_size; x++) {
+						int sx = std::min(tx * tile_size + x, width - 1);
+						int sy = std::min(ty * tile_size + y, height - 1);
+
+						memcpy(&tile[((std::size_t)y * tile_size + x) * kTexelBytes],
+							   &texels[((std::size_t)sy * width + sx) * 4], kTexelBytes);
+					}
+
+				out.write((const char*)tile.data(), tile.size());
+			}
+
+		int next_width 	= std::max(1, width / 2);
+		int next_height = std::max(1, height / 2);
+
+		downsample(texels, width, height, next, next_width, next_height);
+		texels.swap(next);
+		width 	= next_width;
+		height 	= next_height;
+	}
+
+	out.close();
+
+	return (!out.fail());
+}
@@ -0,0 +1,118 @@
+#ifndef __TEXTURE_FILE__
+#define __TEXTURE_FILE__
+
+// This file contains the declaration of the class TextureFile, an image texture on disk in the tiled,
+// MIP-mapped format that TileCache reads
+// A texture file holds the image and its MIP levels, each half the width and height of the one before,
+// rounded down, to 1 by 1. Every level is cut into square tiles of tile_size texels, which are stored
+// one after another, level by level, in rows from the top left; the tiles on the right and bottom
+// edges are padded by repeating the level's last column and row, so every tile is the same size and
+// any one can be read with a single read at an offset computed from the header.
+// The header is the magic "RTTX", then the version, width, height, tile size and number of levels as
+// 32-bit little endian integers. A texel is 4 bytes, r, g and b from 0 to 255 and one of padding, which
+// read_tile packs into a 32-bit word as r | g << 8 | b << 16.
+// convert makes a texture file from a PPM image. It holds the image and its levels in memory while it
+// writes them, but rendering only ever reads the tiles it needs.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------------ class TextureFile
+
+class TextureFile {
+	public:
+
+		TextureFile(void);
+
+		TextureFile(const TextureFile& file) = delete;
+
+		TextureFile&
+		operator= (const TextureFile& rhs) = delete;
+
+		~TextureFile(void);
+
+		bool									// false if the file can't be read or isn't a texture file
+		open(const std::string& file_name);
+
+		bool									// reads the tile of level in column tx and row ty; safe to call from any thread
+		read_tile(const int level, const int tx, const int ty, uint32_t* texels) const;
+
+		int
+		get_num_levels(void) const;
+
+		int
+		get_width(const int level) const;
+
+		int
+		get_height(const int level) const;
+
+		int
+		get_tile_size(void) const;
+
+		std::size_t								// of one tile, on disk and in a cache
+		tile_bytes(void) const;
+
+		static bool								// false if the image can't be read or the texture file written
+		convert(const std::string& image_file, const std::string& texture_file, const int tile_size = 64);
+
+	private:
+
+		struct Level {
+			int			width;
+			int			height;
+			int			tiles_across;
+			int			tiles_down;
+			std::size_t	offset;					// of the level's first tile in the file
+		};
+
+		static constexpr int		kVersion 	= 1;
+		static constexpr int		kTexelBytes = 4;
+
+		int					fd;					// -1 until open succeeds
+		int					tile_size;
+		std::vector<Level>	levels;
+};
+
+
+// ----------------------------------------------------------------------------- get_num_levels
+
+inline int
+TextureFile::get_num_levels(void) const {
+	return ((int)levels.size());
+}
+
+
+// ----------------------------------------------------------------------------- get_width
+
+inline int
+TextureFile::get_width(const int level) const {
+	return (levels[level].width);
+}
+
+
+// ----------------------------------------------------------------------------- get_height
+
+inline int
+TextureFile::get_height(const int level) const {
+	return (levels[level].height);
+}
+
+
+// ----------------------------------------------------------------------------- get_tile_size
+
+inline int
+TextureFile::get_tile_size(void) const {
+	return (tile_size);
+}
+
+
+// ----------------------------------------------------------------------------- tile_bytes
+
+inline std::size_t
+TextureFile::tile_bytes(void) const {
+	return ((std::size_t)tile_size * tile_size * kTexelBytes);
+}
+
+#endif
@@ -0,0 +1,254 @@
+// This file contains the definition of the class TileCache
+
+#include <algorithm>
+
+#include "TileCache.h"
+
+static std::atomic<int> next_shard(0);
+
+
+// ----------------------------------------------------------------------------- tile_key
+// 16 bits of texture id, 6 of level and 21 each of tile row and column
+
+static uint64_t
+tile_key(const int id, const int level, const int tx, const int ty) {
+	return (((uint64_t)id << 48) | ((uint64_t)level << 42) | ((uint64_t)ty << 21) | (uint64_t)tx);
+}
+
+
+// ----------------------------------------------------------------------------- hash
+// the finalizer of splitmix64, so that neighbouring tiles land in different sets
+
+static uint64_t
+hash(uint64_t key) {
+	key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+	key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+
+	return (key ^ (key >> 31));
+}
+
+
+// ----------------------------------------------------------------------------- constructor
+
+TileCache::TileCache(const std::size_t capacity, const int _tile_size)
+	: 	tile_size(_tile_size),
+		tile_texels(_tile_size * _tile_size),
+		num_sets(std::max(1, (int)(capacity / (_tile_size * _tile_size * sizeof(uint32_t) * kWays)))),
+		slots(new Slot[num_sets * kWays]),
+		texels(new std::atomic<uint32_t>[(std::size_t)num_sets * kWays * tile_texels]),
+		clock(0)
+{
+	for (int j = 0; j < num_sets * kWays; j++) {
+		slots[j].version.store(0, std::memory_order_relaxed);
+		slots[j].last_use.store(0, std::memory_order_relaxed);
+		slots[j].key.store(kEmpty, std::memory_order_relaxed);
+	}
+
+	reset_counts();
+}
+
+
+// ----------------------------------------------------------------------------- destructor
+
+TileCache::~TileCache(void) {}
+
+
+// ----------------------------------------------------------------------------- open
+
+int
+TileCache::open(const std::string& file_name) {
+	std::unique_ptr<TextureFile> file(new TextureFile);
+
+	if (!file->open(file_name) || file->get_tile_size() != tile_size || textures.size() >= 0xffff)
+		return (-1);
+
+	textures.push_back(std::move(file));
+
+	return ((int)textures.size() - 1);
+}
+
+
+// ----------------------------------------------------------------------------- texel
+// a slot is only trusted if its version was even and unchanged around the reads of its key and texel
+
+uint32_t
+TileCache::texel(const int id, const int level, const int x, const int y) {
+	int 		tx 		= x / tile_size;
+	int 		ty 		= y / tile_size;
+	int 		offset 	= (y - ty * tile_size) * tile_size + (x - tx * tile_size);
+	uint64_t 	key 	= tile_key(id, level, tx, ty);
+	int 		first 	= (int)(hash(key) % num_sets) * kWays;
+
+	shard().lookups.fetch_add(1, std::memory_order_relaxed);
+
+	for (int j = first; j < first + kWays; j++) {
+		Slot& 		slot 	= slots[j];
+		uint32_t 	version = slot.version.load(std::memory_order_acquire);
+
+		if ((version & 1) || slot.key.load(std::memory_order_relaxed) != key)
+			continue;
+
+		uint32_t value = texels[(std::size_t)j * tile_texels + offset].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (slot.version.load(std::memory_order_relaxed) != version)
+			continue;
+
+		uint32_t now = clock.load(std::memory_order_relaxed);
+
+		if (slot.last_use.load(std::memory_order_relaxed) != now)
+			slot.last_use.store(now, std::memory_order_relaxed);
+
+		return (value);
+	}
+
+	return (miss(first, key, id, level, tx, ty, offset));
+}
+
+
+// ----------------------------------------------------------------------------- miss
+// The victim is an empty slot of the set if there is one, and otherwise the one used longest ago;
+// another thread may claim it first, in which case the set is looked at again. If another thread has
+// cached the tile in the meantime, or every slot of the set is being written, the tile is used from
+// the thread's buffer without being cached.
+// A tile that can't be read is black, and isn't cached.
+
+uint32_t
+TileCache::miss(const int first, const uint64_t key, const int id, const int level, const int tx, const int ty,
+				const int offset) {
+	thread_local std::vector<uint32_t> buffer;
+
+	Counts& c = shard();
+
+	buffer.resize(tile_texels);
+	c.misses.fetch_add(1, std::memory_order_relaxed);
+
+	if (!textures[id]->read_tile(level, tx, ty, buffer.data()))
+		return (0);
+
+	c.bytes_read.fetch_add(textures[id]->tile_bytes(), std::memory_order_relaxed);
+
+	uint32_t now = clock.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	for (int attempt = 0; attempt < kWays; attempt++) {
+		int 		victim 			= -1;
+		uint32_t 	victim_version 	= 0;
+		uint32_t 	oldest 			= 0;
+
+		for (int j = first; j < first + kWays; j++) {
+			uint32_t version = slots[j].version.load(std::memory_order_relaxed);
+
+			if (version & 1)
+				continue;
+
+			uint64_t slot_key = slots[j].key.load(std::memory_order_relaxed);
+
+			if (slot_key == key)
+				return (buffer[offset]);
+
+			uint32_t age = slot_key == kEmpty ? ~(uint32_t)0 : now - slots[j].last_use.load(std::memory_order_relaxed);
+
+			if (victim < 0 || age > oldest) {
+				victim 			= j;
+				victim_version 	= version;
+				oldest 			= age;
+			}
+		}
+
+		if (victim < 0)
+			break;
+
+		Slot& slot = slots[victim];
+
+		if (!slot.version.compare_exchange_strong(victim_version, victim_version + 1, std::memory_order_acquire))
+			continue;
+
+		std::atomic_thread_fence(std::memory_order_release);
+
+		std::atomic<uint32_t>* data = &texels[(std::size_t)victim * tile_texels];
+
+		slot.key.store(key, std::memory_order_relaxed);
+		slot.last_use.store(now, std::memory_order_relaxed);
+
+		for (int j = 0; j < tile_texels; j++)
+			data[j].store(buffer[j], std::memory_order_relaxed);
+
+		slot.version.store(victim_version + 2, std::memory_order_release);
+
+		break;
+	}
+
+	return (buffer[offset]);
+}
+
+
+// ----------------------------------------------------------------------------- shard
+
+TileCache::Counts&
+TileCache::shard(void) {
+	thread_local int index = next_shard.fetch_add(1) % kNumShards;
+
+	return (counts[index]);
+}
+
+
+// ----------------------------------------------------------------------------- get_lookups
+
+uint64_t
+TileCache::get_lookups(void) const {
+	uint64_t total = 0;
+
+	for (const Counts& c : counts)
+		total += c.lookups.load(std::memory_order_relaxed);
+
+	return (total);
+}
+
+
+// ----------------------------------------------------------------------------- get_misses
+
+uint64_t
+TileCache::get_misses(void) const {
+	uint64_t total = 0;
+
+	for (const Counts& c : counts)
+		total += c.misses.load(std::memory_order_relaxed);
+
+	return (total);
+}
+
+
+// ----------------------------------------------------------------------------- get_bytes_read
+
+uint64_t
+TileCache::get_bytes_read(void) const {
+	uint64_t total = 0;
+
+	for (const Counts& c : counts)
+		total += c.bytes_read.load(std::memory_order_relaxed);
+
+	return (total);
+}
+
+
+// ----------------------------------------------------------------------------- hit_rate
+
+double
+TileCache::hit_rate(void) const {
+	uint64_t lookups = get_lookups();
+
+	return (lookups ? 1.0 - (double)get_misses() / lookups : 0.0);
+}
+
+
+// ----------------------------------------------------------------------------- reset_counts
+
+void
+TileCache::reset_counts(void) {
+	for (Counts& c : counts) {
+		c.lookups.store(0, std::memory_order_relaxed);
+		c.misses.store(0, std::memory_order_relaxed);
+		c.bytes_read.store(0, std::memory_order_relaxed);
+	}
+}
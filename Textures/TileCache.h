@@ -0,0 +1,123 @@
+#ifndef __TILE_CACHE__
+#define __TILE_CACHE__
+
+// This file contains the declaration of the class TileCache, a fixed-size cache of the tiles of
+// texture files (Textures/TextureFile.h), shared by all the render threads without locks
+// The cache holds capacity / tile_bytes tiles, in sets of kWays slots; a tile can only be kept in the
+// set its key hashes to. A lookup that misses reads the tile from its file into a buffer of the
+// thread's own, then replaces the least recently used tile of the set, so the textures can be much
+// larger than the memory the cache takes.
+// Each slot is guarded by a version that is odd while the slot is being written, as in a seqlock: a
+// reader checks the slot's key and reads its texel between two reads of the version, and only trusts
+// the texel if the version didn't change, so lookups that hit write nothing to shared memory but
+// their slot's last use, and that only when a miss has happened since the slot was last used. A
+// writer claims its slot by making the version odd with a compare and swap; the slot's data are
+// atomics, so the race between a writer and a reader is well defined.
+// Recency is counted in misses: a slot's last use is the miss count when it was last hit or filled,
+// which orders the slots as LRU would without every hit advancing a shared clock.
+// The counts of lookups, misses and bytes read are kept per thread, in padded shards, and summed when
+// they are read.
+// Textures are opened before rendering starts; open isn't safe while other threads look up texels.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TextureFile.h"
+
+//------------------------------------------------------------------------------------ class TileCache
+
+class TileCache {
+	public:
+
+		TileCache(const std::size_t capacity, const int tile_size = 64);	// capacity in bytes
+
+		TileCache(const TileCache& cache) = delete;
+
+		TileCache&
+		operator= (const TileCache& rhs) = delete;
+
+		~TileCache(void);
+
+		int										// the texture's id, or -1 if the file can't be opened or has another tile size
+		open(const std::string& file_name);
+
+		const TextureFile&
+		get_texture(const int id) const;
+
+		uint32_t								// the texel at column x and row y, from the top left, of a level, packed as r | g << 8 | b << 16
+		texel(const int id, const int level, const int x, const int y);
+
+		std::size_t								// bytes of tiles the cache can hold
+		get_capacity(void) const;
+
+		uint64_t
+		get_lookups(void) const;
+
+		uint64_t
+		get_misses(void) const;
+
+		uint64_t								// of tiles, read from the texture files
+		get_bytes_read(void) const;
+
+		double									// the fraction of lookups that hit, 0 before any
+		hit_rate(void) const;
+
+		void
+		reset_counts(void);
+
+	private:
+
+		struct Slot {
+			std::atomic<uint32_t>	version;		// odd while the slot is written
+			std::atomic<uint32_t>	last_use;		// the miss count when it was last used
+			std::atomic<uint64_t>	key;			// of the tile it holds, or kEmpty
+		};
+
+		struct alignas(64) Counts {
+			std::atomic<uint64_t>	lookups;
+			std::atomic<uint64_t>	misses;
+			std::atomic<uint64_t>	bytes_read;
+		};
+
+		static constexpr int		kWays 		= 8;
+		static constexpr int		kNumShards 	= 64;
+		static constexpr uint64_t	kEmpty 		= ~(uint64_t)0;
+
+		int												tile_size;
+		int												tile_texels;
+		int												num_sets;
+		std::unique_ptr<Slot[]>							slots;			// num_sets * kWays, set by set
+		std::unique_ptr<std::atomic<uint32_t>[]>		texels;			// tile_texels for each slot
+		std::atomic<uint32_t>							clock;			// the number of misses
+		std::vector<std::unique_ptr<TextureFile>>		textures;
+		Counts											counts[kNumShards];
+
+		Counts&									// the calling thread's shard
+		shard(void);
+
+		uint32_t								// reads the tile into the set from slot first on, and returns the texel at offset
+		miss(const int first, const uint64_t key, const int id, const int level, const int tx, const int ty,
+			 const int offset);
+};
+
+
+// ----------------------------------------------------------------------------- get_texture
+
+inline const TextureFile&
+TileCache::get_texture(const int id) const {
+	return (*textures[id]);
+}
+
+
+// ----------------------------------------------------------------------------- get_capacity
+
+inline std::size_t
+TileCache::get_capacity(void) const {
+	return ((std::size_t)num_sets * kWays * tile_texels * sizeof(uint32_t));
+}
+
+#endif
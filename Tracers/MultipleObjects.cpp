@@ -32,3 +32,10 @@ MultipleObjects::trace_ray(const Ray& ray) const {
 		return (world_ptr->background_color);
 }
 
+
+// -------------------------------------------------------------------- shades_materials
+
+bool
+MultipleObjects::shades_materials(void) const {
+	return (false);
+}
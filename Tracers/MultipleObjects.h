@@ -15,6 +15,9 @@ class MultipleObjects: public Tracer {
 						
 		virtual RGBColor	
 		trace_ray(const Ray& ray) const;
+
+		virtual bool									// the colour comes from the objects, not their materials
+		shades_materials(void) const;
 };
 
 #endif
@@ -0,0 +1,125 @@
+#include <algorithm>
+
+#include "PathTrace.h"
+#include "../World/World.h"
+#include "../Utilities/ShadeRec.h"
+#include "../Utilities/Maths.h"
+#include "../Materials/Material.h"
+#include "../Utilities/Stats.h"
+
+// -------------------------------------------------------------------- default constructor
+
+PathTrace::PathTrace(void)
+	: 	Tracer(),
+		max_depth(64),
+		rr_depth(3)
+{}
+
+
+// -------------------------------------------------------------------- constructor
+		
+PathTrace::PathTrace(World* _worldPtr)
+	: 	Tracer(_worldPtr),
+		max_depth(64),
+		rr_depth(3)
+{}
+
+
+// -------------------------------------------------------------------- destructor
+
+PathTrace::~PathTrace(void) {}
+
+
+// -------------------------------------------------------------------- trace_ray
+
+RGBColor	
+PathTrace::trace_ray(const Ray& ray) const {
+	return (trace_path(ray, white, true, 0));
+}
+
+
+// -------------------------------------------------------------------- trace_ray
+
+RGBColor	
+PathTrace::trace_ray(const Ray ray, const int depth) const {
+	return (trace_path(ray, white, true, depth));
+}
+
+
+// -------------------------------------------------------------------- trace_ray
+
+RGBColor	
+PathTrace::trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const {
+	return (trace_path(ray, throughput, true, depth));
+}
+
+
+// -------------------------------------------------------------------- trace_path
+// the background is light that the lights' samples don't include, so it is always added
+// only the camera rays are timed as shading, because the time of the secondary rays is inside theirs
+
+RGBColor	
+PathTrace::trace_path(const Ray ray, const RGBColor& throughput, const bool emission, const int depth) const {
+	float survival = 1.0;
+
+	if (depth > 0) {
+		if (depth > max_depth) {
+			STATS_INC(STAT_DEPTH_CUTOFFS);
+			return (black);
+		}
+
+		if (depth >= rr_depth) {
+			survival = std::min(1.0f, std::max(throughput.r, std::max(throughput.g, throughput.b)));
+
+			if (survival < 1.0 && random_float() >= survival) {
+				STATS_INC(STAT_ROULETTE_KILLS);
+				return (black);
+			}
+		}
+
+		STATS_INC(STAT_SECONDARY_RAYS);
+	}
+
+	ShadeRec sr(world_ptr->hit_objects(ray));
+		
+	if (!sr.hit_an_object)
+		return (world_ptr->background_color / survival);
+
+	sr.depth 		= depth;
+	sr.ray 			= ray;
+	sr.throughput 	= throughput / survival;
+	STATS_INC(STAT_SHADE_CALLS);
+
+	RGBColor L;
+
+	if (emission && -sr.normal * ray.d > 0.0)
+		L = sr.material_ptr->get_Le(sr);
+
+	if (depth == 0) {
+		STATS_TIMER(STAT_TIME_SHADE);
+		L += sr.material_ptr->path_shade(sr);
+	}
+	else
+		L += sr.material_ptr->path_shade(sr);
+
+	return (L / survival);
+}
+
+
+// -------------------------------------------------------------------- shade_hit
+// as trace_path shades a camera ray's hit
+
+RGBColor
+PathTrace::shade_hit(ShadeRec& sr) const {
+	RGBColor L;
+
+	STATS_INC(STAT_SHADE_CALLS);
+
+	if (-sr.normal * sr.ray.d > 0.0)
+		L = sr.material_ptr->get_Le(sr);
+
+	STATS_TIMER(STAT_TIME_SHADE);
+	L += sr.material_ptr->path_shade(sr);
+
+	return (L);
+}
@@ -0,0 +1,69 @@
+#ifndef __PATH_TRACE__
+#define __PATH_TRACE__
+
+// This file contains the declaration of the class PathTrace, the unidirectional path tracer
+// Every hit calls the material's path_shade, which samples the lights directly and continues the path
+// in one direction sampled from its BRDF, through trace_path at sr.depth + 1. The lights' samples and
+// the BRDF's are combined with multiple importance sampling (Materials/Matte.cpp), so a path only adds
+// the emission it hits when the last hit didn't sample the lights: on camera rays and after mirror
+// reflection and refraction.
+// Past rr_depth, a path survives with probability p, the largest component of its throughput (at most
+// 1), and its radiance is divided by p, which ends dim paths early without biasing the image. max_depth
+// is only a safety limit, for scenes whose materials reflect all the light.
+
+#include "Tracer.h"
+
+class PathTrace: public Tracer {
+	public:
+		
+		PathTrace(void);
+		
+		PathTrace(World* _worldPtr);
+				
+		virtual											
+		~PathTrace(void);
+
+		void
+		set_max_depth(const int depth);
+
+		void											// the first depth at which paths can be ended by Russian roulette
+		set_rr_depth(const int depth);
+
+		virtual RGBColor	
+		trace_ray(const Ray& ray) const;
+
+		virtual RGBColor	
+		trace_ray(const Ray ray, const int depth) const;
+
+		virtual RGBColor	
+		trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const;
+
+		virtual RGBColor	
+		trace_path(const Ray ray, const RGBColor& throughput, const bool emission, const int depth) const;
+
+		virtual RGBColor
+		shade_hit(ShadeRec& sr) const;
+
+	private:
+
+		int		max_depth;
+		int		rr_depth;
+};
+
+
+// -------------------------------------------------------------------- set_max_depth
+
+inline void
+PathTrace::set_max_depth(const int depth) {
+	max_depth = depth;
+}
+
+
+// -------------------------------------------------------------------- set_rr_depth
+
+inline void
+PathTrace::set_rr_depth(const int depth) {
+	rr_depth = depth;
+}
+
+#endif
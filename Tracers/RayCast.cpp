@@ -2,6 +2,7 @@
 #include "../World/World.h"
 #include "../Utilities/ShadeRec.h"
 #include "../Materials/Material.h"
+#include "../Utilities/Stats.h"
 
 // -------------------------------------------------------------------- default constructor
 
@@ -30,6 +31,8 @@ RayCast::trace_ray(const Ray& ray) const {
 		
 	if (sr.hit_an_object) {
 		sr.ray = ray;			// used for specular shading
+		STATS_TIMER(STAT_TIME_SHADE);
+		STATS_INC(STAT_SHADE_CALLS);
 		return (sr.material_ptr->shade(sr));
 	}   
 	else
@@ -46,6 +49,8 @@ RayCast::trace_ray(const Ray ray, const int depth) const {
 		
 	if (sr.hit_an_object) {
 		sr.ray = ray;			// used for specular shading
+		STATS_TIMER(STAT_TIME_SHADE);
+		STATS_INC(STAT_SHADE_CALLS);
 		return (sr.material_ptr->shade(sr));
 	}   
 	else
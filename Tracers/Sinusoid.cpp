@@ -29,3 +29,8 @@ RGBColor Sinusoid::trace_ray(const Ray& ray) const {
 }
 
 
+// -------------------------------------------------------------------- shades_materials
+
+bool Sinusoid::shades_materials() const {
+    return false;
+}
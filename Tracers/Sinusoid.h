@@ -11,6 +11,7 @@ public:
 
     ~Sinusoid() override;
     virtual RGBColor trace_ray(const Ray& ray) const;
+    bool shades_materials() const override;     // the colour doesn't come from a material
 };
 
 
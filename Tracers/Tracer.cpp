@@ -1,4 +1,7 @@
 #include "Tracer.h"
+#include "../Materials/Material.h"
+#include "../Utilities/ShadeRec.h"
+#include "../Utilities/Stats.h"
 
 // -------------------------------------------------------------------- default constructor
 
@@ -39,4 +42,38 @@ Tracer::trace_ray(const Ray ray, const int depth) const {
 }
 
 
+// -------------------------------------------------------------------- trace_ray
+// tracers that don't terminate rays by their throughput ignore it
+
+RGBColor	
+Tracer::trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const {
+	return (trace_ray(ray, depth));
+}
+
+
+// -------------------------------------------------------------------- trace_path
+
+RGBColor	
+Tracer::trace_path(const Ray ray, const RGBColor& throughput, const bool emission, const int depth) const {
+	return (trace_ray(ray, throughput, depth));
+}
 
+
+// -------------------------------------------------------------------- shade_hit
+// as the ray casting and Whitted tracers shade camera rays
+
+RGBColor
+Tracer::shade_hit(ShadeRec& sr) const {
+	STATS_INC(STAT_SHADE_CALLS);
+	STATS_TIMER(STAT_TIME_SHADE);
+
+	return (sr.material_ptr->shade(sr));
+}
+
+
+// -------------------------------------------------------------------- shades_materials
+
+bool
+Tracer::shades_materials(void) const {
+	return (true);
+}
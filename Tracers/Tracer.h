@@ -11,6 +11,7 @@
 #include "../Utilities/RGBColor.h"
 
 class World;
+class ShadeRec;
 
 class Tracer {
 	public:
@@ -27,6 +28,18 @@ class Tracer {
 
 		virtual RGBColor	
 		trace_ray(const Ray ray, const int depth) const;
+
+		virtual RGBColor								// throughput is the weight the caller gives the result
+		trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const;
+
+		virtual RGBColor								// for path tracing; the emission at the hit is only added if
+		trace_path(const Ray ray, const RGBColor& throughput, const bool emission, const int depth) const;	// the lights weren't sampled at the last one
+
+		virtual RGBColor								// what trace_ray returns for a camera ray that hits, given the hit, with sr.ray set;
+		shade_hit(ShadeRec& sr) const;					// for World/GBuffer.h
+
+		virtual bool									// does trace_ray shade hits through their materials, as shade_hit does?
+		shades_materials(void) const;
 				
 	protected:
 	
@@ -0,0 +1,84 @@
+#include <algorithm>
+
+#include "Whitted.h"
+#include "../World/World.h"
+#include "../Utilities/ShadeRec.h"
+#include "../Materials/Material.h"
+#include "../Utilities/Stats.h"
+
+// -------------------------------------------------------------------- default constructor
+
+Whitted::Whitted(void)
+	: 	Tracer(),
+		max_depth(5),
+		min_throughput(0.01)
+{}
+
+
+// -------------------------------------------------------------------- constructor
+		
+Whitted::Whitted(World* _worldPtr)
+	: 	Tracer(_worldPtr),
+		max_depth(5),
+		min_throughput(0.01)
+{}
+
+
+// -------------------------------------------------------------------- destructor
+
+Whitted::~Whitted(void) {}
+
+
+// -------------------------------------------------------------------- trace_ray
+
+RGBColor	
+Whitted::trace_ray(const Ray& ray) const {
+	return (trace_ray(ray, white, 0));
+}
+
+
+// -------------------------------------------------------------------- trace_ray
+
+RGBColor	
+Whitted::trace_ray(const Ray ray, const int depth) const {
+	return (trace_ray(ray, white, depth));
+}
+
+
+// -------------------------------------------------------------------- trace_ray
+// only the camera rays are timed as shading, because the time of the secondary rays is inside theirs
+
+RGBColor	
+Whitted::trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const {
+	if (depth > 0) {
+		if (depth > max_depth) {
+			STATS_INC(STAT_DEPTH_CUTOFFS);
+			return (black);
+		}
+
+		if (std::max(throughput.r, std::max(throughput.g, throughput.b)) < min_throughput) {
+			STATS_INC(STAT_THROUGHPUT_CUTOFFS);
+			return (black);
+		}
+
+		STATS_INC(STAT_SECONDARY_RAYS);
+	}
+
+	ShadeRec sr(world_ptr->hit_objects(ray));
+		
+	if (sr.hit_an_object) {
+		sr.depth 		= depth;
+		sr.ray 			= ray;
+		sr.throughput 	= throughput;
+		STATS_INC(STAT_SHADE_CALLS);
+
+		if (depth == 0) {
+			STATS_TIMER(STAT_TIME_SHADE);
+			return (sr.material_ptr->shade(sr));
+		}
+
+		return (sr.material_ptr->shade(sr));
+	}   
+	else
+		return (world_ptr->background_color);
+}
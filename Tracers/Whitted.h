@@ -0,0 +1,61 @@
+#ifndef __WHITTED__
+#define __WHITTED__
+
+// This file contains the declaration of the class Whitted, the recursive tracer for mirror reflection
+// and transparency
+// The materials trace their reflected and transmitted rays through the world's tracer at sr.depth + 1,
+// passing the throughput of the new ray: sr.throughput times the weight of the ray in the material's
+// shading. A ray is not traced, and contributes black, if its depth is past max_depth or if none of
+// its throughput's components reaches min_throughput, because it can't change the pixel by much.
+// Secondary rays go through World::hit_objects, as primary rays do.
+
+#include "Tracer.h"
+
+class Whitted: public Tracer {
+	public:
+		
+		Whitted(void);
+		
+		Whitted(World* _worldPtr);
+				
+		virtual											
+		~Whitted(void);
+
+		void											// the depth of the deepest ray that is traced; 0 is ray casting
+		set_max_depth(const int depth);
+
+		void
+		set_min_throughput(const float t);
+
+		virtual RGBColor	
+		trace_ray(const Ray& ray) const;
+
+		virtual RGBColor	
+		trace_ray(const Ray ray, const int depth) const;
+
+		virtual RGBColor	
+		trace_ray(const Ray ray, const RGBColor& throughput, const int depth) const;
+
+	private:
+
+		int		max_depth;
+		float	min_throughput;
+};
+
+
+// -------------------------------------------------------------------- set_max_depth
+
+inline void
+Whitted::set_max_depth(const int depth) {
+	max_depth = depth;
+}
+
+
+// -------------------------------------------------------------------- set_min_throughput
+
+inline void
+Whitted::set_min_throughput(const float t) {
+	min_throughput = t;
+}
+
+#endif
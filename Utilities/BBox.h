@@ -0,0 +1,193 @@
+#ifndef __BBOX__
+#define __BBOX__
+
+// This file contains the declaration of the struct BBox, an axis-aligned bounding box, for the
+// object BVH (World/BVH.h)
+// The default box is empty: its minimum is above its maximum, so the union of it and any box is that
+// box, and no ray hits it.
+
+#include <algorithm>
+
+#include "Point3D.h"
+#include "Vector3D.h"
+#include "Ray.h"
+#include "Epsilon.h"
+#include "Constants.h"
+
+//----------------------------------------------------------------------------- struct BBox
+
+struct BBox {
+	Point3D		p_min, p_max;
+
+	BBox(void);
+
+	BBox(const Point3D& p_min, const Point3D& p_max);
+
+	Point3D
+	centroid(void) const;
+
+	double								// 0 for an empty box
+	surface_area(void) const;
+
+	bool								// inv_d holds the reciprocals of the ray direction's components
+	hit(const Ray& ray, const Vector3D& inv_d, const double t_max) const;
+
+	bool								// the box with f times delta_min and delta_max added to its corners
+	hit(const Ray& ray, const Vector3D& inv_d, const double t_max, const Vector3D& delta_min,
+		const Vector3D& delta_max, const double f) const;
+};
+
+
+// ---------------------------------------------------------------- default constructor
+
+inline
+BBox::BBox(void)
+	: 	p_min(kHugeValue),
+		p_max(-kHugeValue)
+{}
+
+
+// ---------------------------------------------------------------- constructor
+
+inline
+BBox::BBox(const Point3D& _p_min, const Point3D& _p_max)
+	: 	p_min(_p_min),
+		p_max(_p_max)
+{}
+
+
+// ---------------------------------------------------------------- centroid
+
+inline Point3D
+BBox::centroid(void) const {
+	return (Point3D(0.5 * (p_min.x + p_max.x), 0.5 * (p_min.y + p_max.y), 0.5 * (p_min.z + p_max.z)));
+}
+
+
+// ---------------------------------------------------------------- surface_area
+
+inline double
+BBox::surface_area(void) const {
+	if (p_min.x > p_max.x)
+		return (0.0);
+
+	double dx = p_max.x - p_min.x;
+	double dy = p_max.y - p_min.y;
+	double dz = p_max.z - p_min.z;
+
+	return (2.0 * (dx * dy + dy * dz + dz * dx));
+}
+
+
+// ---------------------------------------------------------------- hit
+// the slab test; the far distances are scaled up by the rounding error of their computation, so that
+// a ray that grazes the box isn't missed. A zero direction component gives infinite distances, which
+// the comparisons handle; for an origin exactly on that slab they are NaN, which std::max and std::min
+// ignore, so the slab doesn't cull the ray.
+
+inline bool
+BBox::hit(const Ray& ray, const Vector3D& inv_d, const double t_max) const {
+	const double 	scale 	= 1.0 + 2.0 * error_gamma<double>(3);
+	double 			t0 		= 0.0;
+	double 			t1 		= t_max;
+
+	double tx0 = (p_min.x - ray.o.x) * inv_d.x;
+	double tx1 = (p_max.x - ray.o.x) * inv_d.x;
+
+	if (tx0 > tx1)
+		std::swap(tx0, tx1);
+
+	t0 = std::max(t0, tx0);
+	t1 = std::min(t1, tx1 * scale);
+
+	double ty0 = (p_min.y - ray.o.y) * inv_d.y;
+	double ty1 = (p_max.y - ray.o.y) * inv_d.y;
+
+	if (ty0 > ty1)
+		std::swap(ty0, ty1);
+
+	t0 = std::max(t0, ty0);
+	t1 = std::min(t1, ty1 * scale);
+
+	double tz0 = (p_min.z - ray.o.z) * inv_d.z;
+	double tz1 = (p_max.z - ray.o.z) * inv_d.z;
+
+	if (tz0 > tz1)
+		std::swap(tz0, tz1);
+
+	t0 = std::max(t0, tz0);
+	t1 = std::min(t1, tz1 * scale);
+
+	return (t0 <= t1);
+}
+
+
+// ---------------------------------------------------------------- hit
+// the same test on a box that moves, for the BVH's nodes when objects move: the corners are moved
+// one axis at a time, rather than a moved box being made and tested
+
+inline bool
+BBox::hit(const Ray& ray, const Vector3D& inv_d, const double t_max, const Vector3D& delta_min,
+		  const Vector3D& delta_max, const double f) const {
+	const double 	scale 	= 1.0 + 2.0 * error_gamma<double>(3);
+	double 			t0 		= 0.0;
+	double 			t1 		= t_max;
+
+	double tx0 = (p_min.x + f * delta_min.x - ray.o.x) * inv_d.x;
+	double tx1 = (p_max.x + f * delta_max.x - ray.o.x) * inv_d.x;
+
+	if (tx0 > tx1)
+		std::swap(tx0, tx1);
+
+	t0 = std::max(t0, tx0);
+	t1 = std::min(t1, tx1 * scale);
+
+	double ty0 = (p_min.y + f * delta_min.y - ray.o.y) * inv_d.y;
+	double ty1 = (p_max.y + f * delta_max.y - ray.o.y) * inv_d.y;
+
+	if (ty0 > ty1)
+		std::swap(ty0, ty1);
+
+	t0 = std::max(t0, ty0);
+	t1 = std::min(t1, ty1 * scale);
+
+	double tz0 = (p_min.z + f * delta_min.z - ray.o.z) * inv_d.z;
+	double tz1 = (p_max.z + f * delta_max.z - ray.o.z) * inv_d.z;
+
+	if (tz0 > tz1)
+		std::swap(tz0, tz1);
+
+	t0 = std::max(t0, tz0);
+	t1 = std::min(t1, tz1 * scale);
+
+	return (t0 <= t1);
+}
+
+
+// ---------------------------------------------------------------- bbox_union
+
+inline BBox
+bbox_union(const BBox& a, const BBox& b) {
+	return (BBox(Point3D(std::min(a.p_min.x, b.p_min.x), std::min(a.p_min.y, b.p_min.y), std::min(a.p_min.z, b.p_min.z)),
+				 Point3D(std::max(a.p_max.x, b.p_max.x), std::max(a.p_max.y, b.p_max.y), std::max(a.p_max.z, b.p_max.z))));
+}
+
+
+// ---------------------------------------------------------------- bbox_union
+
+inline BBox
+bbox_union(const BBox& a, const Point3D& p) {
+	return (BBox(Point3D(std::min(a.p_min.x, p.x), std::min(a.p_min.y, p.y), std::min(a.p_min.z, p.z)),
+				 Point3D(std::max(a.p_max.x, p.x), std::max(a.p_max.y, p.y), std::max(a.p_max.z, p.z))));
+}
+
+
+// ---------------------------------------------------------------- bbox_lerp
+// the box f of the way from a to b, for the boxes of a moving object
+
+inline BBox
+bbox_lerp(const BBox& a, const BBox& b, const double f) {
+	return (BBox(a.p_min + f * (b.p_min - a.p_min), a.p_max + f * (b.p_max - a.p_max)));
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __EPSILON__
+#define __EPSILON__
+
+// This file contains the floating-point error bounds that replace fixed self-intersection epsilons
+// A fixed epsilon is too large for small scenes and too small for large ones, and in float it is
+// too small almost everywhere. Instead, each hit function bounds the rounding error of its own
+// computation of t, as error_gamma(n) times the magnitude of the terms involved, and only accepts
+// hits beyond that bound. error_gamma(n) is Higham's bound on the relative error of n rounded
+// operations.
+
+#include <limits>
+
+// ----------------------------------------------------------------------- machine_epsilon
+// the maximum relative error of rounding one result to T
+
+template <typename T>
+constexpr T
+machine_epsilon(void) {
+	return (std::numeric_limits<T>::epsilon() * (T)0.5);
+}
+
+
+// ----------------------------------------------------------------------- error_gamma
+
+template <typename T>
+constexpr T
+error_gamma(const int n) {
+	return ((n * machine_epsilon<T>()) / (1 - n * machine_epsilon<T>()));
+}
+
+#endif
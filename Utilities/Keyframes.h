@@ -0,0 +1,97 @@
+#ifndef __KEYFRAMES__
+#define __KEYFRAMES__
+
+// This file contains the keyframe helpers that Animation and MovingInstance share
+// Keys are structs with a double time, kept in a vector sorted by time. Values are interpolated
+// linearly between the keys around a time, and held at the first and last keys outside them.
+// TransformKey is the key of an object's scale, rotation in degrees about x, y and z, and translation.
+
+#include <algorithm>
+#include <vector>
+
+#include "Point3D.h"
+#include "Vector3D.h"
+
+//----------------------------------------------------------------------------- struct TransformKey
+
+struct TransformKey {
+	double		time;
+	Vector3D	scale;
+	Vector3D	rotation;
+	Vector3D	translation;
+};
+
+
+// ---------------------------------------------------------------- find_keys
+// the keys j and j + 1 around time, and how far time is between them; f is 0 or 1 outside the keys
+
+template <typename Key>
+inline void
+find_keys(const std::vector<Key>& keys, const double time, int& j, double& f) {
+	int num_keys = keys.size();
+
+	j = 0;
+	f = 0.0;
+
+	if (num_keys == 1 || time <= keys[0].time)
+		return;
+
+	if (time >= keys[num_keys - 1].time) {
+		j = num_keys - 2;
+		f = 1.0;
+		return;
+	}
+
+	while (keys[j + 1].time <= time)
+		j++;
+
+	f = (time - keys[j].time) / (keys[j + 1].time - keys[j].time);
+}
+
+
+// ---------------------------------------------------------------- insert_key
+// after any keys at the same time
+
+template <typename Key>
+inline void
+insert_key(std::vector<Key>& keys, const Key& key) {
+	auto later = [](const Key& a, const Key& b) { return (a.time < b.time); };
+
+	keys.insert(std::upper_bound(keys.begin(), keys.end(), key, later), key);
+}
+
+
+// ---------------------------------------------------------------- lerp
+
+inline Point3D
+lerp(const Point3D& a, const Point3D& b, const double f) {
+	return (a + f * (b - a));
+}
+
+
+// ---------------------------------------------------------------- lerp
+
+inline Vector3D
+lerp(const Vector3D& a, const Vector3D& b, const double f) {
+	return ((1.0 - f) * a + f * b);
+}
+
+
+// ---------------------------------------------------------------- interpolate
+// the transform at time, which there must be at least one key for
+
+inline TransformKey
+interpolate(const std::vector<TransformKey>& keys, const double time) {
+	int 	j;
+	double 	f;
+
+	find_keys(keys, time, j, f);
+
+	const TransformKey& k0 = keys[j];
+	const TransformKey& k1 = keys[std::min(j + 1, (int)keys.size() - 1)];
+
+	return (TransformKey{time, lerp(k0.scale, k1.scale, f), lerp(k0.rotation, k1.rotation, f),
+						 lerp(k0.translation, k1.translation, f)});
+}
+
+#endif
@@ -6,31 +6,63 @@
 inline double
 max(double x0, double x1);
 
+std::default_random_engine&
+rand_engine();
+
+void
+set_rand_seed(const int seed);
+
 float
 random_float();
 
 int
 random_int();
 
+inline float
+power_heuristic(const float f_pdf, const float g_pdf);
+
 inline double
 max(double x0, double x1)
 {
 	return((x0 > x1) ? x0 : x1);
 }
 
+// the engine behind random_float, random_int and the sample shuffling
+// every thread has its own, starting from the engine's default seed, so renders and benchmarks
+// are repeatable and render threads never share state
+
+inline std::default_random_engine&
+rand_engine() {
+    static thread_local std::default_random_engine e;
+    return e;
+}
+
+inline void
+set_rand_seed(const int seed) {
+    rand_engine().seed(seed);
+}
+
 inline float
 random_float()  {
-    static std::default_random_engine e;
-    static std::uniform_real_distribution<> dis(0, 1); // rage 0 - 1
-    return dis(e);
+    std::uniform_real_distribution<> dis(0, 1); // rage 0 - 1
+    return dis(rand_engine());
 }
 
 inline int
 random_int() {
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> dist6(1,10000);
-    return dist6(rng);
+    std::uniform_int_distribution<int> dist6(1,10000);
+    return dist6(rand_engine());
+}
+
+// the weight of a sample drawn with density f_pdf, when another technique with density g_pdf could
+// have drawn it too (Veach's power heuristic, with exponent 2)
+
+inline float
+power_heuristic(const float f_pdf, const float g_pdf) {
+	float f2 = f_pdf * f_pdf;
+	float g2 = g_pdf * g_pdf;
+
+	return (f2 > 0.0f ? f2 / (f2 + g2) : 0.0f);
 }
 
 #endif
@@ -1,11 +1,13 @@
-// This file contains the definition of the class Matrix
+// This file contains the definition of the class template Matrix4
+// It is explicitly instantiated for double (Matrix) and float (MatrixF) at the end of the file
 
 #include "Matrix.h"
 
 // ----------------------------------------------------------------------- default constructor
 // a default matrix is an identity matrix
 
-Matrix::Matrix(void) {	
+template <typename T>
+Matrix4<T>::Matrix4(void) {	
 	for (int x = 0; x < 4; x++)
 		for (int y = 0; y < 4; y++) {
 			if (x == y)
@@ -18,7 +20,8 @@ Matrix::Matrix(void) {
 
 // ----------------------------------------------------------------------- copy constructor
 
-Matrix::Matrix (const Matrix& mat) {
+template <typename T>
+Matrix4<T>::Matrix4 (const Matrix4& mat) {
 	for (int x = 0; x < 4; x++)				
 		for (int y = 0; y < 4; y++)			
 			m[x][y] = mat.m[x][y];	
@@ -27,15 +30,17 @@ Matrix::Matrix (const Matrix& mat) {
 
 // ----------------------------------------------------------------------- destructor
 
-Matrix::~Matrix (void) {}   
+template <typename T>
+Matrix4<T>::~Matrix4 (void) {}   
 
 
 
 
 // ----------------------------------------------------------------------- assignment operator
 
-Matrix& 
-Matrix::operator= (const Matrix& rhs) {
+template <typename T>
+Matrix4<T>& 
+Matrix4<T>::operator= (const Matrix4& rhs) {
 	if (this == &rhs)
 		return (*this);
 
@@ -50,13 +55,14 @@ Matrix::operator= (const Matrix& rhs) {
 // ----------------------------------------------------------------------- operator*
 // multiplication of two matrices
 
-Matrix 
-Matrix::operator* (const Matrix& mat) const {
-	Matrix 	product;
+template <typename T>
+Matrix4<T> 
+Matrix4<T>::operator* (const Matrix4& mat) const {
+	Matrix4 	product;
 	
 	for (int y = 0; y < 4; y++)
 		for (int x = 0; x < 4; x++) {
-			double sum = 0.0;
+			T sum = 0.0;
 
 			for (int j = 0; j < 4; j++)
 				sum += m[x][j] * mat.m[j][y];
@@ -71,8 +77,9 @@ Matrix::operator* (const Matrix& mat) const {
 // ----------------------------------------------------------------------- operator/
 // division by a scalar
 
-Matrix 
-Matrix::operator/ (const double d) {
+template <typename T>
+Matrix4<T> 
+Matrix4<T>::operator/ (const T d) {
 	for (int x = 0; x < 4; x++)				
 		for (int y = 0; y < 4; y++)			
 			m[x][y] = m[x][y] / d;	
@@ -85,8 +92,9 @@ Matrix::operator/ (const double d) {
 // ----------------------------------------------------------------------- set_identity
 // set matrix to the identity matrix
 
+template <typename T>
 void											
-Matrix::set_identity(void) {
+Matrix4<T>::set_identity(void) {
     for (int x = 0; x < 4; x++)
 		for (int y = 0; y < 4; y++) {
 			if (x == y)
@@ -97,7 +105,7 @@ Matrix::set_identity(void) {
 }
 
 
+// explicit instantiations
 
-
-
-
+template class Matrix4<double>;
+template class Matrix4<float>;
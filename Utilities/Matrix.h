@@ -1,38 +1,43 @@
 #ifndef __MATRIX__
 #define __MATRIX__
 
-// this file contains the declaration of the class Matrix
-// Matrix is a 4 x 4 square matrix that is used to represent affine transformations
+// this file contains the declaration of the class template Matrix4
+// Matrix4 is a 4 x 4 square matrix that is used to represent affine transformations
 // we don't need a general m x n matrix
+// Matrix, the double instantiation, is the one the rest of the ray tracer uses
 
-//----------------------------------------- class Matrix
+//----------------------------------------- class Matrix4
 
-class Matrix {
+template <typename T>
+class Matrix4 {
 	
 	public:
 	
-		double	m[4][4];								// elements
+		T	m[4][4];									// elements
 	
 		
-		Matrix(void);									// default constructor
+		Matrix4(void);									// default constructor
 
-		Matrix(const Matrix& mat);						// copy constructor
+		Matrix4(const Matrix4& mat);					// copy constructor
 		
-		~Matrix (void);									// destructor
+		~Matrix4 (void);								// destructor
 			
-		Matrix& 										// assignment operator
-		operator= (const Matrix& rhs); 	
+		Matrix4& 										// assignment operator
+		operator= (const Matrix4& rhs); 	
 			
-		Matrix 											// multiplication of two matrices
-		operator* (const Matrix& mat) const;
+		Matrix4 										// multiplication of two matrices
+		operator* (const Matrix4& mat) const;
 
-		Matrix 											// divsion by a double
-		operator/ (const double d);
+		Matrix4 										// divsion by a scalar
+		operator/ (const T d);
 
 		void											// set to the identity matrix
 		set_identity(void);	
 };
 
+typedef Matrix4<double>	Matrix;
+typedef Matrix4<float>	MatrixF;
+
 
 #endif
 
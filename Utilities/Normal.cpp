@@ -1,4 +1,5 @@
-// This file contains the defintion of the class Normal
+// This file contains the defintion of the class template Normal3
+// It is explicitly instantiated for double (Normal) and float (NormalF) at the end of the file
 
 #include <cmath>
 
@@ -7,28 +8,32 @@
 
 // ---------------------------------------------------------- default constructor
 
-Normal::Normal(void)
+template <typename T>
+Normal3<T>::Normal3(void)
 	 : x(0.0), y(0.0), z(0.0)							
 {}
 
 
 // ---------------------------------------------------------- constructor
 
-Normal::Normal(double a)
+template <typename T>
+Normal3<T>::Normal3(T a)
 	 : x(a), y(a), z(a)							
 {}
 
 
 // ---------------------------------------------------------- constructor
 
-Normal::Normal(double _x, double _y, double _z)	 
+template <typename T>
+Normal3<T>::Normal3(T _x, T _y, T _z)	 
 	: x(_x), y(_y), z(_z)
 {}
 
 
 // ---------------------------------------------------------- copy constructor
 
-Normal::Normal(const Normal& n)
+template <typename T>
+Normal3<T>::Normal3(const Normal3& n)
 	: x(n.x), y(n.y), z(n.z)
 {}
 
@@ -36,22 +41,25 @@ Normal::Normal(const Normal& n)
 // ---------------------------------------------------------- constructor
 // construct a normal from a vector
 
-Normal::Normal(const Vector3D& v)	 
+template <typename T>
+Normal3<T>::Normal3(const Vector3<T>& v)	 
 	: x(v.x), y(v.y), z(v.z)  
 {}
 
 
 // ---------------------------------------------------------- destructor
 
-Normal::~Normal (void) 							
+template <typename T>
+Normal3<T>::~Normal3 (void) 							
 {}
 
 
 // ----------------------------------------------------------- operator=
 // assignment operator
 
-Normal& 
-Normal::operator= (const Normal& rhs) {
+template <typename T>
+Normal3<T>& 
+Normal3<T>::operator= (const Normal3& rhs) {
 	if (this == &rhs)
 		return (*this);
 
@@ -64,8 +72,9 @@ Normal::operator= (const Normal& rhs) {
 // ------------------------------------------------------------ operator=
 // assignment of a vector to a normal
 
-Normal& 
-Normal::operator= (const Vector3D& rhs) {
+template <typename T>
+Normal3<T>& 
+Normal3<T>::operator= (const Vector3<T>& rhs) {
 	x = rhs.x; y = rhs.y; z = rhs.z;
 	return (*this);
 }
@@ -74,8 +83,9 @@ Normal::operator= (const Vector3D& rhs) {
 // ------------------------------------------------------------ operator=
 // assignment of a point to a normal
 
-Normal& 
-Normal::operator= (const Point3D& rhs) {		
+template <typename T>
+Normal3<T>& 
+Normal3<T>::operator= (const Point3<T>& rhs) {		
 	x = rhs.x; y = rhs.y; z = rhs.z;
 	return (*this);
 }
@@ -83,9 +93,10 @@ Normal::operator= (const Point3D& rhs) {
 
 // ------------------------------------------------------------ normalize
 
+template <typename T>
 void 													
-Normal::normalize(void) {	
-	double length = sqrt(x * x + y * y + z * z);
+Normal3<T>::normalize(void) {	
+	T length = std::sqrt(x * x + y * y + z * z);
 	x /= length; y /= length; z /= length;
 }
 
@@ -98,13 +109,19 @@ Normal::normalize(void) {
 // a normal is transformed by multiplying it on the left by the transpose of the upper left 3 x 3
 // partition of the inverse transformation matrix
 
-Normal 											
-operator* (const Matrix& mat, const Normal& n) {
-	return (Normal(	mat.m[0][0] * n.x + mat.m[1][0] * n.y + mat.m[2][0] * n.z,
-					mat.m[0][1] * n.x + mat.m[1][1] * n.y + mat.m[2][1] * n.z,
-					mat.m[0][2] * n.x + mat.m[1][2] * n.y + mat.m[2][2] * n.z));
+template <typename T>
+Normal3<T> 											
+operator* (const Matrix4<T>& mat, const Normal3<T>& n) {
+	return (Normal3<T>(	mat.m[0][0] * n.x + mat.m[1][0] * n.y + mat.m[2][0] * n.z,
+						mat.m[0][1] * n.x + mat.m[1][1] * n.y + mat.m[2][1] * n.z,
+						mat.m[0][2] * n.x + mat.m[1][2] * n.y + mat.m[2][2] * n.z));
 }
 
 
+// explicit instantiations
 
+template class Normal3<double>;
+template class Normal3<float>;
 
+template Normal3<double> operator* (const Matrix4<double>& mat, const Normal3<double>& n);
+template Normal3<float> operator* (const Matrix4<float>& mat, const Normal3<float>& n);
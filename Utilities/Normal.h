@@ -2,85 +2,107 @@
 #ifndef __NORMAL__
 #define __NORMAL__
 
-// This file contains the declaration of the class Normal
+// This file contains the declaration of the class template Normal3
+// Normal is the double instantiation, NormalF the float one; see Vector3D.h
 
 #include "Matrix.h"
 #include "Vector3D.h"
 #include "Point3D.h"
 
-class Normal 
+template <typename T>
+class Normal3 
 {	
 	public:
+
+		typedef T Scalar;
 	
-		double	x, y, z;
+		T	x, y, z;
 				
 	public:
 	
-		Normal(void);										// default constructor
-		Normal(double a);									// constructor
-		Normal(double _x, double _y, double _z);			// constructor
-		Normal(const Normal& n); 							// copy constructor
-		Normal(const Vector3D& v);							// constructs a normal from vector
+		Normal3(void);										// default constructor
+		Normal3(T a);										// constructor
+		Normal3(T _x, T _y, T _z);							// constructor
+		Normal3(const Normal3& n); 							// copy constructor
+		Normal3(const Vector3<T>& v);						// constructs a normal from vector
+
+		template <typename U>								// converts between scalar types
+		explicit Normal3(const Normal3<U>& n);
 		
-		~Normal(void);										// destructor
+		~Normal3(void);										// destructor
 
-		Normal& 											// assignment operator
-		operator= (const Normal& rhs); 	
+		Normal3& 											// assignment operator
+		operator= (const Normal3& rhs); 	
 		
-		Normal& 											// assignment of a vector to a normal
-		operator= (const Vector3D& rhs);
+		Normal3& 											// assignment of a vector to a normal
+		operator= (const Vector3<T>& rhs);
 		
-		Normal& 											// assignment of a point to a normal
-		operator= (const Point3D& rhs);
+		Normal3& 											// assignment of a point to a normal
+		operator= (const Point3<T>& rhs);
 		
-		Normal 												// unary minus
+		Normal3 											// unary minus
 		operator- (void) const;	
 		
-		Normal 												// addition
-		operator+ (const Normal& n) const;
+		Normal3 											// addition
+		operator+ (const Normal3& n) const;
 		
-		Normal& 											// compound addition
-		operator+= (const Normal& n);
+		Normal3& 											// compound addition
+		operator+= (const Normal3& n);
 		
-		double
-		operator* (const Vector3D& v) const;				// dot product with a vector on the right
+		T
+		operator* (const Vector3<T>& v) const;				// dot product with a vector on the right
 		
-		Normal 												// multiplication by a double on the right
-		operator* (const double a) const;
+		Normal3 											// multiplication by a scalar on the right
+		operator* (const T a) const;
 				
 		void 												// convert normal to a unit normal
 		normalize(void); 									 		
 };
 
+typedef Normal3<double>	Normal;
+typedef Normal3<float>	NormalF;
 
 
 
 
 // inlined member functions
 
+// ----------------------------------------------------------------------- converting constructor
+
+template <typename T>
+template <typename U>
+inline
+Normal3<T>::Normal3(const Normal3<U>& n)
+	: x((T)n.x), y((T)n.y), z((T)n.z)
+{}
+
+
 // ----------------------------------------------------------------------- operator-
 // unary minus
 
-inline Normal 											
-Normal::operator- (void) const {
-	return (Normal(-x, -y, -z));
+template <typename T>
+inline Normal3<T> 											
+Normal3<T>::operator- (void) const {
+	return (Normal3(-x, -y, -z));
 }
 
 
 // ----------------------------------------------------------------------- operator+
 // addition of two normals
 
-inline Normal 											
-Normal::operator+ (const Normal& n) const {
-	return (Normal(x + n.x, y + n.y, z + n.z));
+template <typename T>
+inline Normal3<T> 											
+Normal3<T>::operator+ (const Normal3& n) const {
+	return (Normal3(x + n.x, y + n.y, z + n.z));
 }
 
 
 // ----------------------------------------------------------------------- addition
 // compound addition of two normals
 
-inline Normal& 
-Normal::operator+= (const Normal& n) {
+template <typename T>
+inline Normal3<T>& 
+Normal3<T>::operator+= (const Normal3& n) {
 	x += n.x; y += n.y; z += n.z;
     return (*this);
 }
@@ -89,18 +111,20 @@ Normal::operator+= (const Normal& n) {
 // ----------------------------------------------------------------------- operator*
 // dot product of a normal on the left and a vector on the right
 
-inline double
-Normal::operator* (const Vector3D& v) const {
+template <typename T>
+inline T
+Normal3<T>::operator* (const Vector3<T>& v) const {
 	return (x * v.x + y * v.y + z * v.z);
 }
 
 
 // ----------------------------------------------------------------------- operator*
-// multiplication by a double on the right
+// multiplication by a scalar on the right
 
-inline Normal
-Normal::operator* (const double a) const {
-	return (Normal(x * a, y * a, z * a));
+template <typename T>
+inline Normal3<T>
+Normal3<T>::operator* (const T a) const {
+	return (Normal3(x * a, y * a, z * a));
 }
 
 
@@ -108,49 +132,41 @@ Normal::operator* (const double a) const {
 // inlined non-member functions
 
 // ----------------------------------------------------------------------- operator*
-// multiplication by a double on the left
+// multiplication by a scalar on the left
 
-Normal
-operator* (const double a, const Normal& n);
-
-inline Normal
-operator*(const double f, const Normal& n) {
-	return (Normal(f * n.x, f * n.y,f * n.z));
+template <typename T>
+inline Normal3<T>
+operator*(const typename Normal3<T>::Scalar f, const Normal3<T>& n) {
+	return (Normal3<T>(f * n.x, f * n.y,f * n.z));
 }
 
 
 // ----------------------------------------------------------------------- operator+
 // addition of a vector on the left to return a vector 
 
-Vector3D
-operator+ (const Vector3D& v, const Normal& n);
-
-inline Vector3D
-operator+ (const Vector3D& v, const Normal& n) {	
-	return (Vector3D(v.x + n.x, v.y + n.y, v.z + n.z));
+template <typename T>
+inline Vector3<T>
+operator+ (const Vector3<T>& v, const Normal3<T>& n) {	
+	return (Vector3<T>(v.x + n.x, v.y + n.y, v.z + n.z));
 }	
 
 
 // ----------------------------------------------------------------------- operator-
 // subtraction of a normal from a vector to return a vector
 
-Vector3D
-operator- (const Vector3D&, const Normal& n);
-
-inline Vector3D
-operator- (const Vector3D& v, const Normal& n) {
-	return (Vector3D(v.x - n.x, v.y - n.y, v.z - n.z));
+template <typename T>
+inline Vector3<T>
+operator- (const Vector3<T>& v, const Normal3<T>& n) {
+	return (Vector3<T>(v.x - n.x, v.y - n.y, v.z - n.z));
 }
 
 
 // ----------------------------------------------------------------------- operator*
 // dot product of a vector on the left and a normal on the right
 
-double
-operator* (const Vector3D& v, const Normal& n);
-
-inline double
-operator* (const Vector3D& v, const Normal& n) {
+template <typename T>
+inline T
+operator* (const Vector3<T>& v, const Normal3<T>& n) {
 	return (v.x * n.x + v.y * n.y + v.z * n.z);     
 }
 
@@ -161,8 +177,9 @@ operator* (const Vector3D& v, const Normal& n) {
 // ----------------------------------------------------------------------- operator*
 // multiplication by a matrix on the left
 
-Normal 											
-operator* (const Matrix& mat, const Normal& n);
+template <typename T>
+Normal3<T> 											
+operator* (const Matrix4<T>& mat, const Normal3<T>& n);
 
 
 #endif
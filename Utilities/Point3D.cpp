@@ -1,4 +1,5 @@
-// this file contains the definition of the class Point3D
+// this file contains the definition of the class template Point3
+// It is explicitly instantiated for double (Point3D) and float (Point3F) at the end of the file
 
 #include <cmath>
 #include "Point3D.h"
@@ -6,41 +7,47 @@
 
 // --------------------------------------------- default constructor
 
-Point3D::Point3D()
+template <typename T>
+Point3<T>::Point3()
 	:x(0), y(0), z(0)
 {}
 
 
 // --------------------------------------------- constructor
 
-Point3D::Point3D(const double a)
+template <typename T>
+Point3<T>::Point3(const T a)
 	:x(a), y(a), z(a)
 {}
 
 // --------------------------------------------- constructor
 
-Point3D::Point3D(const double a, const double b, const double c)
+template <typename T>
+Point3<T>::Point3(const T a, const T b, const T c)
 	:x(a), y(b), z(c)
 {}
 
 
 // --------------------------------------------- copy constructor
 
-Point3D::Point3D(const Point3D& p)
+template <typename T>
+Point3<T>::Point3(const Point3& p)
 	:x(p.x), y(p.y), z(p.z)
 {}
 
 
 // --------------------------------------------- destructor
 
-Point3D::~Point3D() 
+template <typename T>
+Point3<T>::~Point3() 
 {}
 
 
 // --------------------------------------------- assignment operator
 
-Point3D& 
-Point3D::operator= (const Point3D& rhs) {
+template <typename T>
+Point3<T>& 
+Point3<T>::operator= (const Point3& rhs) {
 	
 	if (this == &rhs)
 		return (*this);
@@ -55,9 +62,10 @@ Point3D::operator= (const Point3D& rhs) {
 // --------------------------------------------- distance
 // distance between two points
 
-double
-Point3D::distance(const Point3D& p) const {
-	return (sqrt(		(x - p.x) * (x - p.x) 
+template <typename T>
+T
+Point3<T>::distance(const Point3& p) const {
+	return (std::sqrt(	(x - p.x) * (x - p.x) 
 					+ 	(y - p.y) * (y - p.y)
 					+	(z - p.z) * (z - p.z) ));
 }
@@ -68,10 +76,19 @@ Point3D::distance(const Point3D& p) const {
 // --------------------------------------------- operator*
 // multiplication by a matrix on the left
 
-Point3D 						
-operator* (const Matrix& mat, const Point3D& p) {
-	return (Point3D(mat.m[0][0] * p.x + mat.m[0][1] * p.y + mat.m[0][2] * p.z + mat.m[0][3],
-					mat.m[1][0] * p.x + mat.m[1][1] * p.y + mat.m[1][2] * p.z + mat.m[1][3],
-					mat.m[2][0] * p.x + mat.m[2][1] * p.y + mat.m[2][2] * p.z + mat.m[2][3]));
+template <typename T>
+Point3<T> 						
+operator* (const Matrix4<T>& mat, const Point3<T>& p) {
+	return (Point3<T>(	mat.m[0][0] * p.x + mat.m[0][1] * p.y + mat.m[0][2] * p.z + mat.m[0][3],
+						mat.m[1][0] * p.x + mat.m[1][1] * p.y + mat.m[1][2] * p.z + mat.m[1][3],
+						mat.m[2][0] * p.x + mat.m[2][1] * p.y + mat.m[2][2] * p.z + mat.m[2][3]));
 }
 
+
+// explicit instantiations
+
+template class Point3<double>;
+template class Point3<float>;
+
+template Point3<double> operator* (const Matrix4<double>& mat, const Point3<double>& p);
+template Point3<float> operator* (const Matrix4<float>& mat, const Point3<float>& p);
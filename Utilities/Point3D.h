@@ -1,101 +1,128 @@
 #ifndef __POINT3D__
 #define __POINT3D__
 
-// This file contains the defintion of the class Point3D
+// This file contains the defintion of the class template Point3
+// Point3D is the double instantiation, Point3F the float one; see Vector3D.h
 
 #include "Matrix.h"
 #include "Vector3D.h"
 
-class Point3D {
+template <typename T>
+class Point3 {
 	public:
+
+		typedef T Scalar;
 	
-		double x, y, z;
+		T x, y, z;
 	
-		Point3D();													// default constructor
-		Point3D(const double a);									// constructor
-		Point3D(const double a, const double b, const double c);	// constructor
-		Point3D(const Point3D& p);									// copy constructor
-		~Point3D();													// destructor
+		Point3();													// default constructor
+		Point3(const T a);											// constructor
+		Point3(const T a, const T b, const T c);					// constructor
+		Point3(const Point3& p);									// copy constructor
+
+		template <typename U>										// converts between scalar types
+		explicit Point3(const Point3<U>& p);
+
+		~Point3();													// destructor
 		
-		Point3D& 													// assignment operator
-		operator= (const Point3D& p);
+		Point3& 													// assignment operator
+		operator= (const Point3& p);
 		
-		Point3D 													// unary minus
+		Point3 														// unary minus
 		operator- (void) const;
 	
-		Vector3D 													// vector joining two points
-		operator- (const Point3D& p) const;
+		Vector3<T> 													// vector joining two points
+		operator- (const Point3& p) const;
 		
-		Point3D 													// addition of a vector				
-		operator+ (const Vector3D& v) const;
+		Point3 														// addition of a vector				
+		operator+ (const Vector3<T>& v) const;
 		
-		Point3D 													// subtraction of a vector
-		operator- (const Vector3D& v) const;
+		Point3 														// subtraction of a vector
+		operator- (const Vector3<T>& v) const;
 				
-		Point3D 													// multiplication by a double on the right
-		operator* (const double a) const;
+		Point3 														// multiplication by a scalar on the right
+		operator* (const T a) const;
 		
-		double														// square of distance bertween two points
-		d_squared(const Point3D& p) const;
+		T															// square of distance bertween two points
+		d_squared(const Point3& p) const;
 		
-		double														// distance bewteen two points
-		distance(const Point3D& p) const;
+		T															// distance bewteen two points
+		distance(const Point3& p) const;
 };
 
+typedef Point3<double>	Point3D;
+typedef Point3<float>	Point3F;
+
 
 
 // inlined member functions
 
+// -------------------------------------------------------------- converting constructor
+
+template <typename T>
+template <typename U>
+inline
+Point3<T>::Point3(const Point3<U>& p)
+	: x((T)p.x), y((T)p.y), z((T)p.z)
+{}
+
+
 // -------------------------------------------------------------- operator-
 // unary minus
 
-inline Point3D 
-Point3D::operator- (void) const {
-	return (Point3D(-x, -y, -z));
+template <typename T>
+inline Point3<T> 
+Point3<T>::operator- (void) const {
+	return (Point3(-x, -y, -z));
 }
 
 
 // -------------------------------------------------------------- operator-
 // the vector that joins two points
 
-inline Vector3D 
-Point3D::operator- (const Point3D& p) const {
-	return (Vector3D(x - p.x,y - p.y,z - p.z));
+template <typename T>
+inline Vector3<T> 
+Point3<T>::operator- (const Point3& p) const {
+	return (Vector3<T>(x - p.x,y - p.y,z - p.z));
 }
 
 
 // -------------------------------------------------------------- operator+
 // addition of a vector to a point that returns a new point
 
-inline Point3D 
-Point3D::operator+ (const Vector3D& v) const {
-	return (Point3D(x + v.x, y + v.y, z + v.z));
+template <typename T>
+inline Point3<T> 
+Point3<T>::operator+ (const Vector3<T>& v) const {
+	return (Point3(x + v.x, y + v.y, z + v.z));
 }
 
 
 // -------------------------------------------------------------- operator-
 // subtraction of a vector from a point that returns a new point
 
-inline Point3D 
-Point3D::operator- (const Vector3D& v) const {
-	return (Point3D(x - v.x, y - v.y, z - v.z));
+template <typename T>
+inline Point3<T> 
+Point3<T>::operator- (const Vector3<T>& v) const {
+	return (Point3(x - v.x, y - v.y, z - v.z));
 }
 
 
 // -------------------------------------------------------------- operator*
-// mutliplication by a double on the right
+// mutliplication by a scalar on the right
 
-inline Point3D 
-Point3D::operator* (const double a) const {
-	return (Point3D(x * a,y * a,z * a));
+template <typename T>
+inline Point3<T> 
+Point3<T>::operator* (const T a) const {
+	return (Point3(x * a,y * a,z * a));
 }
 
 
 // -------------------------------------------------------------- d_squared
 // the square of the distance between the two points as a member function
 
-inline double
-Point3D::d_squared(const Point3D& p) const {
+template <typename T>
+inline T
+Point3<T>::d_squared(const Point3& p) const {
 	return (	(x - p.x) * (x - p.x) 
 			+ 	(y - p.y) * (y - p.y)
 			+	(z - p.z) * (z - p.z) );
@@ -107,14 +134,12 @@ Point3D::d_squared(const Point3D& p) const {
 // inlined non-member function
 
 // -------------------------------------------------------------- operator*
-// multiplication by a double on the left
-
-Point3D
-operator* (double a, const Point3D& p);
+// multiplication by a scalar on the left
 
-inline Point3D
-operator* (double a, const Point3D& p) {
-	return (Point3D(a * p.x, a * p.y, a * p.z));
+template <typename T>
+inline Point3<T>
+operator* (const typename Point3<T>::Scalar a, const Point3<T>& p) {
+	return (Point3<T>(a * p.x, a * p.y, a * p.z));
 }
 
 
@@ -124,7 +149,8 @@ operator* (double a, const Point3D& p) {
 // -------------------------------------------------------------- operator*
 // multiplication by a matrix on the left
 
-Point3D 						
-operator* (const Matrix& mat, const Point3D& p);
+template <typename T>
+Point3<T> 						
+operator* (const Matrix4<T>& mat, const Point3<T>& p);
 
 #endif
@@ -2,14 +2,19 @@
 #define __RGB_COLOR__
 
 // This file contains the declaration of the class RGBColor
+// The components are stored with a padding lane in 16 aligned bytes, and the operators work on all
+// four lanes at once; see Simd.h
+
+#include "Simd.h"
 
 //------------------------------------------------------------ class RGBColor
 
-class RGBColor {
+class alignas(16) RGBColor {
 	
 	public:
 	
-		float	r, g, b;									
+		float	r, g, b;
+		float	pad;										// always 0
 				
 	public:
 	
@@ -57,13 +62,64 @@ class RGBColor {
 
 
 // inlined member functions
+// these are all in the header so that a chain of operators compiles to a chain of SSE instructions
+
+// ----------------------------------------------------------------------- default constructor
+
+inline
+RGBColor::RGBColor(void) {
+	f4_store(&r, f4_set(0.0f, 0.0f, 0.0f, 0.0f));
+}
+
+
+// ----------------------------------------------------------------------- constructor
+
+inline
+RGBColor::RGBColor(float c) {
+	f4_store(&r, f4_splat3(c));
+}
+
+
+// ----------------------------------------------------------------------- constructor
+
+inline
+RGBColor::RGBColor(float _r, float _g, float _b) {
+	f4_store(&r, f4_set(_r, _g, _b, 0.0f));
+}
+
+
+// ----------------------------------------------------------------------- copy constructor
+
+inline
+RGBColor::RGBColor(const RGBColor& c) {
+	f4_store(&r, f4_load(&c.r));
+}
+
+
+// ----------------------------------------------------------------------- destructor
+
+inline
+RGBColor::~RGBColor(void)
+{}
+
+
+// ----------------------------------------------------------------------- assignment operator
+
+inline RGBColor&
+RGBColor::operator= (const RGBColor& rhs) {
+	f4_store(&r, f4_load(&rhs.r));
+	return (*this);
+}
+
 
 // ----------------------------------------------------------------------- operator+
 // addition of two colors
 
 inline RGBColor 
 RGBColor::operator+ (const RGBColor& c) const {
-	return (RGBColor(r + c.r, g + c.g, b + c.b));
+	RGBColor sum;
+	f4_store(&sum.r, f4_add(f4_load(&r), f4_load(&c.r)));
+	return (sum);
 }
 
 
@@ -72,8 +128,8 @@ RGBColor::operator+ (const RGBColor& c) const {
 
 inline RGBColor& 
 RGBColor::operator+= (const RGBColor& c) {
-	r += c.r; g += c.g; b += c.b;
-    return (*this);
+	f4_store(&r, f4_add(f4_load(&r), f4_load(&c.r)));
+	return (*this);
 }
 
 
@@ -82,7 +138,9 @@ RGBColor::operator+= (const RGBColor& c) {
 
 inline RGBColor 
 RGBColor::operator* (const float a) const {
-	return (RGBColor (r * a, g * a, b * a));	
+	RGBColor product;
+	f4_store(&product.r, f4_mul(f4_load(&r), a));
+	return (product);
 }
 
 
@@ -91,7 +149,7 @@ RGBColor::operator* (const float a) const {
 
 inline RGBColor& 
 RGBColor::operator*= (const float a) {
-	r *= a; g *= a; b *= a;
+	f4_store(&r, f4_mul(f4_load(&r), a));
 	return (*this);
 }
 
@@ -101,7 +159,9 @@ RGBColor::operator*= (const float a) {
 
 inline RGBColor 
 RGBColor::operator/ (const float a) const {
-	return (RGBColor (r / a, g / a, b / a));
+	RGBColor quotient;
+	f4_store(&quotient.r, f4_div(f4_load(&r), a));
+	return (quotient);
 }
 
 
@@ -110,7 +170,7 @@ RGBColor::operator/ (const float a) const {
 
 inline RGBColor& 
 RGBColor::operator/= (const float a) {	
-	r /= a; g /= a; b /= a;
+	f4_store(&r, f4_div(f4_load(&r), a));
 	return (*this);
 }
 
@@ -121,7 +181,9 @@ RGBColor::operator/= (const float a) {
 
 inline RGBColor 
 RGBColor::operator* (const RGBColor& c) const {
-	return (RGBColor (r * c.r, g * c.g, b * c.b));
+	RGBColor product;
+	f4_store(&product.r, f4_mul(f4_load(&r), f4_load(&c.r)));
+	return (product);
 } 
 
 
@@ -130,7 +192,7 @@ RGBColor::operator* (const RGBColor& c) const {
 
 inline bool
 RGBColor::operator== (const RGBColor& c) const {
-	return (r == c.r && g == c.g && b == c.b);
+	return (f4_equal3(f4_load(&r), f4_load(&c.r)));
 }
 
 
@@ -155,7 +217,7 @@ operator* (const float a, const RGBColor& c);
 
 inline RGBColor 
 operator* (const float a, const RGBColor& c) {
-	return (RGBColor (a * c.r, a * c.g, a * c.b));	
+	return (c * a);
 }
 
 
@@ -4,22 +4,34 @@
 
 Ray::Ray (void)
 	: 	o(0.0), 
-		d(0.0, 0.0, 1.0) 
+		d(0.0, 0.0, 1.0),
+		time(0.0),
+		has_differentials(false)
 {}
 
 // ---------------------------------------------------------------- constructor
 
 Ray::Ray (const Point3D& origin, const Vector3D& dir)
 	: 	o(origin), 
-		d(dir) 
+		d(dir),
+		time(0.0),
+		has_differentials(false)
 {}
 
 // ---------------------------------------------------------------- copy constructor
+// the differentials are only copied if the ray has them, so that rays without cost no more to copy
 
 Ray::Ray (const Ray& ray)
 	: 	o(ray.o), 
-		d(ray.d) 
-{}
+		d(ray.d),
+		time(ray.time),
+		has_differentials(ray.has_differentials)
+{
+	if (has_differentials) {
+		rx_o = ray.rx_o; ry_o = ray.ry_o;
+		rx_d = ray.rx_d; ry_d = ray.ry_d;
+	}
+}
 
 // ---------------------------------------------------------------- assignment operator
 
@@ -31,6 +43,13 @@ Ray::operator= (const Ray& rhs) {
 		
 	o = rhs.o; 
 	d = rhs.d; 
+	time = rhs.time;
+	has_differentials = rhs.has_differentials;
+
+	if (has_differentials) {
+		rx_o = rhs.rx_o; ry_o = rhs.ry_o;
+		rx_d = rhs.rx_d; ry_d = rhs.ry_d;
+	}
 
 	return (*this);	
 }
@@ -1,6 +1,11 @@
 #ifndef __RAY__
 #define __RAY__
 
+// A camera ray can carry differentials: the rays through the next pixel across and the next pixel
+// up, rx and ry, from which the footprint of the pixel at a hit is found (ShadeRec::set_differentials)
+// for texture filtering. Only the camera sets them (Camera::get_differentials), when the view plane
+// asks for them; the rays spawned at hits have none.
+
 #include "Point3D.h"
 #include "Vector3D.h"
 
@@ -9,6 +14,10 @@ class Ray {
 	
 		Point3D			o;  	// origin 
 		Vector3D		d; 		// direction 
+		float			time;	// when the ray is cast, from 0 at the shutter's opening to 1 at its closing
+		bool			has_differentials;
+		Point3D			rx_o, ry_o;		// the differential rays' origins
+		Vector3D		rx_d, ry_d;		// and directions, set only if has_differentials
 		
 		Ray(void);			
 		
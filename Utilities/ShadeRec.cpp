@@ -6,8 +6,12 @@
 // the ray tracer is written so that new ShadeRec objects are always constructed
 // using the first constructor or the copy constructor
 
+#include <math.h>
+
 #include "Constants.h"
+#include "Epsilon.h"
 #include "ShadeRec.h"
+#include "../GeometricObjects/GeometricObject.h"
 
 // ------------------------------------------------------------------ constructor
 
@@ -17,8 +21,11 @@ ShadeRec::ShadeRec(World& wr)
 		hit_point(),
 		local_hit_point(),
 		normal(),
+		dpdx(0.0),
+		dpdy(0.0),
 		ray(),
 		depth(0),
+		throughput(white),
 		t(0.0),
 		w(wr)
 {}
@@ -32,15 +39,54 @@ ShadeRec::ShadeRec(const ShadeRec& sr)
 		hit_point(sr.hit_point),
 		local_hit_point(sr.local_hit_point),
 		normal(sr.normal),
+		dpdx(sr.dpdx),
+		dpdy(sr.dpdy),
 		ray(sr.ray),
 		depth(sr.depth),
+		throughput(sr.throughput),
 		t(sr.t),
 		w(sr.w)
 {}
 
 
+// ------------------------------------------------------------------ spawn_ray
+// The hit point is off the surface by the rounding error of t, which the hit functions compute in
+// float, and their error bounds on t don't cover rays that leave the surface at grazing angles.
+// The origin is moved along the normal, to the side that d points to, by a bound on that error, so
+// that the ray can't hit the surface it leaves.
+
+Ray
+ShadeRec::spawn_ray(const Vector3D& d) const {
+	double offset = error_gamma<float>(kSpawnErrorTerms)
+					* (fabs(hit_point.x) + fabs(hit_point.y) + fabs(hit_point.z) + fabs(t));
+	Vector3D n(normal);
+
+	if (n * d < 0.0)
+		offset = -offset;
+
+	Ray spawned(hit_point + offset * n, d);
+	spawned.time = ray.time;
+
+	return (spawned);
+}
+
+
+// ------------------------------------------------------------------ set_differentials
+// The differential rays are intersected with the plane tangent to the surface at the hit point, and
+// the offsets to their hits are taken into the object's space, where local_hit_point is. A
+// differential ray parallel to the tangent plane leaves both offsets 0.
+
+void
+ShadeRec::set_differentials(const Ray& ray, const GeometricObject& object) {
+	double ndotdx = normal * ray.rx_d;
+	double ndotdy = normal * ray.ry_d;
+
+	if (ndotdx == 0.0 || ndotdy == 0.0)
+		return;
+
+	double tx = (normal * (hit_point - ray.rx_o)) / ndotdx;
+	double ty = (normal * (hit_point - ray.ry_o)) / ndotdy;
 
-		
-		
-						
-		
+	dpdx = object.object_vector(ray.rx_o + tx * ray.rx_d - hit_point, ray.time);
+	dpdy = object.object_vector(ray.ry_o + ty * ray.ry_d - hit_point, ray.time);
+}
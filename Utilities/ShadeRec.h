@@ -5,6 +5,7 @@
 
 #include <vector>
 
+class GeometricObject;
 class Material;
 class World;
 
@@ -24,8 +25,10 @@ class ShadeRec {
 		Point3D 			hit_point;			// World coordinates of intersection
 		Point3D				local_hit_point;	// World coordinates of hit point on generic object (used for texture transformations)
 		Normal				normal;				// Normal at hit point
+		Vector3D			dpdx, dpdy;			// how far local_hit_point moves across a pixel and up one; 0 without ray differentials
 		Ray					ray;				// Required for specular highlights and area lights
 		int					depth;				// recursion depth
+		RGBColor			throughput;			// the product of the reflectances along the path to this hit
 		float				t;					// ray parameter
 		World&				w;					// World reference
 		RGBColor            color;
@@ -33,6 +36,16 @@ class ShadeRec {
 		ShadeRec(World& wr);					// constructor
 		
 		ShadeRec(const ShadeRec& sr);			// copy constructor
+
+		Ray										// a ray leaving the hit point in direction d; see Utilities/Epsilon.h
+		spawn_ray(const Vector3D& d) const;
+
+		void									// sets dpdx and dpdy from the ray's differentials, once the hit point and normal are set
+		set_differentials(const Ray& ray, const GeometricObject& object);
+
+	private:
+
+		static constexpr int kSpawnErrorTerms = 16;	// rounded operations behind the hit point, for spawn_ray's offset
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#ifndef __SIMD__
+#define __SIMD__
+
+// This file contains the 4-wide float operations behind RGBColor and Vector3F
+// Both classes store three components and a padding lane in 16 aligned bytes, so that each operator
+// is one load, one SSE instruction and one store. The padding lane is 0 on construction and stays 0
+// through every operator with a finite result.
+// With RT_SIMD on a target with SSE2 the operations use SSE intrinsics, otherwise a scalar loop.
+
+#if defined(RT_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define RT_SSE
+#include <xmmintrin.h>
+#endif
+
+#ifdef RT_SSE
+
+typedef __m128 Float4;
+
+#else
+
+struct alignas(16) Float4 {
+	float v[4];
+};
+
+#endif
+
+
+// ----------------------------------------------------------------------- f4_load
+// p must be 16-byte aligned
+
+inline Float4
+f4_load(const float* p) {
+#ifdef RT_SSE
+	return (_mm_load_ps(p));
+#else
+	Float4 a = {{p[0], p[1], p[2], p[3]}};
+	return (a);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_store
+// p must be 16-byte aligned
+
+inline void
+f4_store(float* p, const Float4 a) {
+#ifdef RT_SSE
+	_mm_store_ps(p, a);
+#else
+	p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3];
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_set
+
+inline Float4
+f4_set(const float x, const float y, const float z, const float w) {
+#ifdef RT_SSE
+	return (_mm_set_ps(w, z, y, x));
+#else
+	Float4 a = {{x, y, z, w}};
+	return (a);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_splat3
+// a in the first three lanes and 0 in the padding lane
+
+inline Float4
+f4_splat3(const float a) {
+	return (f4_set(a, a, a, 0.0f));
+}
+
+
+// ----------------------------------------------------------------------- f4_add
+
+inline Float4
+f4_add(const Float4 a, const Float4 b) {
+#ifdef RT_SSE
+	return (_mm_add_ps(a, b));
+#else
+	Float4 c = {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_sub
+
+inline Float4
+f4_sub(const Float4 a, const Float4 b) {
+#ifdef RT_SSE
+	return (_mm_sub_ps(a, b));
+#else
+	Float4 c = {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_mul
+
+inline Float4
+f4_mul(const Float4 a, const Float4 b) {
+#ifdef RT_SSE
+	return (_mm_mul_ps(a, b));
+#else
+	Float4 c = {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_mul
+// by a scalar, which leaves the padding lane 0
+
+inline Float4
+f4_mul(const Float4 a, const float s) {
+#ifdef RT_SSE
+	return (_mm_mul_ps(a, _mm_set1_ps(s)));
+#else
+	Float4 c = {{a.v[0] * s, a.v[1] * s, a.v[2] * s, a.v[3] * s}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_div
+// by a scalar; the padding lane is divided too, so it only stays 0 if s is not 0
+
+inline Float4
+f4_div(const Float4 a, const float s) {
+#ifdef RT_SSE
+	return (_mm_div_ps(a, _mm_set1_ps(s)));
+#else
+	Float4 c = {{a.v[0] / s, a.v[1] / s, a.v[2] / s, a.v[3] / s}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_neg
+
+inline Float4
+f4_neg(const Float4 a) {
+#ifdef RT_SSE
+	return (_mm_sub_ps(_mm_setzero_ps(), a));
+#else
+	Float4 c = {{-a.v[0], -a.v[1], -a.v[2], -a.v[3]}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_hsum3
+// a[0] + a[1] + a[2], added in that order so that the result matches the scalar code
+
+inline float
+f4_hsum3(const Float4 a) {
+#ifdef RT_SSE
+	__m128 y = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 z = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+	return (_mm_cvtss_f32(_mm_add_ss(_mm_add_ss(a, y), z)));
+#else
+	return (a.v[0] + a.v[1] + a.v[2]);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_dot3
+// the dot product of the first three lanes
+
+inline float
+f4_dot3(const Float4 a, const Float4 b) {
+	return (f4_hsum3(f4_mul(a, b)));
+}
+
+
+// ----------------------------------------------------------------------- f4_cross3
+// the cross product of the first three lanes; the padding lane is 0 if both inputs' are
+
+inline Float4
+f4_cross3(const Float4 a, const Float4 b) {
+#ifdef RT_SSE
+	__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 c_zxy = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+	return (_mm_shuffle_ps(c_zxy, c_zxy, _MM_SHUFFLE(3, 0, 2, 1)));
+#else
+	Float4 c = {{	a.v[1] * b.v[2] - a.v[2] * b.v[1],
+					a.v[2] * b.v[0] - a.v[0] * b.v[2],
+					a.v[0] * b.v[1] - a.v[1] * b.v[0],
+					0.0f}};
+	return (c);
+#endif
+}
+
+
+// ----------------------------------------------------------------------- f4_equal3
+// are the first three lanes equal?
+
+inline bool
+f4_equal3(const Float4 a, const Float4 b) {
+#ifdef RT_SSE
+	return ((_mm_movemask_ps(_mm_cmpeq_ps(a, b)) & 0x7) == 0x7);
+#else
+	return (a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2]);
+#endif
+}
+
+#endif
@@ -0,0 +1,195 @@
+// This file contains the definition of the render statistics subsystem
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+#include "Stats.h"
+
+// the registry of live per-thread blocks, and the sum of the blocks of threads that have exited
+// these are function statics so that they exist before the first thread_local block registers
+
+static std::mutex&
+registry_mutex(void) {
+	static std::mutex m;
+	return (m);
+}
+
+static std::vector<ThreadStatBlock*>&
+registry(void) {
+	static std::vector<ThreadStatBlock*> blocks;
+	return (blocks);
+}
+
+static StatBlock&
+retired(void) {
+	static StatBlock block;
+	return (block);
+}
+
+
+// ---------------------------------------------------------------- StatBlock constructor
+
+StatBlock::StatBlock(void) {
+	clear();
+}
+
+
+// ---------------------------------------------------------------- clear
+
+void
+StatBlock::clear(void) {
+	std::fill(counters, counters + STAT_NUM_COUNTERS, 0);
+	std::fill(timer_ns, timer_ns + STAT_NUM_TIMERS, 0);
+	std::fill(timer_calls, timer_calls + STAT_NUM_TIMERS, 0);
+}
+
+
+// ---------------------------------------------------------------- operator+=
+
+StatBlock&
+StatBlock::operator+= (const StatBlock& rhs) {
+	for (int j = 0; j < STAT_NUM_COUNTERS; j++)
+		counters[j] += rhs.counters[j];
+
+	for (int j = 0; j < STAT_NUM_TIMERS; j++) {
+		timer_ns[j] 	+= rhs.timer_ns[j];
+		timer_calls[j] 	+= rhs.timer_calls[j];
+	}
+
+	return (*this);
+}
+
+
+// ---------------------------------------------------------------- ThreadStatBlock constructor
+
+ThreadStatBlock::ThreadStatBlock(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	registry().push_back(this);
+}
+
+
+// ---------------------------------------------------------------- ThreadStatBlock destructor
+
+ThreadStatBlock::~ThreadStatBlock(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	std::vector<ThreadStatBlock*>& blocks = registry();
+
+	retired() += block;
+	blocks.erase(std::remove(blocks.begin(), blocks.end(), this), blocks.end());
+}
+
+
+// ---------------------------------------------------------------- begin_frame
+
+void
+Stats::begin_frame(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+
+	for (ThreadStatBlock* tsb : registry())
+		tsb->block.clear();
+
+	retired().clear();
+}
+
+
+// ---------------------------------------------------------------- end_frame
+
+StatBlock
+Stats::end_frame(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	StatBlock totals(retired());
+
+	for (ThreadStatBlock* tsb : registry())
+		totals += tsb->block;
+
+	return (totals);
+}
+
+
+// ---------------------------------------------------------------- counter_name
+
+const char*
+Stats::counter_name(const StatCounter c) {
+	static const char* names[STAT_NUM_COUNTERS] = {
+		"primary_rays",
+		"rays",
+		"traversal_steps",
+		"intersection_tests",
+		"hits",
+		"shade_calls",
+		"light_samples",
+		"light_bvh_steps",
+		"secondary_rays",
+		"depth_cutoffs",
+		"throughput_cutoffs",
+		"roulette_kills",
+		"shadow_rays"
+	};
+
+	return (names[c]);
+}
+
+
+// ---------------------------------------------------------------- timer_name
+
+const char*
+Stats::timer_name(const StatTimer t) {
+	static const char* names[STAT_NUM_TIMERS] = {
+		"build",
+		"render",
+		"hit_objects",
+		"shade",
+		"bvh_build",
+		"bvh_refit"
+	};
+
+	return (names[t]);
+}
+
+
+// ---------------------------------------------------------------- report
+
+void
+Stats::report(std::ostream& out, const StatBlock& totals) {
+	out << "Render statistics\n";
+
+	for (int j = 0; j < STAT_NUM_COUNTERS; j++)
+		out << "  " << std::left << std::setw(24) << counter_name((StatCounter)j)
+			<< std::right << std::setw(16) << totals.counters[j] << "\n";
+
+	uint64_t rays = totals.counters[STAT_RAYS];
+
+	if (rays > 0)
+		out << "  " << std::left << std::setw(24) << "tests per ray"
+			<< std::right << std::setw(16) << std::fixed << std::setprecision(2)
+			<< (double)totals.counters[STAT_INTERSECTION_TESTS] / rays << "\n";
+
+	for (int j = 0; j < STAT_NUM_TIMERS; j++) {
+		double seconds = totals.timer_ns[j] * 1.0e-9;
+
+		out << "  " << std::left << std::setw(24) << timer_name((StatTimer)j)
+			<< std::right << std::setw(14) << std::fixed << std::setprecision(3) << seconds << " s"
+			<< std::setw(14) << totals.timer_calls[j] << " calls\n";
+	}
+}
+
+
+// ---------------------------------------------------------------- write_json
+
+void
+Stats::write_json(std::ostream& out, const StatBlock& totals) {
+	out << "{\n  \"counters\": {";
+
+	for (int j = 0; j < STAT_NUM_COUNTERS; j++)
+		out << (j ? "," : "") << "\n    \"" << counter_name((StatCounter)j) << "\": " << totals.counters[j];
+
+	out << "\n  },\n  \"timers\": {";
+
+	for (int j = 0; j < STAT_NUM_TIMERS; j++)
+		out << (j ? "," : "") << "\n    \"" << timer_name((StatTimer)j) << "\": { \"ns\": " << totals.timer_ns[j]
+			<< ", \"calls\": " << totals.timer_calls[j] << " }";
+
+	out << "\n  }\n}\n";
+}
@@ -0,0 +1,175 @@
+#ifndef __STATS__
+#define __STATS__
+
+// This file contains the declaration of the render statistics subsystem
+// Every thread counts into its own StatBlock, so the hot path never takes a lock or touches
+// a shared cache line. Stats::end_frame merges the blocks of all threads into a frame total.
+// The counters and timers are only compiled in when RT_STATS is defined; otherwise every
+// STATS_ macro expands to nothing, so a release build carries no trace of them
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+//----------------------------------------------------------------------------- counters
+
+enum StatCounter {
+	STAT_PRIMARY_RAYS,				// rays generated by the view plane or camera
+	STAT_RAYS,						// rays cast into the scene by World::hit_objects
+	STAT_TRAVERSAL_STEPS,			// objects or acceleration nodes visited by World::hit_objects
+	STAT_INTERSECTION_TESTS,		// calls to GeometricObject::hit
+	STAT_HITS,						// rays that hit an object
+	STAT_SHADE_CALLS,				// calls to Material::shade
+	STAT_LIGHT_SAMPLES,				// lights evaluated by shading
+	STAT_LIGHT_BVH_STEPS,			// interior nodes visited by LightBVH::sample
+	STAT_SECONDARY_RAYS,			// rays traced at depth > 0 by the recursive tracers
+	STAT_DEPTH_CUTOFFS,				// secondary rays not traced because they were past the maximum depth
+	STAT_THROUGHPUT_CUTOFFS,		// secondary rays not traced because their throughput was too low
+	STAT_ROULETTE_KILLS,			// paths ended by Russian roulette
+	STAT_SHADOW_RAYS,				// occlusion queries for shadows and ambient occlusion, by World::any_hit
+	STAT_NUM_COUNTERS
+};
+
+
+//----------------------------------------------------------------------------- timers
+// timers are inclusive: time spent in a nested stage is also counted by the enclosing one
+
+enum StatTimer {
+	STAT_TIME_BUILD,				// World::build
+	STAT_TIME_RENDER,				// the whole pixel loop
+	STAT_TIME_HIT_OBJECTS,			// World::hit_objects
+	STAT_TIME_SHADE,				// Material::shade
+	STAT_TIME_BVH_BUILD,			// BVH builds, including the rebuilds after a refit
+	STAT_TIME_BVH_REFIT,			// BVH refits
+	STAT_NUM_TIMERS
+};
+
+
+//----------------------------------------------------------------------------- struct StatBlock
+
+struct StatBlock {
+	uint64_t	counters[STAT_NUM_COUNTERS];
+	uint64_t	timer_ns[STAT_NUM_TIMERS];			// accumulated nanoseconds
+	uint64_t	timer_calls[STAT_NUM_TIMERS];		// number of timed intervals
+
+	StatBlock(void);
+
+	void
+	clear(void);
+
+	StatBlock&
+	operator+= (const StatBlock& rhs);
+};
+
+
+//----------------------------------------------------------------------------- class ThreadStatBlock
+// the per-thread storage behind Stats::local
+// it registers itself on construction and folds its counts into the retired total when its thread exits
+
+class ThreadStatBlock {
+	public:
+
+		StatBlock	block;
+
+		ThreadStatBlock(void);
+
+		~ThreadStatBlock(void);
+};
+
+
+//----------------------------------------------------------------------------- class Stats
+// begin_frame and end_frame must not run while other threads are still counting
+
+class Stats {
+	public:
+
+		static StatBlock&						// the calling thread's block
+		local(void);
+
+		static void								// zeroes the blocks of all threads
+		begin_frame(void);
+
+		static StatBlock						// sums the blocks of all threads, including finished ones
+		end_frame(void);
+
+		static const char*
+		counter_name(const StatCounter c);
+
+		static const char*
+		timer_name(const StatTimer t);
+
+		static void								// human-readable summary
+		report(std::ostream& out, const StatBlock& totals);
+
+		static void
+		write_json(std::ostream& out, const StatBlock& totals);
+};
+
+
+//----------------------------------------------------------------------------- class ScopedStatTimer
+// adds the lifetime of the object to a timer of the calling thread
+
+class ScopedStatTimer {
+	public:
+
+		explicit
+		ScopedStatTimer(const StatTimer t);
+
+		~ScopedStatTimer(void);
+
+	private:
+
+		StatTimer								timer;
+		std::chrono::steady_clock::time_point	start;
+};
+
+
+// ---------------------------------------------------------------- local
+
+inline StatBlock&
+Stats::local(void) {
+	static thread_local ThreadStatBlock tls;
+	return (tls.block);
+}
+
+
+// ---------------------------------------------------------------- constructor
+
+inline
+ScopedStatTimer::ScopedStatTimer(const StatTimer t)
+	: 	timer(t),
+		start(std::chrono::steady_clock::now())
+{}
+
+
+// ---------------------------------------------------------------- destructor
+
+inline
+ScopedStatTimer::~ScopedStatTimer(void) {
+	StatBlock& block = Stats::local();
+	block.timer_ns[timer] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+								std::chrono::steady_clock::now() - start).count();
+	block.timer_calls[timer]++;
+}
+
+
+//----------------------------------------------------------------------------- macros
+
+#ifdef RT_STATS
+
+#define STATS_CONCAT_IMPL(a, b)	a##b
+#define STATS_CONCAT(a, b)		STATS_CONCAT_IMPL(a, b)
+
+#define STATS_INC(c)			(++Stats::local().counters[c])
+#define STATS_ADD(c, n)			(Stats::local().counters[c] += (n))
+#define STATS_TIMER(t)			ScopedStatTimer STATS_CONCAT(stats_timer_, __LINE__)(t)
+
+#else
+
+#define STATS_INC(c)			((void)0)
+#define STATS_ADD(c, n)			((void)0)
+#define STATS_TIMER(t)			((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+// This file contains the definition of the render timeline
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+#include "Timeline.h"
+
+std::atomic<bool>						Timeline::is_enabled(false);
+std::chrono::steady_clock::time_point	Timeline::epoch = std::chrono::steady_clock::now();
+
+// the events of threads that have exited, in the order they were recorded
+
+struct RetiredTimeline {
+	int							tid;
+	std::string					thread_name;
+	std::vector<TimelineEvent>	events;
+};
+
+// the registry of live per-thread buffers, and the buffers of threads that have exited
+// these are function statics so that they exist before the first thread_local buffer registers
+
+static std::mutex&
+registry_mutex(void) {
+	static std::mutex m;
+	return (m);
+}
+
+static std::vector<ThreadTimeline*>&
+registry(void) {
+	static std::vector<ThreadTimeline*> timelines;
+	return (timelines);
+}
+
+static std::vector<RetiredTimeline>&
+retired(void) {
+	static std::vector<RetiredTimeline> timelines;
+	return (timelines);
+}
+
+
+// ---------------------------------------------------------------- chronological
+// the events of a ring buffer, oldest first
+
+static std::vector<TimelineEvent>
+chronological(const ThreadTimeline& timeline) {
+	std::vector<TimelineEvent> events;
+
+	if (timeline.num_recorded <= (uint64_t)timeline.events.size())
+		events.assign(timeline.events.begin(), timeline.events.begin() + timeline.num_recorded);
+	else {
+		size_t oldest = timeline.num_recorded % timeline.events.size();
+		events.assign(timeline.events.begin() + oldest, timeline.events.end());
+		events.insert(events.end(), timeline.events.begin(), timeline.events.begin() + oldest);
+	}
+
+	return (events);
+}
+
+
+// ---------------------------------------------------------------- ThreadTimeline constructor
+
+ThreadTimeline::ThreadTimeline(void)
+	: 	num_recorded(0)
+{
+	static int next_tid = 1;
+
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	tid = next_tid++;
+	registry().push_back(this);
+}
+
+
+// ---------------------------------------------------------------- ThreadTimeline destructor
+
+ThreadTimeline::~ThreadTimeline(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	std::vector<ThreadTimeline*>& timelines = registry();
+
+	if (num_recorded > 0) {
+		RetiredTimeline rt = {tid, thread_name, chronological(*this)};
+		retired().push_back(rt);
+	}
+
+	timelines.erase(std::remove(timelines.begin(), timelines.end(), this), timelines.end());
+}
+
+
+// ---------------------------------------------------------------- enable
+
+void
+Timeline::enable(void) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+
+	for (ThreadTimeline* timeline : registry())
+		timeline->num_recorded = 0;
+
+	retired().clear();
+	epoch = std::chrono::steady_clock::now();
+	is_enabled.store(true);
+}
+
+
+// ---------------------------------------------------------------- disable
+
+void
+Timeline::disable(void) {
+	is_enabled.store(false);
+}
+
+
+// ---------------------------------------------------------------- set_thread_name
+
+void
+Timeline::set_thread_name(const std::string& name) {
+	local().thread_name = name;
+}
+
+
+// ---------------------------------------------------------------- write_string
+
+static void
+write_string(std::ostream& out, const std::string& s) {
+	out << '"';
+
+	for (char c : s) {
+		if (c == '"' || c == '\\')
+			out << '\\';
+		out << c;
+	}
+
+	out << '"';
+}
+
+
+// ---------------------------------------------------------------- write_events
+
+static void
+write_events(std::ostream& out, const int tid, const std::string& thread_name,
+			 const std::vector<TimelineEvent>& events, bool& first) {
+	if (!thread_name.empty()) {
+		out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+			<< ",\"args\":{\"name\":";
+		write_string(out, thread_name);
+		out << "}}";
+		first = false;
+	}
+
+	for (const TimelineEvent& e : events) {
+		out << (first ? "\n" : ",\n") << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+			<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+			<< ",\"ts\":" << e.begin_ns / 1000 << "." << std::setw(3) << std::setfill('0') << e.begin_ns % 1000
+			<< ",\"dur\":" << e.duration_ns / 1000 << "." << std::setw(3) << e.duration_ns % 1000 << std::setfill(' ');
+
+		if (e.arg >= 0)
+			out << ",\"args\":{\"arg\":" << e.arg << "}";
+
+		out << "}";
+		first = false;
+	}
+}
+
+
+// ---------------------------------------------------------------- write_chrome_trace
+// timestamps are in microseconds, as the format requires
+
+void
+Timeline::write_chrome_trace(std::ostream& out) {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	bool first = true;
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	for (const RetiredTimeline& rt : retired())
+		write_events(out, rt.tid, rt.thread_name, rt.events, first);
+
+	for (ThreadTimeline* timeline : registry())
+		if (timeline->num_recorded > 0)
+			write_events(out, timeline->tid, timeline->thread_name, chronological(*timeline), first);
+
+	out << "\n]}\n";
+}
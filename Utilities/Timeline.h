@@ -0,0 +1,188 @@
+#ifndef __TIMELINE__
+#define __TIMELINE__
+
+// This file contains the declaration of the render timeline, an event tracer whose output loads
+// into chrome://tracing or the Perfetto UI (Chrome trace JSON)
+// Each thread appends complete events (name, begin time, duration) to its own fixed-size ring buffer,
+// so recording never locks or allocates; when a buffer wraps, its oldest events are dropped.
+// Recording is off until Timeline::enable is called, and costs one branch per scope while off.
+// Without RT_TIMELINE the TIMELINE_ macros expand to nothing.
+// Event names and categories must be string literals: only the pointers are stored.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------- struct TimelineEvent
+
+struct TimelineEvent {
+	const char*		name;
+	const char*		category;
+	uint64_t		begin_ns;			// since Timeline::enable
+	uint64_t		duration_ns;
+	int64_t			arg;				// e.g. a tile index, -1 for none
+};
+
+
+//----------------------------------------------------------------------------- class ThreadTimeline
+// the per-thread ring buffer behind Timeline::local
+
+class ThreadTimeline {
+	public:
+
+		std::vector<TimelineEvent>	events;
+		uint64_t					num_recorded;		// the next write goes to events[num_recorded % capacity]
+		int							tid;
+		std::string					thread_name;
+
+		ThreadTimeline(void);
+
+		~ThreadTimeline(void);
+
+		void
+		record(const TimelineEvent& event);
+};
+
+
+//----------------------------------------------------------------------------- class Timeline
+// enable, disable and write_chrome_trace must not run while other threads are recording
+
+class Timeline {
+	public:
+
+		static const int	buffer_capacity = 1 << 16;		// events per thread
+
+		static void							// clears all buffers and starts recording
+		enable(void);
+
+		static void
+		disable(void);
+
+		static bool
+		enabled(void);
+
+		static uint64_t						// nanoseconds since enable
+		now_ns(void);
+
+		static ThreadTimeline&
+		local(void);
+
+		static void							// names the calling thread's track in the viewer
+		set_thread_name(const std::string& name);
+
+		static void
+		write_chrome_trace(std::ostream& out);
+
+	private:
+
+		static std::atomic<bool>						is_enabled;
+		static std::chrono::steady_clock::time_point	epoch;
+};
+
+
+//----------------------------------------------------------------------------- class TimelineScope
+// records one complete event covering its own lifetime
+
+class TimelineScope {
+	public:
+
+		TimelineScope(const char* name, const char* category, const int64_t arg = -1);
+
+		~TimelineScope(void);
+
+	private:
+
+		const char*		name;			// NULL if the timeline was off when the scope began
+		const char*		category;
+		int64_t			arg;
+		uint64_t		begin_ns;
+};
+
+
+// ---------------------------------------------------------------- enabled
+
+inline bool
+Timeline::enabled(void) {
+	return (is_enabled.load(std::memory_order_relaxed));
+}
+
+
+// ---------------------------------------------------------------- now_ns
+
+inline uint64_t
+Timeline::now_ns(void) {
+	return (std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+
+// ---------------------------------------------------------------- local
+
+inline ThreadTimeline&
+Timeline::local(void) {
+	static thread_local ThreadTimeline tls;
+	return (tls);
+}
+
+
+// ---------------------------------------------------------------- record
+
+inline void
+ThreadTimeline::record(const TimelineEvent& event) {
+	if (events.empty())
+		events.resize(Timeline::buffer_capacity);		// first event of this thread
+
+	events[num_recorded++ % Timeline::buffer_capacity] = event;
+}
+
+
+// ---------------------------------------------------------------- TimelineScope constructor
+
+inline
+TimelineScope::TimelineScope(const char* _name, const char* _category, const int64_t _arg)
+	: 	name(NULL),
+		category(_category),
+		arg(_arg),
+		begin_ns(0)
+{
+	if (Timeline::enabled()) {
+		name 		= _name;
+		begin_ns 	= Timeline::now_ns();
+	}
+}
+
+
+// ---------------------------------------------------------------- TimelineScope destructor
+
+inline
+TimelineScope::~TimelineScope(void) {
+	if (name && Timeline::enabled()) {
+		TimelineEvent event = {name, category, begin_ns, Timeline::now_ns() - begin_ns, arg};
+		Timeline::local().record(event);
+	}
+}
+
+
+//----------------------------------------------------------------------------- macros
+
+#ifdef RT_TIMELINE
+
+#define TIMELINE_CONCAT_IMPL(a, b)			a##b
+#define TIMELINE_CONCAT(a, b)				TIMELINE_CONCAT_IMPL(a, b)
+
+#define TIMELINE_SCOPE(name, category)		TimelineScope TIMELINE_CONCAT(timeline_scope_, __LINE__)(name, category)
+#define TIMELINE_SCOPE_ARG(name, category, arg)	\
+	TimelineScope TIMELINE_CONCAT(timeline_scope_, __LINE__)(name, category, arg)
+#define TIMELINE_THREAD_NAME(name)			Timeline::set_thread_name(name)
+
+#else
+
+#define TIMELINE_SCOPE(name, category)			((void)0)
+#define TIMELINE_SCOPE_ARG(name, category, arg)	((void)0)
+#define TIMELINE_THREAD_NAME(name)				((void)0)
+
+#endif
+
+#endif
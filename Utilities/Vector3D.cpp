@@ -1,4 +1,6 @@
-// This file contains the definition of the class Vector3D
+// This file contains the definition of the class template Vector3
+// It is explicitly instantiated for double (Vector3D) at the end of the file; Vector3F is a specialization
+// whose remaining members are defined before the instantiations
 
 #include <cmath>
 
@@ -8,25 +10,29 @@
 
 // ---------------------------------------------------------- default constructor
 
-Vector3D::Vector3D(void)
+template <typename T>
+Vector3<T>::Vector3(void)
 	 : x(0.0), y(0.0), z(0.0)							
 {}
 
 // ---------------------------------------------------------- constructor
 
-Vector3D::Vector3D(double a)
+template <typename T>
+Vector3<T>::Vector3(T a)
 	 : x(a), y(a), z(a)							
 {}
 
 // ---------------------------------------------------------- constructor
 
-Vector3D::Vector3D(double _x, double _y, double _z)	 
+template <typename T>
+Vector3<T>::Vector3(T _x, T _y, T _z)	 
 	: x(_x), y(_y), z(_z)
 {}
 
 // ---------------------------------------------------------- copy constructor
 
-Vector3D::Vector3D(const Vector3D& vector)
+template <typename T>
+Vector3<T>::Vector3(const Vector3& vector)
 	: x(vector.x), y(vector.y), z(vector.z)
 {}
 
@@ -34,7 +40,8 @@ Vector3D::Vector3D(const Vector3D& vector)
 // ---------------------------------------------------------- constructor
 // constructs a vector from a normal
 
-Vector3D::Vector3D(const Normal& n)	 
+template <typename T>
+Vector3<T>::Vector3(const Normal3<T>& n)	 
 	: x(n.x), y(n.y), z(n.z)
 {}
 
@@ -42,22 +49,25 @@ Vector3D::Vector3D(const Normal& n)
 // constructs a vector from a point
 // this is used in the ConcaveHemisphere hit functions
 
-Vector3D::Vector3D(const Point3D& p)	 
+template <typename T>
+Vector3<T>::Vector3(const Point3<T>& p)	 
 	: x(p.x), y(p.y), z(p.z)
 {}
 
 
 // ---------------------------------------------------------- destructor
 
-Vector3D::~Vector3D (void) 							
+template <typename T>
+Vector3<T>::~Vector3 (void) 							
 {}
 
 
 
 // ---------------------------------------------------------- assignment operator
 
-Vector3D& 
-Vector3D::operator= (const Vector3D& rhs) {
+template <typename T>
+Vector3<T>& 
+Vector3<T>::operator= (const Vector3& rhs) {
 	if (this == &rhs)
 		return (*this);
 
@@ -70,8 +80,9 @@ Vector3D::operator= (const Vector3D& rhs) {
 // ----------------------------------------------------------- assignment operator
 // assign a Normal to a vector
 
-Vector3D& 
-Vector3D::operator= (const Normal& rhs) {
+template <typename T>
+Vector3<T>& 
+Vector3<T>::operator= (const Normal3<T>& rhs) {
 	x = rhs.x; y = rhs.y; z = rhs.z;
 	return (*this);
 }
@@ -80,8 +91,9 @@ Vector3D::operator= (const Normal& rhs) {
 // ---------------------------------------------------------- assignment operator 
 // assign a point to a vector
 
-Vector3D& 												
-Vector3D::operator= (const Point3D& rhs) {
+template <typename T>
+Vector3<T>& 												
+Vector3<T>::operator= (const Point3<T>& rhs) {
 	x = rhs.x; y = rhs.y; z = rhs.z;
 	return (*this);
 }
@@ -90,18 +102,20 @@ Vector3D::operator= (const Point3D& rhs) {
 // ----------------------------------------------------------  length
 // length of the vector
 
-double													
-Vector3D::length(void) {
-	return (sqrt(x * x + y * y + z * z));
+template <typename T>
+T													
+Vector3<T>::length(void) {
+	return (std::sqrt(x * x + y * y + z * z));
 }
 
 
 // ----------------------------------------------------------  normalize
 // converts the vector to a unit vector
 
+template <typename T>
 void 													
-Vector3D::normalize(void) {	
-	double length = sqrt(x * x + y * y + z * z);
+Vector3<T>::normalize(void) {	
+	T length = std::sqrt(x * x + y * y + z * z);
 	x /= length; y /= length; z /= length;
 }
 
@@ -109,9 +123,10 @@ Vector3D::normalize(void) {
 // ----------------------------------------------------------  hat
 // converts the vector to a unit vector and returns the vector
 
-Vector3D& 													
-Vector3D::hat(void) {	
-	double length = sqrt(x * x + y * y + z * z);
+template <typename T>
+Vector3<T>& 													
+Vector3<T>::hat(void) {	
+	T length = std::sqrt(x * x + y * y + z * z);
 	x /= length; y /= length; z /= length;
 	return (*this);
 } 
@@ -122,9 +137,56 @@ Vector3D::hat(void) {
 // ----------------------------------------------------------  operator* 
 // multiplication by a matrix on the left
 
-Vector3D 
-operator* (const Matrix& mat, const Vector3D& v) {
-	return (Point3D(mat.m[0][0] * v.x + mat.m[0][1] * v.y + mat.m[0][2] * v.z,
-					mat.m[1][0] * v.x + mat.m[1][1] * v.y + mat.m[1][2] * v.z,
-					mat.m[2][0] * v.x + mat.m[2][1] * v.y + mat.m[2][2] * v.z));
+template <typename T>
+Vector3<T> 
+operator* (const Matrix4<T>& mat, const Vector3<T>& v) {
+	return (Vector3<T>(	mat.m[0][0] * v.x + mat.m[0][1] * v.y + mat.m[0][2] * v.z,
+						mat.m[1][0] * v.x + mat.m[1][1] * v.y + mat.m[1][2] * v.z,
+						mat.m[2][0] * v.x + mat.m[2][1] * v.y + mat.m[2][2] * v.z));
 }
+
+
+// constructors and assignments of Vector3<float> that need Normal3 and Point3
+
+// ---------------------------------------------------------- constructor
+// constructs a vector from a normal
+
+Vector3<float>::Vector3(const Normal3<float>& n) {
+	f4_store(&x, f4_set(n.x, n.y, n.z, 0.0f));
+}
+
+
+// ---------------------------------------------------------- constructor
+// constructs a vector from a point
+
+Vector3<float>::Vector3(const Point3<float>& p) {
+	f4_store(&x, f4_set(p.x, p.y, p.z, 0.0f));
+}
+
+
+// ----------------------------------------------------------- assignment operator
+// assign a Normal to a vector
+
+Vector3<float>&
+Vector3<float>::operator= (const Normal3<float>& rhs) {
+	f4_store(&x, f4_set(rhs.x, rhs.y, rhs.z, 0.0f));
+	return (*this);
+}
+
+
+// ---------------------------------------------------------- assignment operator
+// assign a point to a vector
+
+Vector3<float>&
+Vector3<float>::operator= (const Point3<float>& rhs) {
+	f4_store(&x, f4_set(rhs.x, rhs.y, rhs.z, 0.0f));
+	return (*this);
+}
+
+
+// explicit instantiations
+
+template class Vector3<double>;
+
+template Vector3<double> operator* (const Matrix4<double>& mat, const Vector3<double>& v);
+template Vector3<float> operator* (const Matrix4<float>& mat, const Vector3<float>& v);
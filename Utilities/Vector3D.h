@@ -1,158 +1,461 @@
 #ifndef __VECTOR_3D__
 #define __VECTOR_3D__
 
-// This file contains the defintion of the class Vector3D
+// This file contains the defintion of the class template Vector3
+// Vector3 is templated on its scalar type. Vector3D, the double instantiation, is used for world-space
+// geometry and shading; Vector3F, the float instantiation, is used by the intersection code.
+// Conversions between the two are explicit.
+// Vector3F is specialized below to store its components with a padding lane in 16 aligned bytes,
+// so that its operators work on all four lanes at once; see Simd.h
+
+#include <cmath>
 
 #include "Matrix.h"
+#include "Simd.h"
 
-class Normal;
-class Point3D;
+template <typename T> class Normal3;
+template <typename T> class Point3;
 
-//----------------------------------------- class Vector3D
+//----------------------------------------- class Vector3
 
-class Vector3D {
+template <typename T>
+class Vector3 {
 	public:
-	
-		double	x, y, z;
+
+		typedef T Scalar;
+
+		T	x, y, z;
 
 	public:
-	
-		Vector3D(void);											// default constructor
-		Vector3D(double a);										// constructor
-		Vector3D(double _x, double _y, double _z);				// constructor
-		Vector3D(const Vector3D& v);							// copy constructor
-		Vector3D(const Normal& n);								// constructs a vector from a Normal
-		Vector3D(const Point3D& p);								// constructs a vector from a point
-
-		~Vector3D (void);										// destructor
-
-		Vector3D& 												// assignment operator
-		operator= (const Vector3D& rhs);
-		
-		Vector3D& 												// assign a Normal to a vector
-		operator= (const Normal& rhs); 
-		
-		Vector3D& 												// assign a Point3D to a vector
-		operator= (const Point3D& rhs); 
-		
-		Vector3D												// unary minus
-		operator- (void) const;									
-				
-		double													// length
+
+		Vector3(void);											// default constructor
+		Vector3(T a);											// constructor
+		Vector3(T _x, T _y, T _z);								// constructor
+		Vector3(const Vector3& v);								// copy constructor
+		Vector3(const Normal3<T>& n);							// constructs a vector from a Normal
+		Vector3(const Point3<T>& p);							// constructs a vector from a point
+
+		template <typename U>									// converts between scalar types
+		explicit Vector3(const Vector3<U>& v);
+
+		~Vector3 (void);										// destructor
+
+		Vector3& 												// assignment operator
+		operator= (const Vector3& rhs);
+
+		Vector3& 												// assign a Normal to a vector
+		operator= (const Normal3<T>& rhs);
+
+		Vector3& 												// assign a Point3D to a vector
+		operator= (const Point3<T>& rhs);
+
+		Vector3													// unary minus
+		operator- (void) const;
+
+		T														// length
 		length(void);
-		
-		double													// square of the length
+
+		T														// square of the length
 		len_squared(void);
-		
-		Vector3D												// multiplication by a double on the right
-		operator* (const double a) const;
-				
-		Vector3D												// division by a double
-		operator/ (const double a) const;
-		
-		Vector3D												// addition
-		operator+ (const Vector3D& v) const;
-		
-		Vector3D& 												// compound addition
-		operator+= (const Vector3D& v);					
-		
-		Vector3D												// subtraction
-		operator- (const Vector3D& v) const;					
-		
-		double 													// dot product							
-		operator* (const Vector3D& b) const;
-		
-		Vector3D 												// cross product				
-		operator^ (const Vector3D& v) const;
-		
+
+		Vector3													// multiplication by a scalar on the right
+		operator* (const T a) const;
+
+		Vector3													// division by a scalar
+		operator/ (const T a) const;
+
+		Vector3													// addition
+		operator+ (const Vector3& v) const;
+
+		Vector3& 												// compound addition
+		operator+= (const Vector3& v);
+
+		Vector3													// subtraction
+		operator- (const Vector3& v) const;
+
+		T 														// dot product
+		operator* (const Vector3& b) const;
+
+		Vector3 												// cross product
+		operator^ (const Vector3& v) const;
+
 		void 													// convert vector to a unit vector
-		normalize(void); 
-		
-		Vector3D& 												// return a unit vector, and normalize the vector												
+		normalize(void);
+
+		Vector3& 												// return a unit vector, and normalize the vector
 		hat(void);
 };
 
+typedef Vector3<double>	Vector3D;
+typedef Vector3<float>	Vector3F;
+
+
+
+//----------------------------------------- class Vector3<float>
+// the same interface as Vector3, with SSE storage
+
+template <>
+class alignas(16) Vector3<float> {
+	public:
+
+		typedef float Scalar;
+
+		float	x, y, z;
+		float	pad;											// always 0
+
+	public:
+
+		Vector3(void);											// default constructor
+		Vector3(float a);										// constructor
+		Vector3(float _x, float _y, float _z);					// constructor
+		Vector3(const Vector3& v);								// copy constructor
+		Vector3(const Normal3<float>& n);						// constructs a vector from a Normal
+		Vector3(const Point3<float>& p);						// constructs a vector from a point
+
+		template <typename U>									// converts between scalar types
+		explicit Vector3(const Vector3<U>& v);
+
+		~Vector3 (void);										// destructor
+
+		Vector3& 												// assignment operator
+		operator= (const Vector3& rhs);
+
+		Vector3& 												// assign a Normal to a vector
+		operator= (const Normal3<float>& rhs);
+
+		Vector3& 												// assign a Point3D to a vector
+		operator= (const Point3<float>& rhs);
+
+		Vector3													// unary minus
+		operator- (void) const;
+
+		float													// length
+		length(void);
+
+		float													// square of the length
+		len_squared(void);
+
+		Vector3													// multiplication by a scalar on the right
+		operator* (const float a) const;
+
+		Vector3													// division by a scalar
+		operator/ (const float a) const;
+
+		Vector3													// addition
+		operator+ (const Vector3& v) const;
+
+		Vector3& 												// compound addition
+		operator+= (const Vector3& v);
+
+		Vector3													// subtraction
+		operator- (const Vector3& v) const;
+
+		float 													// dot product
+		operator* (const Vector3& b) const;
+
+		Vector3 												// cross product
+		operator^ (const Vector3& v) const;
+
+		void 													// convert vector to a unit vector
+		normalize(void);
+
+		Vector3& 												// return a unit vector, and normalize the vector
+		hat(void);
+
+	private:
+
+		Float4													// the four lanes
+		lanes(void) const;
+
+		static Vector3											// a vector from four lanes
+		from_lanes(const Float4 a);
+};
+
+
+// inlined member functions of Vector3<float>
+// the constructors from Normal3<float> and Point3<float> are in Vector3D.cpp
+
+// ------------------------------------------------------------------------ lanes
+
+inline Float4
+Vector3<float>::lanes(void) const {
+	return (f4_load(&x));
+}
+
+
+// ------------------------------------------------------------------------ from_lanes
+
+inline Vector3<float>
+Vector3<float>::from_lanes(const Float4 a) {
+	Vector3 v;
+	f4_store(&v.x, a);
+	return (v);
+}
+
+
+// ------------------------------------------------------------------------ default constructor
+
+inline
+Vector3<float>::Vector3(void) {
+	f4_store(&x, f4_set(0.0f, 0.0f, 0.0f, 0.0f));
+}
+
+
+// ------------------------------------------------------------------------ constructor
+
+inline
+Vector3<float>::Vector3(float a) {
+	f4_store(&x, f4_splat3(a));
+}
+
+
+// ------------------------------------------------------------------------ constructor
+
+inline
+Vector3<float>::Vector3(float _x, float _y, float _z) {
+	f4_store(&x, f4_set(_x, _y, _z, 0.0f));
+}
+
+
+// ------------------------------------------------------------------------ copy constructor
+
+inline
+Vector3<float>::Vector3(const Vector3& v) {
+	f4_store(&x, v.lanes());
+}
+
+
+// ------------------------------------------------------------------------ converting constructor
+
+template <typename U>
+inline
+Vector3<float>::Vector3(const Vector3<U>& v) {
+	f4_store(&x, f4_set((float)v.x, (float)v.y, (float)v.z, 0.0f));
+}
+
+
+// ------------------------------------------------------------------------ destructor
+
+inline
+Vector3<float>::~Vector3(void)
+{}
+
+
+// ------------------------------------------------------------------------ assignment operator
+
+inline Vector3<float>&
+Vector3<float>::operator= (const Vector3& rhs) {
+	f4_store(&x, rhs.lanes());
+	return (*this);
+}
+
+
+// ------------------------------------------------------------------------ unary minus
+
+inline Vector3<float>
+Vector3<float>::operator- (void) const {
+	return (from_lanes(f4_neg(lanes())));
+}
+
+
+// ------------------------------------------------------------------------ length
+
+inline float
+Vector3<float>::length(void) {
+	return (std::sqrt(f4_dot3(lanes(), lanes())));
+}
+
+
+// ------------------------------------------------------------------------ len_squared
+
+inline float
+Vector3<float>::len_squared(void) {
+	return (f4_dot3(lanes(), lanes()));
+}
+
+
+// ------------------------------------------------------------------------ operator*
+// multiplication by a scalar on the right
+
+inline Vector3<float>
+Vector3<float>::operator* (const float a) const {
+	return (from_lanes(f4_mul(lanes(), a)));
+}
+
+
+// ------------------------------------------------------------------------ operator/
+// division by a scalar
+
+inline Vector3<float>
+Vector3<float>::operator/ (const float a) const {
+	return (from_lanes(f4_div(lanes(), a)));
+}
+
+
+// ------------------------------------------------------------------------ operator+
+// addition
+
+inline Vector3<float>
+Vector3<float>::operator+ (const Vector3& v) const {
+	return (from_lanes(f4_add(lanes(), v.lanes())));
+}
+
+
+// ------------------------------------------------------------------------ operator+=
+// compound addition
+
+inline Vector3<float>&
+Vector3<float>::operator+= (const Vector3& v) {
+	f4_store(&x, f4_add(lanes(), v.lanes()));
+	return (*this);
+}
+
+
+// ------------------------------------------------------------------------ operator-
+// subtraction
+
+inline Vector3<float>
+Vector3<float>::operator- (const Vector3& v) const {
+	return (from_lanes(f4_sub(lanes(), v.lanes())));
+}
+
+
+// ------------------------------------------------------------------------ operator*
+// dot product
+
+inline float
+Vector3<float>::operator* (const Vector3& v) const {
+	return (f4_dot3(lanes(), v.lanes()));
+}
+
+
+// ------------------------------------------------------------------------ operator^
+// cross product
+
+inline Vector3<float>
+Vector3<float>::operator^ (const Vector3& v) const {
+	return (from_lanes(f4_cross3(lanes(), v.lanes())));
+}
+
+
+// ------------------------------------------------------------------------ normalize
+// converts the vector to a unit vector
+
+inline void
+Vector3<float>::normalize(void) {
+	f4_store(&x, f4_div(lanes(), std::sqrt(f4_dot3(lanes(), lanes()))));
+}
+
+
+// ------------------------------------------------------------------------ hat
+// converts the vector to a unit vector and returns the vector
+
+inline Vector3<float>&
+Vector3<float>::hat(void) {
+	normalize();
+	return (*this);
+}
+
 
 // inlined member functions
 
+// ------------------------------------------------------------------------ converting constructor
+
+template <typename T>
+template <typename U>
+inline
+Vector3<T>::Vector3(const Vector3<U>& v)
+	: x((T)v.x), y((T)v.y), z((T)v.z)
+{}
+
+
 // ------------------------------------------------------------------------ unary minus
 // this does not change the current vector
 // this allows ShadeRec objects to be declared as constant arguments in many shading
 // functions that reverse the direction of a ray that's stored in the ShadeRec object
 
-inline Vector3D 
-Vector3D::operator- (void) const {
-	return (Vector3D(-x, -y, -z));    
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator- (void) const {
+	return (Vector3(-x, -y, -z));
 }
 
 
 // ---------------------------------------------------------------------  len_squared
 // the square of the length
 
-inline double													
-Vector3D::len_squared(void) {	
+template <typename T>
+inline T
+Vector3<T>::len_squared(void) {
 	return (x * x + y * y + z * z);
 }
 
 
 // ----------------------------------------------------------------------- operator*
-// multiplication by a double on the right
+// multiplication by a scalar on the right
 
-inline Vector3D
-Vector3D::operator* (const double a) const {	
-	return (Vector3D(x * a, y * a, z * a));	
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator* (const T a) const {
+	return (Vector3(x * a, y * a, z * a));
 }
 
 // ----------------------------------------------------------------------- operator/
-// division by a double
+// division by a scalar
 
-inline Vector3D
-Vector3D::operator/ (const double a) const {	
-	return (Vector3D(x / a, y / a, z / a));	
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator/ (const T a) const {
+	return (Vector3(x / a, y / a, z / a));
 }
 
 
 // ----------------------------------------------------------------------- operator+
 // addition
 
-inline Vector3D
-Vector3D::operator+ (const Vector3D& v) const {
-	return (Vector3D(x + v.x, y + v.y, z + v.z));
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator+ (const Vector3& v) const {
+	return (Vector3(x + v.x, y + v.y, z + v.z));
 }
 
 
 // ----------------------------------------------------------------------- operator-
 // subtraction
 
-inline Vector3D
-Vector3D::operator- (const Vector3D& v) const {
-	return (Vector3D(x - v.x, y - v.y, z - v.z));
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator- (const Vector3& v) const {
+	return (Vector3(x - v.x, y - v.y, z - v.z));
 }
 
 
 // ----------------------------------------------------------------------- operator*
 // dot product
 
-inline double 
-Vector3D::operator* (const Vector3D& v) const {
+template <typename T>
+inline T
+Vector3<T>::operator* (const Vector3& v) const {
 	return (x * v.x + y * v.y + z * v.z);
-} 
+}
 
 
 // ----------------------------------------------------------------------- operator^
 // cross product
 
-inline Vector3D 									
-Vector3D::operator^ (const Vector3D& v) const {
-	return (Vector3D(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x));
+template <typename T>
+inline Vector3<T>
+Vector3<T>::operator^ (const Vector3& v) const {
+	return (Vector3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x));
 }
 
 
 // ---------------------------------------------------------------------  operator+=
 // compound addition
 
-inline Vector3D& 
-Vector3D::operator+= (const Vector3D& v) {
+template <typename T>
+inline Vector3<T>&
+Vector3<T>::operator+= (const Vector3& v) {
 	x += v.x; y += v.y; z += v.z;
 	return (*this);
 }
@@ -163,27 +466,26 @@ Vector3D::operator+= (const Vector3D& v) {
 // inlined non-member function
 
 // ----------------------------------------------------------------------- operator*
-// multiplication by a double on the left
-
-Vector3D 
-operator* (const double a, const Vector3D& v);
+// multiplication by a scalar on the left
+// the scalar is not used to deduce T, so a float times a Vector3D works as it always has
 
-inline Vector3D 
-operator* (const double a, const Vector3D& v) {
-	return (Vector3D(a * v.x, a * v.y, a * v.z));	
+template <typename T>
+inline Vector3<T>
+operator* (const typename Vector3<T>::Scalar a, const Vector3<T>& v) {
+	return (v * a);
 }
 
 
 
 // non-inlined non-member function
 
-// ----------------------------------------------------------------------- operator* 
+// ----------------------------------------------------------------------- operator*
 // multiplication by a matrix on the left
 
-Vector3D 
-operator* (const Matrix& mat, const Vector3D& v);
+template <typename T>
+Vector3<T>
+operator* (const Matrix4<T>& mat, const Vector3<T>& v);
 
 
 #endif
 
-
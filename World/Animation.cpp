@@ -0,0 +1,190 @@
+// This file contains the definition of the class Animation
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "Animation.h"
+#include "World.h"
+#include "BVH.h"
+#include "GBuffer.h"
+#include "../GeometricObjects/Instance.h"
+
+// ----------------------------------------------------------------------------- same
+// exact comparisons: a camera or object that is held between keys gets the same values every frame
+
+static bool
+same(const Point3D& a, const Point3D& b) {
+	return (a.x == b.x && a.y == b.y && a.z == b.z);
+}
+
+static bool
+same(const Vector3D& a, const Vector3D& b) {
+	return (a.x == b.x && a.y == b.y && a.z == b.z);
+}
+
+
+// ----------------------------------------------------------------------------- default constructor
+
+Animation::Animation(void)
+	: 	camera_applied(false)
+{}
+
+
+// ----------------------------------------------------------------------------- add_camera_key
+
+void
+Animation::add_camera_key(const double time, const Point3D& eye, const Point3D& lookat) {
+	insert_key(camera_keys, CameraKey{time, eye, lookat});
+}
+
+
+// ----------------------------------------------------------------------------- add_object
+// the instance takes the object's place in the world, so it is deleted with the world
+
+int
+Animation::add_object(World& w, const int j) {
+	Instance* instance_ptr = dynamic_cast<Instance*>(w.objects[j]);
+
+	if (!instance_ptr) {
+		instance_ptr = new Instance(w.objects[j]);
+		instance_ptr->set_shadows(w.objects[j]->casts_shadows());
+		w.objects[j] = instance_ptr;
+	}
+
+	tracks.push_back(ObjectTrack{instance_ptr, {}, false, TransformKey()});
+
+	return ((int)tracks.size() - 1);
+}
+
+
+// ----------------------------------------------------------------------------- add_object_key
+
+void
+Animation::add_object_key(const int track, const double time, const Vector3D& scale, const Vector3D& rotation,
+						  const Vector3D& translation) {
+	insert_key(tracks[track].keys, TransformKey{time, scale, rotation, translation});
+}
+
+
+// ----------------------------------------------------------------------------- apply
+// the camera is only updated if the world has one
+
+int
+Animation::apply(World& w, const double time) {
+	int 	changed = 0;
+	int 	j;
+	double 	f;
+
+	if (w.camera_ptr && !camera_keys.empty()) {
+		find_keys(camera_keys, time, j, f);
+
+		const CameraKey& k0 = camera_keys[j];
+		const CameraKey& k1 = camera_keys[std::min(j + 1, (int)camera_keys.size() - 1)];
+		CameraKey camera = {time, lerp(k0.eye, k1.eye, f), lerp(k0.lookat, k1.lookat, f)};
+
+		if (!camera_applied || !same(camera.eye, last_camera.eye) || !same(camera.lookat, last_camera.lookat)) {
+			w.camera_ptr->set_eye(camera.eye);
+			w.camera_ptr->set_lookat(camera.lookat);
+			w.camera_ptr->compute_uvw();
+
+			last_camera 	= camera;
+			camera_applied 	= true;
+			changed 		|= kCameraChanged;
+		}
+	}
+
+	for (ObjectTrack& track : tracks) {
+		if (track.keys.empty())
+			continue;
+
+		TransformKey key = interpolate(track.keys, time);
+
+		if (track.applied && same(key.scale, track.last.scale) && same(key.rotation, track.last.rotation)
+			&& same(key.translation, track.last.translation))
+			continue;
+
+		Instance* instance_ptr = track.instance_ptr;
+
+		instance_ptr->set_identity();
+		instance_ptr->scale(key.scale.x, key.scale.y, key.scale.z);
+		instance_ptr->rotate_x(key.rotation.x);
+		instance_ptr->rotate_y(key.rotation.y);
+		instance_ptr->rotate_z(key.rotation.z);
+		instance_ptr->translate(key.translation);
+
+		track.last 		= key;
+		track.applied 	= true;
+		changed 		|= kObjectsChanged;
+	}
+
+	return (changed);
+}
+
+
+// ----------------------------------------------------------------------------- render_frames
+// reports, for every frame, its time, what apply updated and how long the render took
+// when objects have moved, the world's BVH, if it has one, is updated before the render, and the
+// times of its refit and of any rebuild are reported separately
+// when anything has changed, the world's G-buffer, if it has one, is invalidated
+
+void
+Animation::render_frames(World& w, const int num_frames, const double start, const double end,
+						 std::ostream& report) {
+	std::string output_file 	= w.output_file;
+	std::string checkpoint_file = w.checkpoint_file;
+
+	for (int frame = 0; frame < num_frames; frame++) {
+		double time 	= num_frames > 1 ? start + frame * (end - start) / (num_frames - 1) : start;
+		int changed 	= apply(w, time);
+		bool refitted 	= (changed & kObjectsChanged) && w.bvh_ptr;
+		bool rebuilt 	= refitted && w.bvh_ptr->update(w.num_threads);
+
+		if (changed && w.gbuffer_ptr)
+			w.gbuffer_ptr->invalidate();
+
+		w.output_file = frame_file(output_file, frame);
+
+		if (!checkpoint_file.empty())
+			w.checkpoint_file = frame_file(checkpoint_file, frame);
+
+		std::chrono::steady_clock::time_point frame_start = std::chrono::steady_clock::now();
+
+		w.render_scene();
+
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - frame_start;
+
+		report 	<< "frame " << frame << " time " << time << ":"
+				<< (changed & kCameraChanged ? " camera" : "")
+				<< (changed & kObjectsChanged ? " objects" : "")
+				<< (changed ? "" : " unchanged");
+
+		if (refitted)
+			report << ", bvh refit " << 1000.0 * w.bvh_ptr->get_refit_time() << " ms";
+
+		if (rebuilt)
+			report << ", rebuild " << 1000.0 * w.bvh_ptr->get_build_time() << " ms";
+
+		report << ", " << seconds.count() << " s, " << w.output_file << "\n";
+	}
+
+	w.output_file 		= output_file;
+	w.checkpoint_file 	= checkpoint_file;
+}
+
+
+// ----------------------------------------------------------------------------- frame_file
+
+std::string
+Animation::frame_file(const std::string& file_name, const int frame) {
+	char 					number[16];
+	std::string::size_type 	dot 	= file_name.rfind('.');
+	std::string::size_type 	slash 	= file_name.rfind('/');
+
+	snprintf(number, sizeof(number), "_%04d", frame);
+
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return (file_name + number);
+
+	return (file_name.substr(0, dot) + number + file_name.substr(dot));
+}
@@ -0,0 +1,77 @@
+#ifndef __ANIMATION__
+#define __ANIMATION__
+
+// This file contains the declaration of the class Animation, which renders a sequence of frames of
+// a scene whose camera and objects move between keyframes
+// The camera's eye and lookat, and the scale, rotation and translation of animated objects, are
+// interpolated linearly between the keys around a frame's time, and held at the first and last keys
+// outside them. The frames are rendered by one World, which keeps its materials, lights and samplers
+// from frame to frame: apply only resets the camera basis and the transforms whose interpolated
+// values differ from those of the previous frame.
+// An animated object is wrapped in an Instance, which the static dispatch path doesn't handle, so
+// the animation must be set up before enable_static_dispatch is called.
+// Each frame is written to, and checkpointed in, files named after the world's with the frame number.
+// If the world has a BVH, render_frames refits it, or rebuilds it, after objects have moved.
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../Utilities/Keyframes.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Vector3D.h"
+
+class World;
+class Instance;
+
+//------------------------------------------------------------------------------------ class Animation
+
+class Animation {
+	public:
+
+		static constexpr int	kCameraChanged 	= 1;		// returned by apply
+		static constexpr int	kObjectsChanged = 2;
+
+		Animation(void);
+
+		void									// the keys can be added in any order
+		add_camera_key(const double time, const Point3D& eye, const Point3D& lookat);
+
+		int										// wraps object j of the world in an Instance, unless it is one, and returns its track
+		add_object(World& w, const int j);
+
+		void									// the object is scaled, rotated about x, y and z by rotation degrees, then translated
+		add_object_key(const int track, const double time, const Vector3D& scale, const Vector3D& rotation,
+					   const Vector3D& translation);
+
+		int										// sets the world's camera and objects for time, returns what was updated
+		apply(World& w, const double time);
+
+		void									// frame f is at start + f * (end - start) / (num_frames - 1)
+		render_frames(World& w, const int num_frames, const double start, const double end, std::ostream& report);
+
+		static std::string						// image.ppm becomes image_0003.ppm for frame 3
+		frame_file(const std::string& file_name, const int frame);
+
+	private:
+
+		struct CameraKey {
+			double		time;
+			Point3D		eye;
+			Point3D		lookat;
+		};
+
+		struct ObjectTrack {
+			Instance*					instance_ptr;		// owned by the world
+			std::vector<TransformKey>	keys;
+			bool						applied;
+			TransformKey				last;				// the values applied last
+		};
+
+		std::vector<CameraKey>		camera_keys;
+		bool						camera_applied;
+		CameraKey					last_camera;
+		std::vector<ObjectTrack>	tracks;
+};
+
+#endif
@@ -0,0 +1,795 @@
+// This file contains the definition of the class BVH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+#include "BVH.h"
+#include "../Utilities/Constants.h"
+#include "../Utilities/Stats.h"
+
+static const int kMaxSAHDepth 		= 64;		// below this depth, nodes are split at the median, which bounds the depth
+static const int kStackSize 		= 128;		// enough for kMaxSAHDepth plus log2 of any number of objects
+static const int kMinParallelNodes 	= 4096;		// smaller trees are refitted on the calling thread
+
+// ---------------------------------------------------------------- coordinate
+
+static inline double
+coordinate(const Point3D& p, const int axis) {
+	return (axis == 0 ? p.x : (axis == 1 ? p.y : p.z));
+}
+
+
+// ---------------------------------------------------------------- motion_area
+// the mean of the areas of a moving box at the ends of its range, which bounds its mean area over it
+
+static inline double
+motion_area(const BBox& b0, const BBox& b1) {
+	return (0.5 * (b0.surface_area() + b1.surface_area()));
+}
+
+
+// ---------------------------------------------------------------- same
+
+static inline bool
+same(const BBox& a, const BBox& b) {
+	return (a.p_min.x == b.p_min.x && a.p_min.y == b.p_min.y && a.p_min.z == b.p_min.z
+			&& a.p_max.x == b.p_max.x && a.p_max.y == b.p_max.y && a.p_max.z == b.p_max.z);
+}
+
+
+// ---------------------------------------------------------------- constructor
+
+BVH::BVH(const std::vector<GeometricObject*>& objects, const double _rebuild_threshold)
+	: 	rebuild_threshold(_rebuild_threshold),
+		build_cost(0.0),
+		refit_time(0.0),
+		build_time(0.0)
+{
+	for (int j = 0; j < (int)objects.size(); j++) {
+		BBox bounds;
+
+		if (objects[j]->get_bounds(bounds)) {
+			bounded.push_back(objects[j]);
+			bounded_ids.push_back(j);
+			object_bounds.push_back(bounds);
+		}
+		else {
+			unbounded.push_back(objects[j]);
+			unbounded_ids.push_back(j);
+		}
+	}
+
+	build();
+}
+
+
+// ---------------------------------------------------------------- nearest_hit
+
+const GeometricObject*
+BVH::nearest_hit(const Ray& ray, ShadeRec& sr, double& tmin) const {
+	return (motion.empty() ? find_nearest<false>(ray, sr, tmin) : find_nearest<true>(ray, sr, tmin));
+}
+
+
+// ---------------------------------------------------------------- any_hit
+
+bool
+BVH::any_hit(const Ray& ray, const double t_max) const {
+	return (motion.empty() ? find_any<false>(ray, t_max) : find_any<true>(ray, t_max));
+}
+
+
+// ---------------------------------------------------------------- hit_node
+// a timed node's box is interpolated to the ray's time, which is in the node's range: the root's range
+// is the whole shutter interval, and the traversal only enters the child of a temporal split whose
+// range holds the ray's time
+
+template <bool timed>
+inline bool
+BVH::hit_node(const int index, const Ray& ray, const Vector3D& inv_d, const double t_max) const {
+	if (!timed)
+		return (nodes[index].bounds.hit(ray, inv_d, t_max));
+
+	const NodeMotion& node_motion = motion[index];
+
+	return (nodes[index].bounds.hit(ray, inv_d, t_max, node_motion.delta_min, node_motion.delta_max,
+									(ray.time - node_motion.time_min) * node_motion.inv_span));
+}
+
+
+// ---------------------------------------------------------------- find_nearest
+// the same test as the loop in World::hit_objects, over the unbounded objects and then the tree.
+// The child on the side the ray comes from is visited first, and nodes beyond the nearest hit so far
+// are skipped. The hit functions return t in float, so objects that cross can be hit at exactly the
+// same t; the loop keeps the first object in the world's list, and so does this.
+
+template <bool timed>
+const GeometricObject*
+BVH::find_nearest(const Ray& ray, ShadeRec& sr, double& tmin) const {
+	const GeometricObject*	nearest_ptr 	= NULL;
+	int						nearest_id 		= -1;
+	Normal 					normal;
+	Point3D 				local_hit_point;
+	double					t;
+
+	tmin = kHugeValue;
+
+	auto test = [&](const GeometricObject* object_ptr, const int id) {
+		STATS_INC(STAT_INTERSECTION_TESTS);
+
+		if (object_ptr->hit(ray, t, sr) && (t < tmin || (t == tmin && id < nearest_id))) {
+			tmin 				= t;
+			nearest_ptr 		= object_ptr;
+			nearest_id 			= id;
+			normal 				= sr.normal;
+			local_hit_point 	= sr.local_hit_point;
+		}
+	};
+
+	for (int j = 0; j < (int)unbounded.size(); j++)
+		test(unbounded[j], unbounded_ids[j]);
+
+	if (!nodes.empty()) {
+		Vector3D 	inv_d(1.0 / ray.d.x, 1.0 / ray.d.y, 1.0 / ray.d.z);
+		bool 		dir_is_neg[3] 	= {inv_d.x < 0.0, inv_d.y < 0.0, inv_d.z < 0.0};
+		int 		stack[kStackSize];
+		int 		stack_size 		= 0;
+		int 		index 			= 0;
+
+		while (true) {
+			const Node& node = nodes[index];
+
+			STATS_INC(STAT_TRAVERSAL_STEPS);
+
+			if (hit_node<timed>(index, ray, inv_d, tmin)) {
+				if (node.count > 0) {
+					for (int j = node.offset; j < node.offset + node.count; j++)
+						test(bounded[order[j]], bounded_ids[order[j]]);
+				}
+				else if (timed && motion[index].temporal) {
+					index = ray.time < motion[node.offset].time_min ? index + 1 : node.offset;
+					continue;
+				}
+				else if (dir_is_neg[node.axis]) {
+					stack[stack_size++] = index + 1;
+					index = node.offset;
+					continue;
+				}
+				else {
+					stack[stack_size++] = node.offset;
+					index = index + 1;
+					continue;
+				}
+			}
+
+			if (stack_size == 0)
+				break;
+
+			index = stack[--stack_size];
+		}
+	}
+
+	if (nearest_ptr) {
+		sr.normal 			= normal;
+		sr.local_hit_point 	= local_hit_point;
+	}
+
+	return (nearest_ptr);
+}
+
+
+// ---------------------------------------------------------------- find_any
+// stops at the first shadow casting object in range, so the traversal order doesn't matter
+
+template <bool timed>
+bool
+BVH::find_any(const Ray& ray, const double t_max) const {
+	double t;
+
+	for (const GeometricObject* object_ptr : unbounded)
+		if (object_ptr->casts_shadows() && object_ptr->shadow_hit(ray, t) && t < t_max)
+			return (true);
+
+	if (nodes.empty())
+		return (false);
+
+	Vector3D 	inv_d(1.0 / ray.d.x, 1.0 / ray.d.y, 1.0 / ray.d.z);
+	int 		stack[kStackSize];
+	int 		stack_size 	= 0;
+	int 		index 		= 0;
+
+	while (true) {
+		const Node& node = nodes[index];
+
+		if (hit_node<timed>(index, ray, inv_d, t_max)) {
+			if (node.count > 0) {
+				for (int j = 0; j < node.count; j++) {
+					const GeometricObject* object_ptr = bounded[order[node.offset + j]];
+
+					if (object_ptr->casts_shadows() && object_ptr->shadow_hit(ray, t) && t < t_max)
+						return (true);
+				}
+			}
+			else if (timed && motion[index].temporal) {
+				index = ray.time < motion[node.offset].time_min ? index + 1 : node.offset;
+				continue;
+			}
+			else {
+				stack[stack_size++] = node.offset;
+				index = index + 1;
+				continue;
+			}
+		}
+
+		if (stack_size == 0)
+			return (false);
+
+		index = stack[--stack_size];
+	}
+}
+
+
+// ---------------------------------------------------------------- update
+
+bool
+BVH::update(const int num_threads) {
+	refit(num_threads);
+
+	if (sah_cost() <= rebuild_threshold * build_cost)
+		return (false);
+
+	build();
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- sah_cost
+// the sum over the nodes of their area times their cost, over the root's area: the expected number
+// of object tests, with a node visit counted as kTraversalCost of them, for a ray that hits the root.
+// When objects move, the areas are motion_area, and a node's is weighted by the fraction of the
+// shutter interval that its range covers, as only rays at those times visit it.
+
+double
+BVH::sah_cost(void) const {
+	if (nodes.empty())
+		return (0.0);
+
+	if (!motion.empty()) {
+		double root_area = motion_area(nodes[0].bounds, motion[0].bounds1);
+
+		if (root_area == 0.0)
+			return ((double)order.size());
+
+		double cost = 0.0;
+
+		for (int j = 0; j < (int)nodes.size(); j++)
+			cost += motion_area(nodes[j].bounds, motion[j].bounds1) * (motion[j].time_max - motion[j].time_min)
+					* (nodes[j].count > 0 ? nodes[j].count : kTraversalCost);
+
+		return (cost / root_area);
+	}
+
+	double root_area = nodes[0].bounds.surface_area();
+
+	if (root_area == 0.0)
+		return ((double)bounded.size());
+
+	double cost = 0.0;
+
+	for (const Node& node : nodes)
+		cost += node.bounds.surface_area() * (node.count > 0 ? node.count : kTraversalCost);
+
+	return (cost / root_area);
+}
+
+
+// ---------------------------------------------------------------- build
+// from the objects' current bounds; the tree has times if any object's bounds change over the shutter
+// interval
+
+void
+BVH::build(void) {
+	STATS_TIMER(STAT_TIME_BVH_BUILD);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	int 					num_objects = bounded.size();
+	std::vector<Reference> 	refs(num_objects);
+	bool 					moving 		= false;
+
+	for (int j = 0; j < num_objects; j++) {
+		refs[j].object = j;
+
+		if (bounded[j]->get_motion_bounds(0.0, 1.0, refs[j].bounds0, refs[j].bounds1)) {
+			object_bounds[j] 	= bbox_union(refs[j].bounds0, refs[j].bounds1);
+			moving 				= moving || !same(refs[j].bounds0, refs[j].bounds1);
+		}
+		else
+			refs[j].bounds0 = refs[j].bounds1 = object_bounds[j];
+	}
+
+	nodes.clear();
+	motion.clear();
+	order.clear();
+
+	if (moving)
+		build_motion(refs, 0, num_objects, 0.0, 1.0, 0, kMaxTemporalSplits);
+	else if (num_objects > 0) {
+		order.resize(num_objects);
+		std::iota(order.begin(), order.end(), 0);
+
+		std::vector<Point3D> centroids(num_objects);
+
+		for (int j = 0; j < num_objects; j++)
+			centroids[j] = object_bounds[j].centroid();
+
+		nodes.reserve(2 * num_objects - 1);
+		build(centroids, 0, num_objects, 0);
+	}
+
+	build_cost = sah_cost();
+
+	std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+	build_time = seconds.count();
+}
+
+
+// ---------------------------------------------------------------- build
+// The centroids are binned along the axis where they spread most, and the node is split between the
+// bins where the SAH cost of the two sides is least. A node with few objects is a leaf if that is
+// cheaper than splitting it. Objects whose centroids coincide can't be binned and are split in half.
+
+int
+BVH::build(std::vector<Point3D>& centroids, const int begin, const int end, const int depth) {
+	int 	index 			= (int)nodes.size();
+	int 	num_objects 	= end - begin;
+	BBox 	bounds;
+	BBox 	centroid_bounds;
+
+	nodes.push_back(Node());
+
+	for (int j = begin; j < end; j++) {
+		bounds 			= bbox_union(bounds, object_bounds[order[j]]);
+		centroid_bounds = bbox_union(centroid_bounds, centroids[order[j]]);
+	}
+
+	nodes[index].bounds = bounds;
+
+	auto make_leaf = [&](void) {
+		nodes[index].offset = begin;
+		nodes[index].count 	= num_objects;
+		nodes[index].axis 	= 0;
+		return (index);
+	};
+
+	if (num_objects == 1)
+		return (make_leaf());
+
+	Vector3D 	extent 		= centroid_bounds.p_max - centroid_bounds.p_min;
+	int 		axis 		= (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+	double 		c_min 		= coordinate(centroid_bounds.p_min, axis);
+	double 		c_extent 	= coordinate(centroid_bounds.p_max, axis) - c_min;
+	int 		mid 		= (begin + end) / 2;
+
+	if (c_extent == 0.0 || depth >= kMaxSAHDepth) {
+		if (c_extent == 0.0 && num_objects <= kMaxLeafObjects)
+			return (make_leaf());
+
+		std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+			[&](const int a, const int b) { return (coordinate(centroids[a], axis) < coordinate(centroids[b], axis)); });
+	}
+	else {
+		auto bin_of = [&](const int j) {
+			int bin = (int)(kNumBins * (coordinate(centroids[j], axis) - c_min) / c_extent);
+			return (std::min(bin, kNumBins - 1));
+		};
+
+		BBox 	bin_bounds[kNumBins];
+		int 	bin_counts[kNumBins] = {0};
+
+		for (int j = begin; j < end; j++) {
+			int bin = bin_of(order[j]);
+			bin_counts[bin]++;
+			bin_bounds[bin] = bbox_union(bin_bounds[bin], object_bounds[order[j]]);
+		}
+
+		// the first and last bins hold the extreme centroids, so both sides of every split have objects
+
+		double 	left_areas[kNumBins - 1];
+		int 	left_counts[kNumBins - 1];
+		BBox 	left;
+		int 	left_count = 0;
+
+		for (int j = 0; j < kNumBins - 1; j++) {
+			left 			= bbox_union(left, bin_bounds[j]);
+			left_count 		+= bin_counts[j];
+			left_areas[j] 	= left.surface_area();
+			left_counts[j] 	= left_count;
+		}
+
+		BBox 	right;
+		int 	right_count 	= 0;
+		double 	best_cost 		= kHugeValue;
+		int 	best_split 		= 0;			// the last bin on the left
+
+		for (int j = kNumBins - 1; j > 0; j--) {
+			right 			= bbox_union(right, bin_bounds[j]);
+			right_count 	+= bin_counts[j];
+
+			double cost = left_counts[j - 1] * left_areas[j - 1] + right_count * right.surface_area();
+
+			if (cost < best_cost) {
+				best_cost 	= cost;
+				best_split 	= j - 1;
+			}
+		}
+
+		double area 		= bounds.surface_area();
+		double split_cost 	= kTraversalCost + (area > 0.0 ? best_cost / area : num_objects);
+
+		if (num_objects <= kMaxLeafObjects && split_cost >= num_objects)
+			return (make_leaf());
+
+		mid = std::partition(order.begin() + begin, order.begin() + end,
+							 [&](const int j) { return (bin_of(j) <= best_split); }) - order.begin();
+	}
+
+	build(centroids, begin, mid, depth + 1);
+	int second = build(centroids, mid, end, depth + 1);
+
+	nodes[index].offset = second;
+	nodes[index].count 	= 0;
+	nodes[index].axis 	= axis;
+
+	return (index);
+}
+
+
+// ---------------------------------------------------------------- build_motion
+// As build, with the areas of the boxes replaced by motion_area, and the centroids taken at the middle
+// of the node's range. A node whose references move can also be split in time, if that is cheaper:
+// each half of its range is half as likely to be visited, and the objects sweep through less space
+// in it. The leaves' objects are appended to order, where an object split in time appears more than
+// once.
+
+int
+BVH::build_motion(std::vector<Reference>& refs, const int begin, const int end, const float time_min,
+				  const float time_max, const int depth, const int temporal_splits) {
+	int 	index 		= (int)nodes.size();
+	int 	num_refs 	= end - begin;
+	bool 	moving 		= false;
+	BBox 	bounds0, bounds1;
+	BBox 	centroid_bounds;
+
+	auto centroid = [&](const Reference& ref) { return (bbox_lerp(ref.bounds0, ref.bounds1, 0.5).centroid()); };
+
+	nodes.push_back(Node());
+	motion.push_back(NodeMotion());
+
+	for (int j = begin; j < end; j++) {
+		bounds0 		= bbox_union(bounds0, refs[j].bounds0);
+		bounds1 		= bbox_union(bounds1, refs[j].bounds1);
+		centroid_bounds = bbox_union(centroid_bounds, centroid(refs[j]));
+		moving 			= moving || !same(refs[j].bounds0, refs[j].bounds1);
+	}
+
+	motion[index].time_min 	= time_min;
+	motion[index].time_max 	= time_max;
+	motion[index].inv_span 	= 1.0f / (time_max - time_min);
+	motion[index].temporal 	= false;
+	set_motion_bounds(index, bounds0, bounds1);
+
+	auto make_leaf = [&](void) {
+		nodes[index].offset = (int)order.size();
+		nodes[index].count 	= num_refs;
+		nodes[index].axis 	= 0;
+
+		for (int j = begin; j < end; j++)
+			order.push_back(refs[j].object);
+
+		return (index);
+	};
+
+	if (num_refs == 1)
+		return (make_leaf());
+
+	double area = motion_area(bounds0, bounds1);
+
+	// the temporal split, costed with each reference's boxes interpolated to the middle of the range;
+	// the objects are only asked for their bounds over the halves if the split is taken
+
+	float 	time_mid 		= 0.5f * (time_min + time_max);
+	double 	temporal_cost 	= kHugeValue;
+
+	if (moving && temporal_splits > 0 && depth < kMaxSAHDepth && area > 0.0) {
+		BBox middle;
+
+		for (int j = begin; j < end; j++)
+			middle = bbox_union(middle, bbox_lerp(refs[j].bounds0, refs[j].bounds1, 0.5));
+
+		temporal_cost = kTraversalCost + 0.5 * num_refs * (motion_area(bounds0, middle) + motion_area(middle, bounds1)) / area;
+	}
+
+	// the spatial split
+
+	Vector3D 	extent 			= centroid_bounds.p_max - centroid_bounds.p_min;
+	int 		axis 			= (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+	double 		c_min 			= coordinate(centroid_bounds.p_min, axis);
+	double 		c_extent 		= coordinate(centroid_bounds.p_max, axis) - c_min;
+	int 		mid 			= (begin + end) / 2;
+	double 		spatial_cost 	= kHugeValue;
+	int 		best_split 		= 0;			// the last bin on the left
+
+	auto bin_of = [&](const Reference& ref) {
+		int bin = (int)(kNumBins * (coordinate(centroid(ref), axis) - c_min) / c_extent);
+		return (std::min(bin, kNumBins - 1));
+	};
+
+	if (c_extent > 0.0 && depth < kMaxSAHDepth) {
+		BBox 	bin_bounds0[kNumBins];
+		BBox 	bin_bounds1[kNumBins];
+		int 	bin_counts[kNumBins] = {0};
+
+		for (int j = begin; j < end; j++) {
+			int bin = bin_of(refs[j]);
+			bin_counts[bin]++;
+			bin_bounds0[bin] = bbox_union(bin_bounds0[bin], refs[j].bounds0);
+			bin_bounds1[bin] = bbox_union(bin_bounds1[bin], refs[j].bounds1);
+		}
+
+		double 	left_areas[kNumBins - 1];
+		int 	left_counts[kNumBins - 1];
+		BBox 	left0, left1;
+		int 	left_count = 0;
+
+		for (int j = 0; j < kNumBins - 1; j++) {
+			left0 			= bbox_union(left0, bin_bounds0[j]);
+			left1 			= bbox_union(left1, bin_bounds1[j]);
+			left_count 		+= bin_counts[j];
+			left_areas[j] 	= motion_area(left0, left1);
+			left_counts[j] 	= left_count;
+		}
+
+		BBox 	right0, right1;
+		int 	right_count = 0;
+		double 	best_cost 	= kHugeValue;
+
+		for (int j = kNumBins - 1; j > 0; j--) {
+			right0 		= bbox_union(right0, bin_bounds0[j]);
+			right1 		= bbox_union(right1, bin_bounds1[j]);
+			right_count += bin_counts[j];
+
+			double cost = left_counts[j - 1] * left_areas[j - 1] + right_count * motion_area(right0, right1);
+
+			if (cost < best_cost) {
+				best_cost 	= cost;
+				best_split 	= j - 1;
+			}
+		}
+
+		spatial_cost = kTraversalCost + (area > 0.0 ? best_cost / area : num_refs);
+	}
+
+	if (num_refs <= kMaxLeafObjects && std::min(spatial_cost, temporal_cost) >= num_refs)
+		return (make_leaf());
+
+	if (temporal_cost < spatial_cost) {
+		std::vector<Reference> early(refs.begin() + begin, refs.begin() + end);
+		std::vector<Reference> late(early);
+
+		for (int j = 0; j < num_refs; j++) {
+			if (same(early[j].bounds0, early[j].bounds1))
+				continue;
+
+			const GeometricObject* object_ptr = bounded[early[j].object];
+
+			if (!object_ptr->get_motion_bounds(time_min, time_mid, early[j].bounds0, early[j].bounds1)
+				|| !object_ptr->get_motion_bounds(time_mid, time_max, late[j].bounds0, late[j].bounds1))
+				early[j].bounds0 = early[j].bounds1 = late[j].bounds0 = late[j].bounds1
+					= bbox_union(refs[begin + j].bounds0, refs[begin + j].bounds1);
+		}
+
+		build_motion(early, 0, num_refs, time_min, time_mid, depth + 1, temporal_splits - 1);
+		int second = build_motion(late, 0, num_refs, time_mid, time_max, depth + 1, temporal_splits - 1);
+
+		nodes[index].offset 	= second;
+		nodes[index].count 		= 0;
+		nodes[index].axis 		= 0;
+		motion[index].temporal 	= true;
+
+		return (index);
+	}
+
+	if (spatial_cost < kHugeValue)			// otherwise the centroids coincide, or the tree is deep: split at the median
+		mid = std::partition(refs.begin() + begin, refs.begin() + end,
+							 [&](const Reference& ref) { return (bin_of(ref) <= best_split); }) - refs.begin();
+	else
+		std::nth_element(refs.begin() + begin, refs.begin() + mid, refs.begin() + end,
+			[&](const Reference& a, const Reference& b) { return (coordinate(centroid(a), axis) < coordinate(centroid(b), axis)); });
+
+	build_motion(refs, begin, mid, time_min, time_max, depth + 1, temporal_splits);
+	int second = build_motion(refs, mid, end, time_min, time_max, depth + 1, temporal_splits);
+
+	nodes[index].offset = second;
+	nodes[index].count 	= 0;
+	nodes[index].axis 	= axis;
+
+	return (index);
+}
+
+
+// ---------------------------------------------------------------- refit
+// The top levels of the tree are walked until there are enough subtrees below them to share out
+// among the threads. The threads refit the subtrees, taking them from a shared counter, and then the
+// nodes above them are refitted, children before parents.
+
+void
+BVH::refit(const int num_threads) {
+	STATS_TIMER(STAT_TIME_BVH_REFIT);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if (!nodes.empty()) {
+		int 				num_workers = num_threads > 0 ? num_threads : (int)std::thread::hardware_concurrency();
+		std::vector<int> 	top;				// parents before children
+		std::vector<int> 	subtrees(1, 0);
+
+		if (num_workers > 1 && (int)nodes.size() >= kMinParallelNodes)
+			while ((int)subtrees.size() < 4 * num_workers) {
+				std::vector<int> next;
+
+				for (int index : subtrees)
+					if (nodes[index].count == 0) {
+						top.push_back(index);
+						next.push_back(index + 1);
+						next.push_back(nodes[index].offset);
+					}
+					else
+						next.push_back(index);
+
+				if (next.size() == subtrees.size())
+					break;
+
+				subtrees.swap(next);
+			}
+
+		std::atomic<int> next_subtree(0);
+
+		auto worker = [&](void) {
+			for (int j = next_subtree++; j < (int)subtrees.size(); j = next_subtree++)
+				refit_subtree(subtrees[j]);
+		};
+
+		num_workers = std::max(1, std::min(num_workers, (int)subtrees.size()));
+
+		if (num_workers == 1)
+			worker();
+		else {
+			std::vector<std::thread> threads;
+
+			for (int id = 0; id < num_workers; id++)
+				threads.emplace_back(worker);
+
+			for (std::thread& t : threads)
+				t.join();
+		}
+
+		for (std::vector<int>::reverse_iterator it = top.rbegin(); it != top.rend(); ++it)
+			refit_node(*it);
+	}
+
+	std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+	refit_time = seconds.count();
+}
+
+
+// ---------------------------------------------------------------- refit_subtree
+
+void
+BVH::refit_subtree(const int index) {
+	if (nodes[index].count == 0) {
+		refit_subtree(index + 1);
+		refit_subtree(nodes[index].offset);
+	}
+
+	refit_node(index);
+}
+
+
+// ---------------------------------------------------------------- refit_node
+// a leaf asks its objects for their bounds; an object that has lost its bounds keeps its old ones
+
+void
+BVH::refit_node(const int index) {
+	if (!motion.empty()) {
+		refit_motion_node(index);
+		return;
+	}
+
+	Node& node = nodes[index];
+
+	if (node.count == 0) {
+		node.bounds = bbox_union(nodes[index + 1].bounds, nodes[node.offset].bounds);
+		return;
+	}
+
+	BBox bounds;
+
+	for (int j = node.offset; j < node.offset + node.count; j++) {
+		BBox object;
+
+		if (bounded[order[j]]->get_bounds(object))
+			object_bounds[order[j]] = object;
+
+		bounds = bbox_union(bounds, object_bounds[order[j]]);
+	}
+
+	node.bounds = bounds;
+}
+
+
+// ---------------------------------------------------------------- refit_motion_node
+// A leaf asks its objects for their bounds over its range; if one has lost them, the leaf keeps its
+// old boxes as well. The children of a temporal split meet at the middle of its range, and its boxes
+// at the ends are each the union of the child's box there and both boxes at the middle, so that their
+// interpolation holds each child's over its half.
+
+void
+BVH::refit_motion_node(const int index) {
+	Node& 			node 		= nodes[index];
+	NodeMotion& 	node_motion = motion[index];
+
+	if (node.count == 0) {
+		const Node& 		first 			= nodes[index + 1];
+		const Node& 		second 			= nodes[node.offset];
+		const NodeMotion& 	first_motion 	= motion[index + 1];
+		const NodeMotion& 	second_motion 	= motion[node.offset];
+
+		if (node_motion.temporal) {
+			BBox middle = bbox_union(first_motion.bounds1, second.bounds);
+
+			set_motion_bounds(index, bbox_union(first.bounds, middle), bbox_union(second_motion.bounds1, middle));
+		}
+		else
+			set_motion_bounds(index, bbox_union(first.bounds, second.bounds),
+							  bbox_union(first_motion.bounds1, second_motion.bounds1));
+
+		return;
+	}
+
+	BBox 	bounds0, bounds1;
+	bool 	lost = false;
+
+	for (int j = node.offset; j < node.offset + node.count; j++) {
+		BBox object0, object1;
+
+		if (bounded[order[j]]->get_motion_bounds(node_motion.time_min, node_motion.time_max, object0, object1)) {
+			bounds0 = bbox_union(bounds0, object0);
+			bounds1 = bbox_union(bounds1, object1);
+		}
+		else
+			lost = true;
+	}
+
+	if (lost) {
+		bounds0 = bbox_union(bounds0, node.bounds);
+		bounds1 = bbox_union(bounds1, node_motion.bounds1);
+	}
+
+	set_motion_bounds(index, bounds0, bounds1);
+}
+
+
+// ---------------------------------------------------------------- set_motion_bounds
+
+void
+BVH::set_motion_bounds(const int index, const BBox& bounds0, const BBox& bounds1) {
+	NodeMotion& node_motion = motion[index];
+
+	nodes[index].bounds 	= bounds0;
+	node_motion.bounds1 	= bounds1;
+	node_motion.delta_min 	= bounds1.p_min - bounds0.p_min;
+	node_motion.delta_max 	= bounds1.p_max - bounds0.p_max;
+}
@@ -0,0 +1,163 @@
+#ifndef __BVH__
+#define __BVH__
+
+// This file contains the declaration of the class BVH, a bounding volume hierarchy over the objects of
+// a World, which World::hit_objects and World::any_hit traverse instead of testing every object, as
+// does the static dispatch path (World/StaticScene.h)
+// The tree is built top down with the surface area heuristic (SAH), over 16 bins of the centroids
+// along their widest axis. Objects without bounds (GeometricObject::get_bounds), such as planes,
+// are kept out of the tree and tested for every ray.
+// When objects move, update refits the tree: the leaves take their objects' new bounds and every
+// interior node the union of its children's, bottom up, with the subtrees shared out among threads.
+// The topology is kept, so the tree gets worse as the objects drift from where it was built; once its
+// SAH cost is more than the rebuild threshold times the cost at the last build, update rebuilds it.
+// The cost is normalised by the root's area, so it measures the tree's quality, not the size of the
+// scene.
+// When objects move while the shutter is open (GeometricObject::get_motion_bounds), every node also
+// has a time range and a second box: its box at a ray's time is interpolated between the two. A node
+// whose objects sweep through much more space over its range than at any one time can be split in
+// time, as in the spatio-temporal BVH (STBVH): both children hold all its objects, over the two halves
+// of its range, and a ray only visits the one for its time. A static scene gets the static tree, and
+// its traversal doesn't look at times.
+// The tree holds the objects it was built with; it must be rebuilt, with World::enable_bvh, when
+// objects are added to the world or replaced. The tree does not own the objects; the World does.
+
+#include <vector>
+
+#include "../GeometricObjects/GeometricObject.h"
+#include "../Utilities/BBox.h"
+
+//----------------------------------------------------------------------------- class BVH
+
+class BVH {
+	public:
+
+		BVH(const std::vector<GeometricObject*>& objects, const double rebuild_threshold = 1.5);
+
+		const GeometricObject*					// the nearest object the ray hits, with sr's normal and local hit point; NULL for none
+		nearest_hit(const Ray& ray, ShadeRec& sr, double& tmin) const;
+
+		bool									// is there a shadow casting object along the ray before t_max?
+		any_hit(const Ray& ray, const double t_max) const;
+
+		bool									// refits to the objects' current bounds, or rebuilds; true if it rebuilt
+		update(const int num_threads);
+
+		double									// the expected cost of a ray that hits the root, in object tests
+		sah_cost(void) const;
+
+		double									// seconds taken by the last refit, which is also done before a rebuild
+		get_refit_time(void) const;
+
+		double									// seconds taken by the last build, whether by update or the constructor
+		get_build_time(void) const;
+
+		int
+		num_nodes(void) const;
+
+	private:
+
+		struct Node {
+			BBox	bounds;
+			int		offset;			// the second child of an interior node, or a leaf's first entry in order
+			int		count;			// the number of objects in a leaf, 0 for an interior node
+			int		axis;			// the split axis of an interior node, for the traversal order
+		};
+
+		struct NodeMotion {
+			Vector3D	delta_min;		// bounds1 less the node's bounds, which are its box at time_min
+			Vector3D	delta_max;
+			float	time_min;
+			float	time_max;
+			float	inv_span;		// 1 / (time_max - time_min)
+			bool	temporal;		// are the children the node's objects over the two halves of its range?
+			BBox	bounds1;		// the box at time_max
+		};
+
+		struct Reference {			// an object, while the tree over it is built
+			int		object;			// its index in bounded
+			BBox	bounds0;		// over the time range of the node being built
+			BBox	bounds1;
+		};
+
+		static constexpr int		kNumBins 			= 16;
+		static constexpr int		kMaxLeafObjects 	= 4;
+		static constexpr double		kTraversalCost 		= 0.5;		// relative to an object test
+		static constexpr int		kMaxTemporalSplits 	= 3;		// on any path from the root
+
+		std::vector<GeometricObject*>	bounded;
+		std::vector<GeometricObject*>	unbounded;
+		std::vector<int>				bounded_ids;		// the objects' indices in the world, for ties
+		std::vector<int>				unbounded_ids;
+		std::vector<BBox>				object_bounds;		// of bounded
+		std::vector<int>				order;				// indices into bounded, in leaf order
+		std::vector<Node>				nodes;				// in depth-first order: an interior node's first child follows it
+		std::vector<NodeMotion>			motion;				// for each node, if any object moves; otherwise empty
+		double							rebuild_threshold;
+		double							build_cost;			// sah_cost after the last build
+		double							refit_time;
+		double							build_time;
+
+		void
+		build(void);
+
+		int										// builds the subtree over order[begin, end), returns its root
+		build(std::vector<Point3D>& centroids, const int begin, const int end, const int depth);
+
+		int										// builds the subtree over refs[begin, end) when objects move, returns its root
+		build_motion(std::vector<Reference>& refs, const int begin, const int end, const float time_min,
+					 const float time_max, const int depth, const int temporal_splits);
+
+		template <bool timed>
+		bool									// does the ray hit the node's box, at the ray's time if timed?
+		hit_node(const int index, const Ray& ray, const Vector3D& inv_d, const double t_max) const;
+
+		template <bool timed>
+		const GeometricObject*
+		find_nearest(const Ray& ray, ShadeRec& sr, double& tmin) const;
+
+		template <bool timed>
+		bool
+		find_any(const Ray& ray, const double t_max) const;
+
+		void
+		refit(const int num_threads);
+
+		void
+		refit_subtree(const int index);
+
+		void
+		refit_node(const int index);
+
+		void
+		refit_motion_node(const int index);
+
+		void
+		set_motion_bounds(const int index, const BBox& bounds0, const BBox& bounds1);
+};
+
+
+// ---------------------------------------------------------------- get_refit_time
+
+inline double
+BVH::get_refit_time(void) const {
+	return (refit_time);
+}
+
+
+// ---------------------------------------------------------------- get_build_time
+
+inline double
+BVH::get_build_time(void) const {
+	return (build_time);
+}
+
+
+// ---------------------------------------------------------------- num_nodes
+
+inline int
+BVH::num_nodes(void) const {
+	return ((int)nodes.size());
+}
+
+#endif
@@ -0,0 +1,137 @@
+// This file contains the definition of the class Checkpoint
+// The file holds the magic number, the version and the header, then one record per finished tile:
+// the tile number, the number of pixels, and their r, g, b components as floats.
+
+#include <cstdio>
+#include <fstream>
+
+#include "Checkpoint.h"
+
+// ----------------------------------------------------------------------------- constructor
+
+Checkpoint::Checkpoint(const std::string& _file_name, const double _interval, const int hres, const int vres,
+					   const int tile_size, const int num_samples, const int num_tiles)
+	: 	file_name(_file_name),
+		interval(_interval),
+		header{hres, vres, tile_size, num_samples, num_tiles},
+		tiles(num_tiles),
+		last_save(std::chrono::steady_clock::now())
+{}
+
+
+// ----------------------------------------------------------------------------- load
+// a file from a different render, or one that can't be read, is ignored, and a truncated record ends
+// the tiles that are loaded
+
+int
+Checkpoint::load(void) {
+	std::ifstream file(file_name, std::ios::binary);
+	int magic, version, file_header[5];
+
+	if (!file.read((char*)&magic, sizeof(magic)) || magic != kMagic)
+		return (0);
+
+	if (!file.read((char*)&version, sizeof(version)) || version != kVersion)
+		return (0);
+
+	if (!file.read((char*)file_header, sizeof(file_header)))
+		return (0);
+
+	for (int j = 0; j < 5; j++)
+		if (file_header[j] != header[j])
+			return (0);
+
+	int num_tiles 		= header[4];
+	int max_pixels 		= header[2] * header[2];
+	int num_loaded 		= 0;
+	int tile, num_pixels;
+
+	while (file.read((char*)&tile, sizeof(tile)) && file.read((char*)&num_pixels, sizeof(num_pixels))) {
+		if (tile < 0 || tile >= num_tiles || num_pixels <= 0 || num_pixels > max_pixels)
+			break;
+
+		std::vector<float> 		components(3 * num_pixels);
+		std::vector<RGBColor> 	tile_pixels(num_pixels);
+
+		if (!file.read((char*)components.data(), components.size() * sizeof(float)))
+			break;
+
+		for (int j = 0; j < num_pixels; j++)
+			tile_pixels[j] = RGBColor(components[3 * j], components[3 * j + 1], components[3 * j + 2]);
+
+		if (tiles[tile].empty())
+			num_loaded++;
+
+		tiles[tile].swap(tile_pixels);
+	}
+
+	return (num_loaded);
+}
+
+
+// ----------------------------------------------------------------------------- tile_done
+// the thread that saves holds the lock while it writes, so the others wait for it as they finish
+// their tiles; with intervals of minutes, that time doesn't matter
+
+void
+Checkpoint::tile_done(const int tile, const std::vector<RGBColor>& tile_pixels) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	tiles[tile] = tile_pixels;
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - last_save;
+
+	if (elapsed.count() >= interval) {
+		write();
+		last_save = std::chrono::steady_clock::now();
+	}
+}
+
+
+// ----------------------------------------------------------------------------- remove
+
+void
+Checkpoint::remove(void) const {
+	std::remove(file_name.c_str());
+}
+
+
+// ----------------------------------------------------------------------------- write
+
+bool
+Checkpoint::write(void) const {
+	std::string 	temp_name = file_name + ".tmp";
+	std::ofstream 	file(temp_name, std::ios::binary | std::ios::trunc);
+
+	file.write((const char*)&kMagic, sizeof(kMagic));
+	file.write((const char*)&kVersion, sizeof(kVersion));
+	file.write((const char*)header, sizeof(header));
+
+	std::vector<float> components;
+
+	for (int tile = 0; tile < (int)tiles.size(); tile++) {
+		int num_pixels = tiles[tile].size();
+
+		if (num_pixels == 0)
+			continue;
+
+		components.resize(3 * num_pixels);
+
+		for (int j = 0; j < num_pixels; j++) {
+			components[3 * j] 		= tiles[tile][j].r;
+			components[3 * j + 1] 	= tiles[tile][j].g;
+			components[3 * j + 2] 	= tiles[tile][j].b;
+		}
+
+		file.write((const char*)&tile, sizeof(tile));
+		file.write((const char*)&num_pixels, sizeof(num_pixels));
+		file.write((const char*)components.data(), components.size() * sizeof(float));
+	}
+
+	file.close();
+
+	if (!file)
+		return (false);
+
+	return (std::rename(temp_name.c_str(), file_name.c_str()) == 0);
+}
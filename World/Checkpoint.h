@@ -0,0 +1,64 @@
+#ifndef __CHECKPOINT__
+#define __CHECKPOINT__
+
+// This file contains the declaration of the class Checkpoint, which saves the finished tiles of a
+// render so that a render that was stopped can be resumed
+// render_scene hands each finished tile to tile_done, which saves all the tiles finished so far once
+// the interval has passed since the last save. The file is written next to the checkpoint file and
+// renamed over it, so a render that is killed while saving leaves the last complete checkpoint.
+// A restarted render loads the tiles that match its resolution, tile size and samples per pixel and
+// only renders the others. Tiles reseed the random engine, so the image is the same as that of a
+// render that wasn't stopped.
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../Utilities/RGBColor.h"
+
+//------------------------------------------------------------------------------------ class Checkpoint
+
+class Checkpoint {
+	public:
+
+		Checkpoint(const std::string& file_name, const double interval, const int hres, const int vres,
+				   const int tile_size, const int num_samples, const int num_tiles);
+
+		int										// reads the tiles of an earlier run of the same render, returns how many
+		load(void);
+
+		const std::vector<RGBColor>&			// a tile that load read, in the order render_scene copies it; empty if there's none
+		get_tile(const int tile) const;
+
+		void									// keeps a finished tile, and saves if interval seconds have passed since the last save
+		tile_done(const int tile, const std::vector<RGBColor>& tile_pixels);
+
+		void									// once the image has been written
+		remove(void) const;
+
+	private:
+
+		static constexpr int	kMagic 		= 0x50435452;		// "RTCP"
+		static constexpr int	kVersion 	= 1;
+
+		std::string								file_name;
+		double									interval;		// seconds; 0 saves after every tile
+		int										header[5];		// hres, vres, tile_size, num_samples, num_tiles
+		std::vector<std::vector<RGBColor> >		tiles;			// empty for the tiles that aren't finished
+		std::mutex								mutex;			// for tiles and last_save
+		std::chrono::steady_clock::time_point	last_save;
+
+		bool
+		write(void) const;
+};
+
+
+// ----------------------------------------------------------------------------- get_tile
+
+inline const std::vector<RGBColor>&
+Checkpoint::get_tile(const int tile) const {
+	return (tiles[tile]);
+}
+
+#endif
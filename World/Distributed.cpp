@@ -0,0 +1,598 @@
+// This file contains the definitions of the classes RenderCoordinator and RenderWorker
+// Every message is a header of three ints, the type, the tile and the size of the payload in bytes,
+// followed by the payload:
+//	hello		worker to coordinator, once: the worker's pid, hres, vres, tile_size, num_samples and 1 if it
+//				records a heatmap, 0 if not
+//	tile		coordinator to worker: render the tile
+//	pixels		worker to coordinator: the tile's pixels in World::get_tile order, as r, g, b floats, then
+//				with a heatmap their costs, in the same order, as HEATMAP_NUM_CHANNELS 64-bit integers each
+//	quit		coordinator to worker: all the tiles are done
+// The coordinator keeps two tiles in flight per worker, so that a worker has the next tile as soon as
+// it has sent back the last one.
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <thread>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Distributed.h"
+#include "World.h"
+#include "GBuffer.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+enum MessageType {
+	MESSAGE_HELLO 	= 1,
+	MESSAGE_TILE 	= 2,
+	MESSAGE_PIXELS 	= 3,
+	MESSAGE_QUIT 	= 4
+};
+
+struct MessageHeader {
+	int32_t		type;
+	int32_t		tile;
+	int32_t		size;
+};
+
+static const int kTilesInFlight = 2;
+
+
+// ----------------------------------------------------------------------------- open_socket
+// a listening socket for the coordinator, or one connected to it for a worker; -1 on failure
+
+static int
+open_socket(const std::string& address, const bool server) {
+	size_t colon = address.rfind(':');
+
+	if (colon == std::string::npos) {
+		sockaddr_un addr;
+
+		if (address.size() >= sizeof(addr.sun_path))
+			return (-1);
+
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strcpy(addr.sun_path, address.c_str());
+
+		int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+		if (fd < 0)
+			return (-1);
+
+		if (server)
+			unlink(address.c_str());
+
+		int result = server ? bind(fd, (sockaddr*)&addr, sizeof(addr)) : ::connect(fd, (sockaddr*)&addr, sizeof(addr));
+
+		if (result < 0 || (server && ::listen(fd, SOMAXCONN) < 0)) {
+			close(fd);
+			return (-1);
+		}
+
+		return (fd);
+	}
+
+	std::string host = address.substr(0, colon);
+	std::string port = address.substr(colon + 1);
+	addrinfo 	hints;
+	addrinfo*	info;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family 	= AF_UNSPEC;
+	hints.ai_socktype 	= SOCK_STREAM;
+	hints.ai_flags 		= server ? AI_PASSIVE : 0;
+
+	if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &info) != 0)
+		return (-1);
+
+	int fd = -1;
+
+	for (addrinfo* p = info; p && fd < 0; p = p->ai_next) {
+		fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+
+		if (fd < 0)
+			continue;
+
+		int one = 1;
+		setsockopt(fd, server ? SOL_SOCKET : IPPROTO_TCP, server ? SO_REUSEADDR : TCP_NODELAY, &one, sizeof(one));
+
+		int result = server ? bind(fd, p->ai_addr, p->ai_addrlen) : ::connect(fd, p->ai_addr, p->ai_addrlen);
+
+		if (result < 0 || (server && ::listen(fd, SOMAXCONN) < 0)) {
+			close(fd);
+			fd = -1;
+		}
+	}
+
+	freeaddrinfo(info);
+
+	return (fd);
+}
+
+
+// ----------------------------------------------------------------------------- send_message
+
+static bool
+send_message(const int fd, const int type, const int tile, const void* payload, const int size) {
+	MessageHeader 		header = {type, tile, size};
+	std::vector<char> 	message(sizeof(header) + size);
+
+	memcpy(message.data(), &header, sizeof(header));
+
+	if (size > 0)
+		memcpy(message.data() + sizeof(header), payload, size);
+
+	for (size_t sent = 0; sent < message.size(); ) {
+		ssize_t n = send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			return (false);
+
+		sent += n;
+	}
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- receive_all
+// blocks until size bytes have arrived
+
+static bool
+receive_all(const int fd, void* data, const size_t size) {
+	for (size_t received = 0; received < size; ) {
+		ssize_t n = recv(fd, (char*)data + received, size - received, 0);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			return (false);
+
+		received += n;
+	}
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- scene_header
+// what a worker's World must agree on with the coordinator's
+
+static void
+scene_header(const World& w, int32_t header[5]) {
+	header[0] = w.vp.hres;
+	header[1] = w.vp.vres;
+	header[2] = w.tile_size;
+	header[3] = w.vp.num_samples;
+	header[4] = w.heatmap_ptr ? 1 : 0;
+}
+
+
+// ----------------------------------------------------------------------------- pixel_bytes
+// of each pixel in a pixels message
+
+static int
+pixel_bytes(const World& w) {
+	return (3 * sizeof(float) + (w.heatmap_ptr ? sizeof(PixelCost) : 0));
+}
+
+
+// ----------------------------------------------------------------------------- seconds_since
+
+static double
+seconds_since(const std::chrono::steady_clock::time_point& start) {
+	return (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+
+// ----------------------------------------------------------------------------- RenderCoordinator
+
+RenderCoordinator::RenderCoordinator(const World& w)
+	: 	world(w),
+		listen_fd(-1),
+		num_done(0)
+{
+	signal(SIGPIPE, SIG_IGN);
+}
+
+
+// ----------------------------------------------------------------------------- ~RenderCoordinator
+
+RenderCoordinator::~RenderCoordinator(void) {
+	for (Worker& worker : workers)
+		if (worker.alive)
+			close(worker.fd);
+
+	if (listen_fd >= 0) {
+		close(listen_fd);
+
+		if (address.find(':') == std::string::npos)
+			unlink(address.c_str());
+	}
+}
+
+
+// ----------------------------------------------------------------------------- listen
+
+bool
+RenderCoordinator::listen(const std::string& _address) {
+	address 	= _address;
+	listen_fd 	= open_socket(address, true);
+
+	return (listen_fd >= 0);
+}
+
+
+// ----------------------------------------------------------------------------- render
+// the tiles go out in the order render_scene takes them, from the top of the image down; with
+// regions, only the tiles with pixels in them go out, onto the base image
+
+bool
+RenderCoordinator::render(std::ostream& report, const double idle_timeout) {
+	int num_tiles = world.num_tiles();
+
+	pixels.assign(world.vp.hres * world.vp.vres, RGBColor());
+	done.assign(num_tiles, 0);
+	num_done = 0;
+	queue.clear();
+
+	if (!world.load_base_image(pixels))
+		report << "can't read " << world.base_file << " as a " << world.vp.hres << " by " << world.vp.vres
+			   << " float image; the pixels outside the regions will be black\n";
+
+	if (world.heatmap_ptr)
+		world.heatmap_ptr->resize(world.vp.hres, world.vp.vres);
+
+	for (int tile = num_tiles - 1; tile >= 0; tile--)
+		if (world.tile_in_regions(tile))
+			queue.push_back(tile);
+		else {
+			done[tile] = 1;
+			num_done++;
+		}
+
+	int num_queued = queue.size();
+
+	std::chrono::steady_clock::time_point 	start 		= std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point 	idle_since 	= start;
+	std::vector<pollfd> 					fds;
+	std::vector<int> 						fd_workers;		// the worker of each of fds after the first
+
+	while (num_done < num_tiles) {
+		fds.assign(1, pollfd{listen_fd, POLLIN, 0});
+		fd_workers.clear();
+
+		for (int j = 0; j < (int)workers.size(); j++)
+			if (workers[j].alive) {
+				fds.push_back(pollfd{workers[j].fd, POLLIN, 0});
+				fd_workers.push_back(j);
+			}
+
+		if (fd_workers.empty() && seconds_since(idle_since) > idle_timeout) {
+			report << "no workers for " << idle_timeout << " s, with " << num_tiles - num_done << " tiles left\n";
+			return (false);
+		}
+
+		if (!fd_workers.empty())
+			idle_since = std::chrono::steady_clock::now();
+
+		if (poll(fds.data(), fds.size(), 1000) <= 0)
+			continue;
+
+		for (int j = 1; j < (int)fds.size(); j++) {
+			const char* reason = nullptr;
+
+			if (fds[j].revents && !receive(workers[fd_workers[j - 1]], reason))
+				drop_worker(workers[fd_workers[j - 1]], report, reason);
+		}
+
+		if (fds[0].revents & POLLIN)
+			accept_worker();
+	}
+
+	for (Worker& worker : workers)
+		if (worker.alive) {
+			send_message(worker.fd, MESSAGE_QUIT, 0, nullptr, 0);
+			close(worker.fd);
+			worker.alive 	= false;
+			worker.seconds 	= seconds_since(worker.start);
+		}
+
+	report << "rendered " << num_queued << " tiles in " << std::fixed << std::setprecision(2)
+		   << seconds_since(start) << " s\n";
+	report_workers(report);
+
+	return (world.write_image(pixels));
+}
+
+
+// ----------------------------------------------------------------------------- accept_worker
+// the worker gets tiles once its hello has shown that it renders the same scene
+
+void
+RenderCoordinator::accept_worker(void) {
+	int fd = accept(listen_fd, nullptr, nullptr);
+
+	if (fd < 0)
+		return;
+
+	int one = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));		// fails harmlessly on Unix sockets
+
+	Worker worker;
+	worker.fd 			= fd;
+	worker.pid 			= 0;
+	worker.tiles_done 	= 0;
+	worker.pixels_done 	= 0;
+	worker.start 		= std::chrono::steady_clock::now();
+	worker.seconds 		= 0.0;
+	worker.alive 		= true;
+
+	workers.push_back(worker);
+}
+
+
+// ----------------------------------------------------------------------------- assign_tiles
+// a tile goes in flight before it is sent, so that it is put back in the queue if the send fails
+// and the worker is dropped
+
+void
+RenderCoordinator::assign_tiles(Worker& worker) {
+	while (worker.alive && worker.pid != 0 && (int)worker.in_flight.size() < kTilesInFlight && !queue.empty()) {
+		int tile = queue.back();
+
+		queue.pop_back();
+		worker.in_flight.push_back(tile);
+
+		if (!send_message(worker.fd, MESSAGE_TILE, tile, nullptr, 0))
+			return;
+	}
+}
+
+
+// ----------------------------------------------------------------------------- receive
+
+bool
+RenderCoordinator::receive(Worker& worker, const char*& reason) {
+	char 	bytes[65536];
+	ssize_t n = recv(worker.fd, bytes, sizeof(bytes), MSG_DONTWAIT);
+
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+		return (true);
+
+	if (n <= 0) {
+		reason = "disconnected";
+		return (false);
+	}
+
+	worker.buffer.insert(worker.buffer.end(), bytes, bytes + n);
+
+	size_t 					used = 0;
+	MessageHeader 			header;
+	std::vector<RGBColor> 	tile_pixels;
+	std::vector<PixelCost> 	tile_costs;
+
+	while (worker.buffer.size() - used >= sizeof(header)) {
+		memcpy(&header, worker.buffer.data() + used, sizeof(header));
+
+		if (header.size < 0 || header.size > pixel_bytes(world) * world.tile_size * world.tile_size) {
+			reason = "sent a message that is too large";
+			return (false);
+		}
+
+		if (worker.buffer.size() - used < sizeof(header) + header.size)
+			break;
+
+		const char* payload = worker.buffer.data() + used + sizeof(header);
+		used += sizeof(header) + header.size;
+
+		if (header.type == MESSAGE_HELLO && worker.pid == 0 && header.size == 6 * sizeof(int32_t)) {
+			int32_t hello[6], expected[5];
+
+			memcpy(hello, payload, sizeof(hello));
+			scene_header(world, expected);
+
+			if (hello[0] <= 0 || memcmp(hello + 1, expected, sizeof(expected)) != 0) {
+				reason = "renders a different scene";
+				return (false);
+			}
+
+			worker.pid = hello[0];
+			assign_tiles(worker);
+		}
+		else if (header.type == MESSAGE_PIXELS && worker.pid != 0) {
+			std::vector<int>::iterator it = std::find(worker.in_flight.begin(), worker.in_flight.end(), (int)header.tile);
+
+			if (it == worker.in_flight.end()) {
+				reason = "sent a tile it wasn't given";
+				return (false);
+			}
+
+			int 	num_pixels = header.size / pixel_bytes(world);
+			float 	rgb[3];
+
+			tile_pixels.resize(num_pixels);
+
+			for (int j = 0; j < num_pixels; j++) {
+				memcpy(rgb, payload + j * sizeof(rgb), sizeof(rgb));
+				tile_pixels[j] = RGBColor(rgb[0], rgb[1], rgb[2]);
+			}
+
+			if (world.heatmap_ptr) {
+				tile_costs.resize(num_pixels);
+
+				if (num_pixels > 0)
+					memcpy(tile_costs.data(), payload + num_pixels * sizeof(rgb), num_pixels * sizeof(PixelCost));
+			}
+
+			if (header.size != num_pixels * pixel_bytes(world) || !world.set_tile(header.tile, tile_pixels, pixels)
+				|| (world.heatmap_ptr && !world.set_tile_costs(header.tile, tile_costs))) {
+				reason = "sent a tile of the wrong size";
+				return (false);
+			}
+
+			worker.in_flight.erase(it);
+			worker.tiles_done++;
+			worker.pixels_done += num_pixels;
+
+			if (!done[header.tile]) {
+				done[header.tile] = 1;
+				num_done++;
+			}
+
+			assign_tiles(worker);
+		}
+		else {
+			reason = "broke the protocol";
+			return (false);
+		}
+	}
+
+	worker.buffer.erase(worker.buffer.begin(), worker.buffer.begin() + used);
+
+	return (true);
+}
+
+
+// ----------------------------------------------------------------------------- drop_worker
+
+void
+RenderCoordinator::drop_worker(Worker& worker, std::ostream& report, const char* reason) {
+	close(worker.fd);
+	worker.alive 	= false;
+	worker.seconds 	= seconds_since(worker.start);
+
+	report << "worker " << worker.pid << " " << reason << ", re-queueing " << worker.in_flight.size() << " tiles\n";
+
+	for (int tile : worker.in_flight)
+		if (!done[tile])
+			queue.push_back(tile);
+
+	worker.in_flight.clear();
+
+	for (Worker& other : workers)
+		assign_tiles(other);
+}
+
+
+// ----------------------------------------------------------------------------- report_workers
+// primary rays are pixels times samples per pixel; the time is from connecting to leaving
+
+void
+RenderCoordinator::report_workers(std::ostream& report) const {
+	for (const Worker& worker : workers) {
+		double rays = (double)worker.pixels_done * world.vp.num_samples;
+		double time = std::max(worker.seconds, 1.0e-9);
+
+		report << "worker " << worker.pid << ": " << worker.tiles_done << " tiles, "
+			   << std::fixed << std::setprecision(0) << rays << " primary rays in "
+			   << std::setprecision(2) << worker.seconds << " s, "
+			   << worker.tiles_done / time << " tiles/s, "
+			   << std::setprecision(0) << rays / time << " rays/s\n";
+	}
+}
+
+
+// ----------------------------------------------------------------------------- RenderWorker
+
+RenderWorker::RenderWorker(const World& w)
+	: 	world(w),
+		fd(-1)
+{
+	signal(SIGPIPE, SIG_IGN);
+}
+
+
+// ----------------------------------------------------------------------------- ~RenderWorker
+
+RenderWorker::~RenderWorker(void) {
+	if (fd >= 0)
+		close(fd);
+}
+
+
+// ----------------------------------------------------------------------------- connect
+
+bool
+RenderWorker::connect(const std::string& address, const double timeout) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	while ((fd = open_socket(address, false)) < 0 && seconds_since(start) < timeout)
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	return (fd >= 0);
+}
+
+
+// ----------------------------------------------------------------------------- serve
+
+bool
+RenderWorker::serve(void) {
+	int32_t hello[6];
+
+	hello[0] = getpid();
+	scene_header(world, hello + 1);
+
+	if (!send_message(fd, MESSAGE_HELLO, 0, hello, sizeof(hello)))
+		return (false);
+
+	std::unique_ptr<Sampler> 	sampler_ptr(world.vp.sampler_ptr->clone());
+	std::vector<RGBColor> 		pixels(world.vp.hres * world.vp.vres);
+	std::vector<RGBColor> 		tile_pixels;
+	std::vector<PixelCost> 		tile_costs;
+	std::vector<char> 			payload;
+	MessageHeader 				header;
+
+	if (world.gbuffer_ptr)
+		world.gbuffer_ptr->prepare(world.vp.hres, world.vp.vres, world.vp.num_samples);
+
+	if (world.heatmap_ptr)
+		world.heatmap_ptr->resize(world.vp.hres, world.vp.vres);
+
+	while (receive_all(fd, &header, sizeof(header))) {
+		if (header.type == MESSAGE_QUIT)
+			return (true);
+
+		if (header.type != MESSAGE_TILE || header.size != 0 || header.tile < 0 || header.tile >= world.num_tiles())
+			return (false);
+
+		world.render_tile(header.tile, *sampler_ptr, pixels);
+		world.get_tile(header.tile, pixels, tile_pixels);
+
+		payload.resize(tile_pixels.size() * pixel_bytes(world));
+
+		for (size_t j = 0; j < tile_pixels.size(); j++) {
+			float rgb[3] = {tile_pixels[j].r, tile_pixels[j].g, tile_pixels[j].b};
+			memcpy(payload.data() + j * sizeof(rgb), rgb, sizeof(rgb));
+		}
+
+		if (world.heatmap_ptr) {
+			world.get_tile_costs(header.tile, tile_costs);
+			memcpy(payload.data() + tile_pixels.size() * 3 * sizeof(float), tile_costs.data(),
+				   tile_costs.size() * sizeof(PixelCost));
+		}
+
+		if (!send_message(fd, MESSAGE_PIXELS, header.tile, payload.data(), payload.size()))
+			return (false);
+	}
+
+	return (false);
+}
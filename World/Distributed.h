@@ -0,0 +1,102 @@
+#ifndef __DISTRIBUTED__
+#define __DISTRIBUTED__
+
+// This file contains the declarations of the classes RenderCoordinator and RenderWorker, which render
+// the tiles of World::render_scene in several processes, on one machine or several
+// The coordinator listens on an address, hands tiles to the workers that connect to it and writes
+// the image once every tile has come back. Each worker builds its own World and renders the tiles it
+// is sent one at a time, sending back their pixels as floats, so the image is the same as that of
+// render_scene. A worker that disconnects before sending back its tiles has them handed to the
+// others; a worker whose scene has a different resolution, tile size or sample count is turned away.
+// With a heatmap, the workers send back the cost of every pixel with its colour, and the coordinator
+// writes the heatmap with the image; the coordinator and the workers must all have one, or none.
+// Addresses are "host:port" for TCP, or ":port" for all interfaces, and otherwise the path of a Unix
+// socket. The messages are sent in the machine's byte order, so the processes must run on machines
+// with the same one.
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../Utilities/RGBColor.h"
+
+class World;
+
+//------------------------------------------------------------------------------------ class RenderCoordinator
+
+class RenderCoordinator {
+	public:
+
+		RenderCoordinator(const World& w);
+
+		~RenderCoordinator(void);
+
+		bool
+		listen(const std::string& address);
+
+		bool									// false if no worker was connected for idle_timeout seconds before all the tiles were done
+		render(std::ostream& report, const double idle_timeout = 60.0);
+
+	private:
+
+		struct Worker {
+			int										fd;
+			int										pid;			// as the worker reports it
+			std::vector<int>						in_flight;		// tiles sent and not yet returned
+			std::vector<char>						buffer;			// bytes received that don't make a message yet
+			int										tiles_done;
+			long									pixels_done;
+			std::chrono::steady_clock::time_point	start;
+			double									seconds;		// connected time, once the worker has gone
+			bool									alive;
+		};
+
+		const World&			world;
+		std::string				address;
+		int						listen_fd;
+		std::vector<Worker>		workers;
+		std::vector<int>		queue;			// tiles to send, the next one at the back
+		std::vector<char>		done;
+		int						num_done;
+		std::vector<RGBColor>	pixels;
+
+		void
+		accept_worker(void);
+
+		void
+		assign_tiles(Worker& worker);
+
+		bool									// false, with the reason, if the worker has gone or broke the protocol
+		receive(Worker& worker, const char*& reason);
+
+		void									// puts the worker's tiles back in the queue
+		drop_worker(Worker& worker, std::ostream& report, const char* reason);
+
+		void
+		report_workers(std::ostream& report) const;
+};
+
+
+//------------------------------------------------------------------------------------ class RenderWorker
+
+class RenderWorker {
+	public:
+
+		RenderWorker(const World& w);
+
+		~RenderWorker(void);
+
+		bool									// keeps trying for timeout seconds, for workers started before the coordinator
+		connect(const std::string& address, const double timeout = 10.0);
+
+		bool									// renders tiles until the coordinator is done; false if the connection failed
+		serve(void);
+
+	private:
+
+		const World&	world;
+		int				fd;
+};
+
+#endif
@@ -0,0 +1,88 @@
+// This file contains the definitions of the functions that write and read PFM frame buffers
+// Files are written in the machine's byte order; files in the other order are swapped as they are read.
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "FloatImage.h"
+
+// ----------------------------------------------------------------------------- little_endian
+
+static bool
+little_endian(void) {
+	const uint16_t one = 1;
+
+	return (*(const uint8_t*)&one == 1);
+}
+
+
+// ----------------------------------------------------------------------------- swap_bytes
+
+static float
+swap_bytes(const float f) {
+	uint32_t bits;
+
+	memcpy(&bits, &f, sizeof(bits));
+	bits = (bits >> 24) | ((bits >> 8) & 0xff00) | ((bits << 8) & 0xff0000) | (bits << 24);
+
+	float swapped;
+	memcpy(&swapped, &bits, sizeof(swapped));
+
+	return (swapped);
+}
+
+
+// ----------------------------------------------------------------------------- write_float_image
+
+bool
+write_float_image(const std::string& file_name, const int hres, const int vres, const std::vector<RGBColor>& pixels) {
+	std::ofstream 		file(file_name, std::ios::binary | std::ios::trunc);
+	std::vector<float> 	components(3 * pixels.size());
+
+	for (int j = 0; j < (int)pixels.size(); j++) {
+		components[3 * j] 		= pixels[j].r;
+		components[3 * j + 1] 	= pixels[j].g;
+		components[3 * j + 2] 	= pixels[j].b;
+	}
+
+	file << "PF\n" << hres << " " << vres << "\n" << (little_endian() ? "-1.0" : "1.0") << "\n";
+	file.write((const char*)components.data(), components.size() * sizeof(float));
+	file.close();
+
+	return (!file.fail());
+}
+
+
+// ----------------------------------------------------------------------------- read_float_image
+
+bool
+read_float_image(const std::string& file_name, const int hres, const int vres, std::vector<RGBColor>& pixels) {
+	std::ifstream 	file(file_name, std::ios::binary);
+	std::string 	magic;
+	int 			width, height;
+	double 			scale;
+
+	if (!(file >> magic >> width >> height >> scale) || magic != "PF" || width != hres || height != vres
+		|| scale == 0.0)
+		return (false);
+
+	file.get();			// the one whitespace character before the data
+
+	std::vector<float> components(3 * hres * vres);
+
+	if (!file.read((char*)components.data(), components.size() * sizeof(float)))
+		return (false);
+
+	bool swap = (scale < 0.0) != little_endian();
+
+	pixels.resize(hres * vres);
+
+	for (int j = 0; j < hres * vres; j++) {
+		float* c = &components[3 * j];
+
+		pixels[j] = swap ? RGBColor(swap_bytes(c[0]), swap_bytes(c[1]), swap_bytes(c[2])) : RGBColor(c[0], c[1], c[2]);
+	}
+
+	return (true);
+}
@@ -0,0 +1,22 @@
+#ifndef __FLOAT_IMAGE__
+#define __FLOAT_IMAGE__
+
+// This file contains the declarations of the functions that write and read a frame buffer as a
+// Portable Float Map (PFM): a text header, "PF", the width and height, and a scale whose sign gives
+// the byte order, then the r, g, b components of every pixel as floats. The rows go from the bottom
+// of the image up, as they do in World's frame buffers.
+// The colours are kept as they were traced, before any tone mapping or gamma correction, so a render
+// of a few regions can be merged into the frame buffer of an earlier render (World::set_base_image).
+
+#include <string>
+#include <vector>
+
+#include "../Utilities/RGBColor.h"
+
+bool											// false if the file couldn't be written
+write_float_image(const std::string& file_name, const int hres, const int vres, const std::vector<RGBColor>& pixels);
+
+bool											// false, leaving pixels as they were, if the file can't be read or isn't hres by vres
+read_float_image(const std::string& file_name, const int hres, const int vres, std::vector<RGBColor>& pixels);
+
+#endif
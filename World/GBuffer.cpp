@@ -0,0 +1,103 @@
+// This file contains the definition of the class GBuffer
+
+#include <algorithm>
+
+#include "GBuffer.h"
+#include "World.h"
+#include "../GeometricObjects/GeometricObject.h"
+#include "../Materials/Material.h"
+#include "../Utilities/ShadeRec.h"
+
+// ----------------------------------------------------------------------------- constructor
+
+GBuffer::GBuffer(World& w)
+	: 	world_ptr(&w),
+		hres(0),
+		vres(0),
+		num_samples(0)
+{}
+
+
+// ----------------------------------------------------------------------------- prepare
+
+void
+GBuffer::prepare(const int _hres, const int _vres, const int _num_samples) {
+	if (_hres == hres && _vres == vres && _num_samples == num_samples)
+		return;
+
+	hres 		= _hres;
+	vres 		= _vres;
+	num_samples = _num_samples;
+
+	hits.assign(hres * vres * num_samples, Hit());
+	cached.assign(hres * vres, 0);
+}
+
+
+// ----------------------------------------------------------------------------- invalidate
+
+void
+GBuffer::invalidate(void) {
+	std::fill(cached.begin(), cached.end(), 0);
+}
+
+
+// ----------------------------------------------------------------------------- trace
+// as RayCast::trace_ray, with the hit kept
+
+RGBColor
+GBuffer::trace(const Ray& ray, const int r, const int c, const int j) {
+	double 					tmin;
+	const GeometricObject* 	object_ptr;
+	ShadeRec 				sr(world_ptr->hit_objects(ray, tmin, object_ptr));
+	Hit& 					hit = hits[(r * hres + c) * num_samples + j];
+
+	if (!sr.hit_an_object) {
+		hit.object_ptr = NULL;
+		return (world_ptr->background_color);
+	}
+
+	hit.object_ptr 			= object_ptr;
+	hit.t 					= tmin;
+	hit.normal 				= sr.normal;
+	hit.local_hit_point 	= sr.local_hit_point;
+
+	sr.ray = ray;
+
+	return (world_ptr->tracer_ptr->shade_hit(sr));
+}
+
+
+// ----------------------------------------------------------------------------- shade
+// the material is the object's current one, and the differentials are found again from the ray's
+
+RGBColor
+GBuffer::shade(const Ray& ray, const int r, const int c, const int j) const {
+	const Hit& hit = hits[(r * hres + c) * num_samples + j];
+
+	if (!hit.object_ptr)
+		return (world_ptr->background_color);
+
+	ShadeRec sr(*world_ptr);
+
+	sr.hit_an_object 	= true;
+	sr.material_ptr 	= hit.object_ptr->get_material();
+	sr.hit_point 		= ray.o + hit.t * ray.d;
+	sr.t 				= hit.t;
+	sr.normal 			= hit.normal;
+	sr.local_hit_point 	= hit.local_hit_point;
+	sr.ray 				= ray;
+
+	if (ray.has_differentials)
+		sr.set_differentials(ray, *hit.object_ptr);
+
+	return (world_ptr->tracer_ptr->shade_hit(sr));
+}
+
+
+// ----------------------------------------------------------------------------- bytes
+
+std::size_t
+GBuffer::bytes(void) const {
+	return (hits.size() * sizeof(Hit) + cached.size());
+}
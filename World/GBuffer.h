@@ -0,0 +1,93 @@
+#ifndef __G_BUFFER__
+#define __G_BUFFER__
+
+// This file contains the declaration of the class GBuffer, a cache of the camera rays' hits, for
+// relighting
+// Once a pixel has been traced, the G-buffer holds what World::hit_objects found for each of its
+// samples: the object, the ray parameter, the normal and the local hit point. The next render
+// remakes the camera rays, which is cheap, and shades the cached hits through the tracer's shade_hit
+// without intersecting anything, so edits to materials and lights, such as a Matte's cd and kd or a
+// Directional light's radiance, or a new material for an object, are rendered in a fraction of the
+// time. The hit points, and the differentials of rays that have them, are recomputed from the rays as
+// hit_objects computes them, so the image is the same as a full render's.
+// The cache is only right while the objects and the camera stay where they were: invalidate it when
+// they move. Animation::render_frames does that itself. The view plane's resolution or samples per
+// pixel changing resets it.
+// Shading goes through the virtual path, since the static dispatch path bakes the materials; and the
+// tracer has to shade hits through their materials (Tracer::shades_materials).
+// Each sample takes 64 bytes, so the G-buffer of a 400 by 400 image with 28 samples per pixel takes
+// 287 MB.
+
+#include <cstddef>
+#include <vector>
+
+#include "../Utilities/Normal.h"
+#include "../Utilities/Point3D.h"
+#include "../Utilities/Ray.h"
+#include "../Utilities/RGBColor.h"
+
+class GeometricObject;
+class World;
+
+//------------------------------------------------------------------------------------ class GBuffer
+
+class GBuffer {
+	public:
+
+		GBuffer(World& w);
+
+		void									// resets the cache if the resolution or samples per pixel have changed
+		prepare(const int hres, const int vres, const int num_samples);
+
+		void									// forgets every pixel, after the objects or the camera move
+		invalidate(void);
+
+		bool									// have the samples of the pixel in row r, from the bottom, and column c been cached?
+		has_pixel(const int r, const int c) const;
+
+		void									// once all of its samples have been traced
+		pixel_done(const int r, const int c);
+
+		RGBColor								// traces sample j of the pixel, and caches its hit
+		trace(const Ray& ray, const int r, const int c, const int j);
+
+		RGBColor								// shades the cached hit of sample j of the pixel, for ray
+		shade(const Ray& ray, const int r, const int c, const int j) const;
+
+		std::size_t
+		bytes(void) const;
+
+	private:
+
+		struct Hit {
+			const GeometricObject*	object_ptr;		// NULL for a ray that missed
+			double					t;
+			Normal					normal;
+			Point3D					local_hit_point;
+		};
+
+		World*				world_ptr;
+		int					hres;
+		int					vres;
+		int					num_samples;
+		std::vector<Hit>	hits;			// num_samples for each pixel, row by row from the bottom
+		std::vector<char>	cached;			// for each pixel
+};
+
+
+// ----------------------------------------------------------------------------- has_pixel
+
+inline bool
+GBuffer::has_pixel(const int r, const int c) const {
+	return (cached[r * hres + c] != 0);
+}
+
+
+// ----------------------------------------------------------------------------- pixel_done
+
+inline void
+GBuffer::pixel_done(const int r, const int c) {
+	cached[r * hres + c] = 1;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// This file contains the definition of the class Heatmap
+
+#include <algorithm>
+#include <fstream>
+
+#include "Heatmap.h"
+#include "../Utilities/RGBColor.h"
+
+// ----------------------------------------------------------------------------- false_colour
+// maps t in [0, 1] onto a black - blue - cyan - green - yellow - red - white ramp
+
+static RGBColor
+false_colour(float t) {
+	static const RGBColor ramp[] = {
+		RGBColor(0, 0, 0), RGBColor(0, 0, 1), RGBColor(0, 1, 1), RGBColor(0, 1, 0),
+		RGBColor(1, 1, 0), RGBColor(1, 0, 0), RGBColor(1, 1, 1)
+	};
+	static const int num_segments = sizeof(ramp) / sizeof(ramp[0]) - 1;
+
+	t = std::min(std::max(t, 0.0f), 1.0f) * num_segments;
+	int 	j = std::min((int)t, num_segments - 1);
+	float 	f = t - j;
+
+	return (ramp[j] * (1.0f - f) + ramp[j + 1] * f);
+}
+
+
+// ----------------------------------------------------------------------------- default constructor
+
+Heatmap::Heatmap(void)
+	: 	hres(0),
+		vres(0)
+{}
+
+
+// ----------------------------------------------------------------------------- resize
+
+void
+Heatmap::resize(const int _hres, const int _vres) {
+	hres = _hres;
+	vres = _vres;
+
+	for (int j = 0; j < HEATMAP_NUM_CHANNELS; j++)
+		channels[j].assign(hres * vres, 0);
+}
+
+
+// ----------------------------------------------------------------------------- channel_name
+
+const char*
+Heatmap::channel_name(const HeatmapChannel c) {
+	static const char* names[HEATMAP_NUM_CHANNELS] = {
+		"cycles",
+		"traversal_steps",
+		"intersection_tests"
+	};
+
+	return (names[c]);
+}
+
+
+// ----------------------------------------------------------------------------- write
+
+void
+Heatmap::write(const std::string& image_file) const {
+	std::string base = image_file;
+	size_t		dot	 = base.rfind('.');
+
+	if (dot != std::string::npos && base.find('/', dot) == std::string::npos)
+		base.erase(dot);
+
+	write_channel(HEATMAP_CYCLES, base + "." + channel_name(HEATMAP_CYCLES) + ".ppm");
+
+#ifdef RT_STATS
+	write_channel(HEATMAP_TRAVERSAL_STEPS, base + "." + channel_name(HEATMAP_TRAVERSAL_STEPS) + ".ppm");
+	write_channel(HEATMAP_INTERSECTION_TESTS, base + "." + channel_name(HEATMAP_INTERSECTION_TESTS) + ".ppm");
+#endif
+}
+
+
+// ----------------------------------------------------------------------------- write_channel
+// the colour ramp is scaled to the 99th percentile, so a handful of slow pixels
+// (page faults, preemption) don't flatten the rest of the image
+
+void
+Heatmap::write_channel(const HeatmapChannel c, const std::string& file_name) const {
+	const std::vector<uint64_t>& values = channels[c];
+
+	if (values.empty())
+		return;
+
+	std::vector<uint64_t> sorted(values);
+	size_t p99 = (sorted.size() - 1) * 99 / 100;
+	std::nth_element(sorted.begin(), sorted.begin() + p99, sorted.end());
+	double scale = sorted[p99] > 0 ? 1.0 / sorted[p99] : 0.0;
+
+	std::ofstream out(file_name);
+	out << "P3\n" << hres << " " << vres << "\n255\n";
+
+	for (int r = vres - 1; r >= 0; r--)			// from top
+		for (int col = 0; col < hres; col++) {
+			RGBColor colour = false_colour((float)(values[r * hres + col] * scale));
+			out << (int)(colour.r * 255) << " " << (int)(colour.g * 255) << " " << (int)(colour.b * 255) << "\n";
+		}
+}
@@ -0,0 +1,175 @@
+#ifndef __HEATMAP__
+#define __HEATMAP__
+
+// This file contains the declaration of the class Heatmap, a per-pixel cost AOV
+// While a heatmap is enabled, the render loop wraps each pixel in a PixelCostProbe and hands its
+// readings to Heatmap::record; otherwise no probe is taken.
+// Heatmap::write turns each channel into a false-colour image next to the rendered image.
+// Cycles are always recorded: rdtsc ticks on x86, steady_clock nanoseconds elsewhere.
+// Traversal steps and intersection tests come from the render statistics, so they are only
+// recorded in builds with RT_STATS.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+#include "../Utilities/Stats.h"
+
+//------------------------------------------------------------------------------------ channels
+
+enum HeatmapChannel {
+	HEATMAP_CYCLES,
+	HEATMAP_TRAVERSAL_STEPS,
+	HEATMAP_INTERSECTION_TESTS,
+	HEATMAP_NUM_CHANNELS
+};
+
+
+//------------------------------------------------------------------------------------ struct PixelCost
+
+struct PixelCost {
+	uint64_t	values[HEATMAP_NUM_CHANNELS];
+};
+
+
+//------------------------------------------------------------------------------------ class PixelCostProbe
+// takes its readings from the calling thread, so a probe must start and end on the same thread
+
+class PixelCostProbe {
+	public:
+
+		PixelCostProbe(void);
+
+		PixelCost
+		elapsed(void) const;
+
+		static uint64_t
+		ticks(void);
+
+	private:
+
+		PixelCost	start;
+
+		static PixelCost
+		read(void);
+};
+
+
+//------------------------------------------------------------------------------------ class Heatmap
+
+class Heatmap {
+	public:
+
+		Heatmap(void);
+
+		void									// clears the channels for a new frame
+		resize(const int hres, const int vres);
+
+		void
+		record(const int row, const int column, const PixelCost& cost);
+
+		PixelCost								// what record stored for the pixel
+		get(const int row, const int column) const;
+
+		void									// writes <base>.<channel>.ppm for image file <base>.ppm
+		write(const std::string& image_file) const;
+
+		static const char*
+		channel_name(const HeatmapChannel c);
+
+	private:
+
+		int						hres;
+		int						vres;
+		std::vector<uint64_t>	channels[HEATMAP_NUM_CHANNELS];		// row 0 is the bottom row, as in the view plane
+
+		void
+		write_channel(const HeatmapChannel c, const std::string& file_name) const;
+};
+
+
+// ----------------------------------------------------------------------------- ticks
+
+inline uint64_t
+PixelCostProbe::ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	return (__rdtsc());
+#else
+	return (std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+
+// ----------------------------------------------------------------------------- read
+
+inline PixelCost
+PixelCostProbe::read(void) {
+	PixelCost cost;
+	cost.values[HEATMAP_CYCLES] = ticks();
+
+#ifdef RT_STATS
+	const StatBlock& block = Stats::local();
+	cost.values[HEATMAP_TRAVERSAL_STEPS] 	= block.counters[STAT_TRAVERSAL_STEPS];
+	cost.values[HEATMAP_INTERSECTION_TESTS] = block.counters[STAT_INTERSECTION_TESTS];
+#else
+	cost.values[HEATMAP_TRAVERSAL_STEPS] 	= 0;
+	cost.values[HEATMAP_INTERSECTION_TESTS] = 0;
+#endif
+
+	return (cost);
+}
+
+
+// ----------------------------------------------------------------------------- constructor
+
+inline
+PixelCostProbe::PixelCostProbe(void)
+	: start(read())
+{}
+
+
+// ----------------------------------------------------------------------------- elapsed
+
+inline PixelCost
+PixelCostProbe::elapsed(void) const {
+	PixelCost now = read();
+
+	for (int j = 0; j < HEATMAP_NUM_CHANNELS; j++)
+		now.values[j] -= start.values[j];
+
+	return (now);
+}
+
+
+// ----------------------------------------------------------------------------- record
+
+inline void
+Heatmap::record(const int row, const int column, const PixelCost& cost) {
+	int index = row * hres + column;
+
+	for (int j = 0; j < HEATMAP_NUM_CHANNELS; j++)
+		channels[j][index] = cost.values[j];
+}
+
+
+// ----------------------------------------------------------------------------- get
+
+inline PixelCost
+Heatmap::get(const int row, const int column) const {
+	PixelCost 	cost;
+	int 		index = row * hres + column;
+
+	for (int j = 0; j < HEATMAP_NUM_CHANNELS; j++)
+		cost.values[j] = channels[j][index];
+
+	return (cost);
+}
+
+#endif
@@ -0,0 +1,222 @@
+// This file contains the definition of the class StaticScene
+
+#include <typeinfo>
+#include <unordered_map>
+
+#include "StaticScene.h"
+#include "World.h"
+#include "BVH.h"
+#include "../Tracers/RayCast.h"
+#include "../Utilities/Constants.h"
+#include "../Utilities/Stats.h"
+
+// the visitors call the concrete types' functions with qualified names, which bypasses the vtable
+// and lets the compiler inline them
+
+struct HitVisitor {
+	const Ray&	ray;
+	double&		t;
+	ShadeRec&	sr;
+
+	bool operator() (const Sphere* sphere_ptr) const	{ return (sphere_ptr->Sphere::hit(ray, t, sr)); }
+	bool operator() (const Plane* plane_ptr) const 		{ return (plane_ptr->Plane::hit(ray, t, sr)); }
+};
+
+struct MaterialVisitor {
+	template <typename Object>
+	Material* operator() (const Object* object_ptr) const	{ return (object_ptr->get_material()); }
+};
+
+struct DirectionVisitor {
+	ShadeRec&	sr;
+
+	Vector3D operator() (Directional* light_ptr) const	{ return (light_ptr->Directional::get_direction(sr)); }
+};
+
+struct RadianceVisitor {
+	ShadeRec&	sr;
+
+	RGBColor operator() (Directional* light_ptr) const	{ return (light_ptr->Directional::L(sr)); }
+};
+
+
+// ---------------------------------------------------------------- default constructor
+
+StaticScene::StaticScene(void)
+	: 	world_ptr(nullptr),
+		ambient_ptr(nullptr)
+{}
+
+
+// ---------------------------------------------------------------- compile
+// the types must match exactly: a subclass could override the functions that are called directly
+// the lights mustn't cast shadows, which shade_baked doesn't test for
+// materials shared by several objects get one id; objects without a material are accepted, as they
+// are by the virtual path, as long as they're never shaded
+
+bool
+StaticScene::compile(World& w) {
+	world_ptr = &w;
+	objects.clear();
+	object_indices.clear();
+	material_ids.clear();
+	material_records.clear();
+	lights.clear();
+
+	if (!w.tracer_ptr || typeid(*w.tracer_ptr) != typeid(RayCast))
+		return (false);
+
+	if (!w.ambient_ptr || typeid(*w.ambient_ptr) != typeid(Ambient))
+		return (false);
+
+	ambient_ptr = static_cast<Ambient*>(w.ambient_ptr);
+
+	std::unordered_map<const Material*, int> ids;
+
+	objects.reserve(w.objects.size());
+	material_ids.reserve(w.objects.size());
+
+	for (GeometricObject* object_ptr : w.objects) {
+		const Material* material_ptr = object_ptr->get_material();
+
+		if (typeid(*object_ptr) == typeid(Sphere))
+			objects.push_back(static_cast<const Sphere*>(object_ptr));
+		else if (typeid(*object_ptr) == typeid(Plane))
+			objects.push_back(static_cast<const Plane*>(object_ptr));
+		else
+			return (false);
+
+		object_indices.emplace(object_ptr, (int)objects.size() - 1);
+
+		if (!material_ptr) {
+			material_ids.push_back(-1);
+			continue;
+		}
+
+		std::unordered_map<const Material*, int>::const_iterator it = ids.find(material_ptr);
+
+		if (it == ids.end()) {
+			MaterialRecord record;
+
+			if (!material_ptr->finalize(record))
+				return (false);
+
+			it = ids.emplace(material_ptr, (int)material_records.size()).first;
+			material_records.push_back(record);
+		}
+
+		material_ids.push_back(it->second);
+	}
+
+	for (Light* light_ptr : w.lights)
+		if (typeid(*light_ptr) == typeid(Directional) && !light_ptr->casts_shadows())
+			lights.push_back(static_cast<Directional*>(light_ptr));
+		else
+			return (false);
+
+	return (true);
+}
+
+
+// ---------------------------------------------------------------- nearest_hit
+// the same loop, and statistics, as World::hit_objects, or the same traversal of the world's BVH
+
+int
+StaticScene::nearest_hit(const Ray& ray, ShadeRec& sr) const {
+	double		t;
+	Normal 		normal;
+	Point3D 	local_hit_point;
+	double		tmin 			= kHugeValue;
+	int 		num_objects 	= objects.size();
+	int			nearest			= -1;
+	HitVisitor	hit 			= {ray, t, sr};
+
+	STATS_TIMER(STAT_TIME_HIT_OBJECTS);
+	STATS_INC(STAT_RAYS);
+
+	if (world_ptr->bvh_ptr) {
+		const GeometricObject* object_ptr = world_ptr->bvh_ptr->nearest_hit(ray, sr, tmin);
+
+		if (object_ptr) {
+			nearest 			= object_indices.at(object_ptr);
+			normal 				= sr.normal;
+			local_hit_point 	= sr.local_hit_point;
+		}
+	}
+	else {
+		STATS_ADD(STAT_TRAVERSAL_STEPS, num_objects);
+		STATS_ADD(STAT_INTERSECTION_TESTS, num_objects);
+
+		for (int j = 0; j < num_objects; j++)
+			if (std::visit(hit, objects[j]) && (t < tmin)) {
+				tmin 				= t;
+				nearest				= j;
+				normal 				= sr.normal;
+				local_hit_point	 	= sr.local_hit_point;
+			}
+	}
+
+	if (nearest >= 0) {
+		STATS_INC(STAT_HITS);
+		sr.hit_an_object	= true;
+		sr.material_ptr		= std::visit(MaterialVisitor(), objects[nearest]);
+		sr.hit_point 		= ray.o + tmin * ray.d;
+		sr.t 				= tmin;
+		sr.normal 			= normal;
+		sr.local_hit_point 	= local_hit_point;
+	}
+
+	return (nearest);
+}
+
+
+// ---------------------------------------------------------------- hit_objects
+
+ShadeRec
+StaticScene::hit_objects(const Ray& ray) const {
+	ShadeRec sr(*world_ptr);
+	nearest_hit(ray, sr);
+	return (sr);
+}
+
+
+// ---------------------------------------------------------------- trace_ray
+
+RGBColor
+StaticScene::trace_ray(const Ray& ray) const {
+	ShadeRec 	sr(*world_ptr);
+	int 		nearest = nearest_hit(ray, sr);
+
+	if (nearest >= 0) {
+		sr.ray = ray;
+		STATS_TIMER(STAT_TIME_SHADE);
+		STATS_INC(STAT_SHADE_CALLS);
+		return (Matte::shade_baked(sr, material_records[material_ids[nearest]], *this));
+	}
+	else
+		return (world_ptr->background_color);
+}
+
+
+// ---------------------------------------------------------------- ambient_L
+
+RGBColor
+StaticScene::ambient_L(ShadeRec& sr) const {
+	return (ambient_ptr->Ambient::L(sr));
+}
+
+
+// ---------------------------------------------------------------- get_direction
+
+Vector3D
+StaticScene::get_direction(const int j, ShadeRec& sr) const {
+	return (std::visit(DirectionVisitor{sr}, lights[j]));
+}
+
+
+// ---------------------------------------------------------------- L
+
+RGBColor
+StaticScene::L(const int j, ShadeRec& sr) const {
+	return (std::visit(RadianceVisitor{sr}, lights[j]));
+}
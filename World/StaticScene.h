@@ -0,0 +1,90 @@
+#ifndef __STATIC_SCENE__
+#define __STATIC_SCENE__
+
+// This file contains the declaration of the class StaticScene, the static dispatch rendering path
+// The normal path traces through virtual calls: GeometricObject::hit, Material::shade, BRDF::f and
+// rho, and Light::get_direction and L, none of which the compiler can inline. A StaticScene is
+// compiled from a World whose objects and lights all belong to the closed sets of types below, and
+// whose materials can all be finalized. It stores the objects and lights as std::variants of pointers
+// and dispatches with std::visit, which is a switch on the type index followed by a direct,
+// inlinable call. The materials are baked into a table of MaterialRecords indexed by material id,
+// and shaded by Matte::shade_baked.
+// It stands in for the RayCast tracer. compile returns false if the tracer, any object or light, or
+// any material's finalize, doesn't fit, and the World then renders through the virtual path.
+// To add an object or light type, add it to the variant and to the matching visitor in
+// StaticScene.cpp; its hit, or get_direction and L, must be defined in its header.
+// When the World has a BVH (World/BVH.h), the nearest hit is found by traversing it, as the virtual
+// path does; the tree calls the objects' hit functions through the vtable, but the shading stays static.
+
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "../GeometricObjects/Plane.h"
+#include "../GeometricObjects/Sphere.h"
+#include "../Lights/Ambient.h"
+#include "../Lights/Directional.h"
+#include "../Materials/MaterialRecord.h"
+#include "../Materials/Matte.h"
+#include "../Utilities/Ray.h"
+#include "../Utilities/RGBColor.h"
+#include "../Utilities/ShadeRec.h"
+
+class World;
+
+typedef std::variant<const Sphere*, const Plane*>	StaticObject;
+typedef std::variant<Directional*>					StaticLight;		// Light::L isn't const
+
+//----------------------------------------------------------------------------- class StaticScene
+
+class StaticScene {
+	public:
+
+		StaticScene(void);
+
+		bool									// false if the world has a type outside the closed sets
+		compile(World& w);
+
+		ShadeRec								// as World::hit_objects
+		hit_objects(const Ray& ray) const;
+
+		RGBColor								// as RayCast::trace_ray
+		trace_ray(const Ray& ray) const;
+
+		// the lights, for Matte::shade_static
+
+		RGBColor
+		ambient_L(ShadeRec& sr) const;
+
+		int
+		num_lights(void) const;
+
+		Vector3D
+		get_direction(const int j, ShadeRec& sr) const;
+
+		RGBColor
+		L(const int j, ShadeRec& sr) const;
+
+	private:
+
+		World*							world_ptr;
+		std::vector<StaticObject>		objects;
+		std::vector<int>				material_ids;	// of objects[j], -1 for none
+		std::unordered_map<const GeometricObject*, int>	object_indices;		// into objects, for the hits of the world's BVH
+		std::vector<MaterialRecord>		material_records;
+		Ambient*						ambient_ptr;
+		std::vector<StaticLight>		lights;
+
+		int										// the index of the nearest object hit, or -1
+		nearest_hit(const Ray& ray, ShadeRec& sr) const;
+};
+
+
+// ---------------------------------------------------------------- num_lights
+
+inline int
+StaticScene::num_lights(void) const {
+	return ((int)lights.size());
+}
+
+#endif
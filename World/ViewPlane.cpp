@@ -11,7 +11,9 @@ ViewPlane::ViewPlane()
 		num_samples(1),
 		gamma(1.0),
 		inv_gamma(1.0),
-		show_out_of_gamut(false)
+		show_out_of_gamut(false),
+		motion_blur(false),
+		ray_differentials(false)
 {}
 
 
@@ -24,7 +26,9 @@ ViewPlane::ViewPlane(const ViewPlane& vp)
 		num_samples(vp.num_samples),
 		gamma(vp.gamma),
 		inv_gamma(vp.inv_gamma),
-		show_out_of_gamut(vp.show_out_of_gamut)
+		show_out_of_gamut(vp.show_out_of_gamut),
+		motion_blur(vp.motion_blur),
+		ray_differentials(vp.ray_differentials)
 {}
 
 
@@ -42,6 +46,8 @@ ViewPlane::operator= (const ViewPlane& rhs) {
 	gamma				= rhs.gamma;
 	inv_gamma			= rhs.inv_gamma;
 	show_out_of_gamut	= rhs.show_out_of_gamut;
+	motion_blur			= rhs.motion_blur;
+	ray_differentials	= rhs.ray_differentials;
 	
 	return (*this);
 }
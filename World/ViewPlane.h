@@ -16,6 +16,8 @@ class ViewPlane {
 		float			gamma;						// gamma correction factor
 		float			inv_gamma;					// the inverse of the gamma correction factor
 		bool			show_out_of_gamut;			// display red if RGBColor out of gamut
+		bool			motion_blur;				// do the primary rays get times from the sampler, or time 0?
+		bool			ray_differentials;			// do the primary rays carry differentials, for texture filtering?
 		
 									
 	
@@ -46,6 +48,12 @@ class ViewPlane {
 
         void
         set_sampler(Sampler*);
+
+		void
+		set_motion_blur(bool blur);
+
+		void
+		set_ray_differentials(bool differentials);
 };
 
 
@@ -92,4 +100,20 @@ ViewPlane::set_gamut_display(const bool show) {
 }
 
 
+// ------------------------------------------------------------------------------ set_motion_blur
+
+inline void
+ViewPlane::set_motion_blur(const bool blur) {
+	motion_blur = blur;
+}
+
+
+// ------------------------------------------------------------------------------ set_ray_differentials
+
+inline void
+ViewPlane::set_ray_differentials(const bool differentials) {
+	ray_differentials = differentials;
+}
+
+
 #endif
\ No newline at end of file
@@ -1,6 +1,20 @@
 // this file contains the definition of the World class
 
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <thread>
+
 #include "World.h"
+#include "Checkpoint.h"
+#include "FloatImage.h"
+#include "GBuffer.h"
+#include "../Textures/TileCache.h"
+#include "StaticScene.h"
+#include "../Lights/LightBVH.h"
+#include "BVH.h"
 #include "../Utilities/Constants.h"
 
 // geometric objects
@@ -32,6 +46,8 @@
 #include "../Utilities/Normal.h"
 #include "../Utilities/ShadeRec.h"
 #include "../Utilities/Maths.h"
+#include "../Utilities/Stats.h"
+#include "../Utilities/Timeline.h"
 #include "../Samplers/PureRandom.h"
 #include "../Samplers/Regular.h"
 #include "../Samplers/Jittered.h"
@@ -47,14 +63,28 @@
 // tracer_ptr is set to NULL because the build functions will always construct the appropriate tracer
 // ambient_ptr is set to a default ambient light because this will do for most scenes
 // camera_ptr is set to NULL because the build functions will always have to construct a camera
-// and set its parameters
+// and set its parameters; until they do, the scene is viewed orthographically along -z from z = 100
 
 World::World()
 	:  	background_color(black),
 		tracer_ptr(nullptr),
 		ambient_ptr(new Ambient),
-		camera_ptr(nullptr)
-{}
+		camera_ptr(nullptr),
+		output_file("image.ppm"),
+		heatmap_ptr(nullptr),
+		num_threads(0),
+		tile_size(16),
+		static_scene_ptr(nullptr),
+		light_bvh_ptr(nullptr),
+		bvh_ptr(nullptr),
+		gbuffer_ptr(nullptr),
+		texture_cache_ptr(nullptr),
+		checkpoint_interval(60.0)
+{
+	orthographic.set_eye(0, 0, 100);
+	orthographic.set_lookat(0, 0, 0);
+	orthographic.compute_uvw();
+}
 
 
 
@@ -78,49 +108,467 @@ World::~World() {
 		delete camera_ptr;
 		camera_ptr = nullptr;
 	}
+
+	if (heatmap_ptr) {
+		delete heatmap_ptr;
+		heatmap_ptr = nullptr;
+	}
+
+	if (static_scene_ptr) {
+		delete static_scene_ptr;
+		static_scene_ptr = nullptr;
+	}
+
+	if (light_bvh_ptr) {
+		delete light_bvh_ptr;
+		light_bvh_ptr = nullptr;
+	}
+
+	if (bvh_ptr) {
+		delete bvh_ptr;
+		bvh_ptr = nullptr;
+	}
+
+	if (gbuffer_ptr) {
+		delete gbuffer_ptr;
+		gbuffer_ptr = nullptr;
+	}
 	
 	delete_objects();	
 	delete_lights();				
+
+	if (texture_cache_ptr) {
+		delete texture_cache_ptr;
+		texture_cache_ptr = nullptr;
+	}
 }
 
 
 //------------------------------------------------------------------ render_scene
 
-// This uses orthographic viewing along the zw axis
+// This is the one render loop, whatever the camera: the cameras only make the rays.
+// It uses the camera if one is set, and otherwise orthographic viewing along the z axis.
+// The view plane is split into square tiles that worker threads take in order from a shared counter.
+// Every worker shades into the frame buffer with its own copy of the sampler, and reseeds its random
+// engine at the start of every tile, so the image doesn't depend on which thread rendered which tile.
+// The frame buffer is written out once all tiles are done.
+// With a checkpoint file, the tiles it holds are copied into the frame buffer instead of being
+// rendered, the finished tiles are saved to it as the render goes, and it is removed at the end.
+// With regions, only their pixels are traced, and the tiles without any aren't rendered at all; the
+// other pixels come from the base image if it can be read and has the view plane's size, and are
+// otherwise black, with a warning. Writing the frame buffer as floats (set_float_output) to the base
+// image's file merges the regions into it, so a look can be refined one region at a time.
+// With a G-buffer, the pixels it has cached are shaded from their cached hits instead of being traced.
 
 void 												
 World::render_scene() const {
+	STATS_TIMER(STAT_TIME_RENDER);
+	TIMELINE_SCOPE("render_scene", "render");
+
+	std::vector<RGBColor>	pixels(vp.hres * vp.vres);
+	int						tiles_total		= num_tiles();
+	std::vector<int>		tiles;			// the tiles to render
+	std::atomic<int>		next_tile(0);
+	int						num_workers		= num_threads > 0 ? num_threads : (int)std::thread::hardware_concurrency();
+	std::unique_ptr<Checkpoint>	checkpoint_ptr;
+
+	if (!checkpoint_file.empty()) {
+		checkpoint_ptr.reset(new Checkpoint(checkpoint_file, checkpoint_interval, vp.hres, vp.vres, tile_size,
+											vp.num_samples, tiles_total));
+		checkpoint_ptr->load();
+	}
+
+	if (!load_base_image(pixels))
+		std::cerr << "can't read " << base_file << " as a " << vp.hres << " by " << vp.vres
+				  << " float image; the pixels outside the regions will be black\n";
+
+	if (gbuffer_ptr)
+		gbuffer_ptr->prepare(vp.hres, vp.vres, vp.num_samples);
+
+	tiles.reserve(tiles_total);
+
+	for (int tile = 0; tile < tiles_total; tile++)
+		if ((!checkpoint_ptr || !set_tile(tile, checkpoint_ptr->get_tile(tile), pixels)) && tile_in_regions(tile))
+			tiles.push_back(tile);
+
+	num_workers = std::max(1, std::min(num_workers, (int)tiles.size()));
+
+	if (heatmap_ptr)
+		heatmap_ptr->resize(vp.hres, vp.vres);
 
-	RGBColor	pixel_color;	 	
-	Ray			ray;
-	float		zw		= 100.0;				// hardwired in
-	Point2D     sp;
-	Point2D     pp;
+	auto worker = [&](const int id) {
+		TIMELINE_THREAD_NAME("worker " + std::to_string(id));
+		std::unique_ptr<Sampler> 	sampler_ptr(vp.sampler_ptr->clone());
+		std::vector<RGBColor>		tile_pixels;
 
-	ray.d = Vector3D(0, 0, -1);
+		for (int j = next_tile++; j < (int)tiles.size(); j = next_tile++) {
+			render_tile(tiles[j], *sampler_ptr, pixels);
+
+			if (checkpoint_ptr) {
+				get_tile(tiles[j], pixels, tile_pixels);
+				checkpoint_ptr->tile_done(tiles[j], tile_pixels);
+			}
+		}
+	};
+
+	if (num_workers == 1)
+		worker(0);
+	else {
+		std::vector<std::thread> threads;
+
+		for (int id = 0; id < num_workers; id++)
+			threads.emplace_back(worker, id);
+
+		for (std::thread& t : threads)
+			t.join();
+	}
+
+	if (write_image(pixels) && checkpoint_ptr)
+		checkpoint_ptr->remove();
+}
+
+
+//------------------------------------------------------------------ write_image
+// writes the frame buffer, and the heatmap if it is enabled, to output_file, and the frame buffer as
+// floats to float_file if it is set
+
+bool
+World::write_image(const std::vector<RGBColor>& pixels) const {
+	TIMELINE_SCOPE("output", "io");
 
     std::ofstream myFile;
-    myFile.open("image.ppm");
+    myFile.open(output_file);
 
     myFile << "P3\n" << vp.vres << " " << vp.hres << " " << "\n255\n";
 
     for (int r = vp.vres-1; r >= 0; r--)			// from top
-        for (int c = 0; c < vp.hres; c++) {	// across
+        for (int c = 0; c < vp.hres; c++)			// across
+            display_pixel(r, c, pixels[r * vp.hres + c], myFile);
+
+    if (heatmap_ptr)
+        heatmap_ptr->write(output_file);
+
+    myFile.close();
+
+    bool floats_written = float_file.empty() || write_float_image(float_file, vp.hres, vp.vres, pixels);
+
+    return (!myFile.fail() && floats_written);
+}
+
+
+//------------------------------------------------------------------ num_tiles
+
+int
+World::num_tiles(void) const {
+	int tiles_across	= (vp.hres + tile_size - 1) / tile_size;
+	int tiles_up		= (vp.vres + tile_size - 1) / tile_size;
+
+	return (tiles_across * tiles_up);
+}
+
+
+//------------------------------------------------------------------ render_tile
+
+// Renders the pixels of one tile into the frame buffer. Tiles are numbered from the top row of
+// tiles down, and row r = 0 of the view plane is its bottom row.
+// The rays come from the camera if one is set, and are otherwise orthographic along the z axis.
+// The samples of a pixel are all taken, and their rays made in one call to the camera's get_rays,
+// before any of them is traced. A ray without a direction, outside a fisheye camera's image circle,
+// is black.
+// With motion blur, each ray takes its time in the shutter interval from the sampler.
+// When the view plane asks for ray differentials, the camera adds them to the rays.
+// With a G-buffer, a pixel's rays are traced through it the first time, and shaded from their cached
+// hits after that; it takes the place of the static dispatch path, whose materials are baked.
+// Pixels outside the regions, if there are any, are left as they are in the frame buffer; their
+// samples are still taken, so the sampler is where it would be for the next pixel in a full render;
+// shading that draws random numbers, such as area lights, still makes the region pixels differ from it.
+
+void
+World::render_tile(const int tile, Sampler& sampler, std::vector<RGBColor>& pixels) const {
+	TIMELINE_SCOPE_ARG("tile", "render", tile);
+
+	RGBColor				pixel_color;
+	const Camera&			camera	= camera_ptr ? *camera_ptr : static_cast<const Camera&>(orthographic);
+	float					exposure_time = camera.get_exposure_time();
+	Point2D     			sp;
+	std::vector<Point2D>	pps(vp.num_samples);
+	std::vector<Ray>		rays(vp.num_samples);
+
+	int 		r_min, r_max, c_min, c_max;
+
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+	set_rand_seed(tile);
+
+    for (int r = r_max - 1; r >= r_min; r--)			// from top
+        for (int c = c_min; c < c_max; c++) {		// across
+            std::optional<PixelCostProbe> probe;
+            if (heatmap_ptr)
+                probe.emplace();
             pixel_color = black;
             for (int j = 0; j < vp.num_samples; j++) {
-                sp = vp.sampler_ptr->sample_unit_square();
-                //std::cout << sp.x << " ";
-                pp.x = vp.s * (c - 0.5 * vp.hres + sp.x);
-                pp.y = vp.s * (r - 0.5 * vp.vres + sp.y);
-                ray.o = Point3D(pp.x, pp.y, zw);
-                pixel_color += tracer_ptr->trace_ray(ray);
+                sp = sampler.sample_unit_square();
+                pps[j].x = vp.s * (c - 0.5 * vp.hres + sp.x);
+                pps[j].y = vp.s * (r - 0.5 * vp.vres + sp.y);
+                rays[j].time = vp.motion_blur ? sampler.sample_time() : 0.0;
             }
+            if (!regions.empty() && !in_regions(r, c))
+                continue;
+            camera.get_rays(vp, pps.data(), rays.data(), vp.num_samples);
+            if (vp.ray_differentials)
+                for (int j = 0; j < vp.num_samples; j++)
+                    camera.get_differentials(vp, pps[j], rays[j]);
+            bool cached = gbuffer_ptr && gbuffer_ptr->has_pixel(r, c);
+            for (int j = 0; j < vp.num_samples; j++) {
+                const Ray& ray = rays[j];
+                if (ray.d.x == 0.0 && ray.d.y == 0.0 && ray.d.z == 0.0)
+                    continue;
+                if (cached) {
+                    pixel_color += gbuffer_ptr->shade(ray, r, c, j);
+                    continue;
+                }
+                STATS_INC(STAT_PRIMARY_RAYS);
+                if (gbuffer_ptr)
+                    pixel_color += gbuffer_ptr->trace(ray, r, c, j);
+                else if (static_scene_ptr)
+                    pixel_color += static_scene_ptr->trace_ray(ray);
+                else
+                    pixel_color += tracer_ptr->trace_ray(ray);
+            }
+            if (gbuffer_ptr)
+                gbuffer_ptr->pixel_done(r, c);
             pixel_color /= (float) vp.num_samples;
-            display_pixel(r, c, pixel_color, myFile);
+            pixel_color *= exposure_time;
+            if (heatmap_ptr)
+                heatmap_ptr->record(r, c, probe->elapsed());
+            pixels[r * vp.hres + c] = pixel_color;
 		}	
 }
 
 
+//------------------------------------------------------------------ get_tile
+// copies a tile out of the frame buffer, from its top row down, as render_tile renders it
+
+void
+World::get_tile(const int tile, const std::vector<RGBColor>& pixels, std::vector<RGBColor>& tile_pixels) const {
+	int r_min, r_max, c_min, c_max;
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+
+	tile_pixels.clear();
+
+	for (int r = r_max - 1; r >= r_min; r--)
+		for (int c = c_min; c < c_max; c++)
+			tile_pixels.push_back(pixels[r * vp.hres + c]);
+}
+
+
+//------------------------------------------------------------------ set_tile
+// copies a tile from get_tile into the frame buffer; false, leaving the buffer as it was, if
+// tile_pixels isn't the size of the tile
+// with regions, only the tile's pixels in them are copied, so the others keep the base image's colours
+
+bool
+World::set_tile(const int tile, const std::vector<RGBColor>& tile_pixels, std::vector<RGBColor>& pixels) const {
+	int r_min, r_max, c_min, c_max;
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+
+	if ((int)tile_pixels.size() != (r_max - r_min) * (c_max - c_min))
+		return (false);
+
+	std::vector<RGBColor>::const_iterator it = tile_pixels.begin();
+
+	for (int r = r_max - 1; r >= r_min; r--)
+		for (int c = c_min; c < c_max; c++, it++)
+			if (regions.empty() || in_regions(r, c))
+				pixels[r * vp.hres + c] = *it;
+
+	return (true);
+}
+
+
+//------------------------------------------------------------------ get_tile_costs
+// for a worker to send back with the tile's pixels; the heatmap must be enabled
+
+void
+World::get_tile_costs(const int tile, std::vector<PixelCost>& tile_costs) const {
+	int r_min, r_max, c_min, c_max;
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+
+	tile_costs.clear();
+
+	for (int r = r_max - 1; r >= r_min; r--)
+		for (int c = c_min; c < c_max; c++)
+			tile_costs.push_back(heatmap_ptr->get(r, c));
+}
+
+
+//------------------------------------------------------------------ set_tile_costs
+// like set_tile, only the pixels in the regions are recorded
+
+bool
+World::set_tile_costs(const int tile, const std::vector<PixelCost>& tile_costs) const {
+	int r_min, r_max, c_min, c_max;
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+
+	if ((int)tile_costs.size() != (r_max - r_min) * (c_max - c_min))
+		return (false);
+
+	std::vector<PixelCost>::const_iterator it = tile_costs.begin();
+
+	for (int r = r_max - 1; r >= r_min; r--)
+		for (int c = c_min; c < c_max; c++, it++)
+			if (regions.empty() || in_regions(r, c))
+				heatmap_ptr->record(r, c, *it);
+
+	return (true);
+}
+
+
+//------------------------------------------------------------------ tile_bounds
+
+void
+World::tile_bounds(const int tile, int& r_min, int& r_max, int& c_min, int& c_max) const {
+	int tiles_across = (vp.hres + tile_size - 1) / tile_size;
+
+	r_max	= vp.vres - (tile / tiles_across) * tile_size;		// one past the tile's top row
+	r_min	= std::max(0, r_max - tile_size);
+	c_min	= (tile % tiles_across) * tile_size;
+	c_max	= std::min(vp.hres, c_min + tile_size);
+}
+
+
+//------------------------------------------------------------------ in_regions
+
+bool
+World::in_regions(const int r, const int c) const {
+	int y = vp.vres - 1 - r;
+
+	for (const PixelRegion& region : regions)
+		if (c >= region.x_min && c < region.x_max && y >= region.y_min && y < region.y_max)
+			return (true);
+
+	return (false);
+}
+
+
+//------------------------------------------------------------------ tile_in_regions
+// true for every tile when there are no regions
+
+bool
+World::tile_in_regions(const int tile) const {
+	int r_min, r_max, c_min, c_max;
+	tile_bounds(tile, r_min, r_max, c_min, c_max);
+
+	int y_min = vp.vres - r_max;		// the tile's rows, down from the top
+	int y_max = vp.vres - r_min;
+
+	for (const PixelRegion& region : regions)
+		if (c_min < region.x_max && region.x_min < c_max && y_min < region.y_max && region.y_min < y_max)
+			return (true);
+
+	return (regions.empty());
+}
+
+
+//------------------------------------------------------------------ load_base_image
+// a base image that can't be read, or has a different size, leaves the pixels as they are
+
+bool
+World::load_base_image(std::vector<RGBColor>& pixels) const {
+	return (regions.empty() || base_file.empty() || read_float_image(base_file, vp.hres, vp.vres, pixels));
+}
+
+
+//------------------------------------------------------------------ set_crop_window
+// the region covers every pixel that the window overlaps
+
+void
+World::set_crop_window(const float x_min, const float y_min, const float x_max, const float y_max) {
+	add_region((int)floor(x_min * vp.hres), (int)floor(y_min * vp.vres),
+			   (int)ceil(x_max * vp.hres), (int)ceil(y_max * vp.vres));
+}
+
+
+// ------------------------------------------------------------------ enable_heatmap
+// makes render_scene record the cost of every pixel and write it out next to the image
+
+void
+World::enable_heatmap() {
+	if (!heatmap_ptr)
+		heatmap_ptr = new Heatmap;
+}
+
+
+// ------------------------------------------------------------------ enable_static_dispatch
+// makes render_scene trace through a StaticScene instead of the tracer's virtual calls
+// this must be called after the scene is built, and returns false, leaving the virtual path in use,
+// if the scene has a type that the static path doesn't handle
+
+bool
+World::enable_static_dispatch() {
+	StaticScene* scene_ptr = new StaticScene;
+
+	if (!scene_ptr->compile(*this)) {
+		delete scene_ptr;
+		return (false);
+	}
+
+	delete static_scene_ptr;
+	static_scene_ptr = scene_ptr;
+
+	return (true);
+}
+
+
+// ------------------------------------------------------------------ enable_light_bvh
+// makes shading sample num_samples lights per hit from a light BVH over the lights with bounds,
+// instead of looping over all of them; the lights at infinity are still sampled at every hit
+// this must be called after the scene is built
+
+void
+World::enable_light_bvh(const int num_samples) {
+	delete light_bvh_ptr;
+	light_bvh_ptr = new LightBVH(lights, num_samples);
+}
+
+
+// ------------------------------------------------------------------ enable_bvh
+// makes hit_objects and any_hit traverse a BVH over the objects instead of testing all of them
+// this must be called after the scene is built, and again if objects are added or replaced; objects
+// that only move are handled by BVH::update
+
+void
+World::enable_bvh(const double rebuild_threshold) {
+	delete bvh_ptr;
+	bvh_ptr = new BVH(objects, rebuild_threshold);
+}
+
+
+// ------------------------------------------------------------------ set_texture_cache
+// the textures that read through the old cache must have been replaced
+
+void
+World::set_texture_cache(TileCache* cache_ptr) {
+	delete texture_cache_ptr;
+	texture_cache_ptr = cache_ptr;
+}
+
+
+// ------------------------------------------------------------------ enable_gbuffer
+// makes render_scene cache the hits of the camera rays, and shade them from the cache in later renders
+// returns false, leaving the G-buffer off, if the tracer doesn't shade hits through their materials
+
+bool
+World::enable_gbuffer() {
+	if (!tracer_ptr || !tracer_ptr->shades_materials())
+		return (false);
+
+	if (!gbuffer_ptr)
+		gbuffer_ptr = new GBuffer(*this);
+
+	return (true);
+}
+
+
 // ------------------------------------------------------------------ clamp
 
 RGBColor
@@ -184,16 +632,55 @@ World::display_pixel(const int row, const int column, const RGBColor& raw_color,
 }
 
 // ----------------------------------------------------------------------------- hit_objects
+// with a BVH the tree is traversed instead of the object list; it finds the same hit
 
 ShadeRec									
 World::hit_objects(const Ray& ray) {
+	double 					tmin;
+	const GeometricObject* 	object_ptr;
+
+	return (hit_objects(ray, tmin, object_ptr));
+}
+
+
+// ----------------------------------------------------------------------------- hit_objects
+// tmin is the ray parameter of the hit, in double, from which the hit point is computed
+// a ray with differentials gives the hit the footprint of its pixel (ShadeRec::set_differentials)
+
+ShadeRec
+World::hit_objects(const Ray& ray, double& tmin, const GeometricObject*& object_ptr) {
 
 	ShadeRec	sr(*this); 
 	double		t;
 	Normal normal;
 	Point3D local_hit_point;
-	double		tmin 			= kHugeValue;
 	int 		num_objects 	= objects.size();
+
+	tmin 		= kHugeValue;
+	object_ptr 	= NULL;
+
+	STATS_TIMER(STAT_TIME_HIT_OBJECTS);
+	STATS_INC(STAT_RAYS);
+
+	if (bvh_ptr) {
+		object_ptr = bvh_ptr->nearest_hit(ray, sr, tmin);
+
+		if (object_ptr) {
+			STATS_INC(STAT_HITS);
+			sr.hit_an_object	= true;
+			sr.material_ptr     = object_ptr->get_material();
+			sr.hit_point 		= ray.o + tmin * ray.d;
+			sr.t 				= tmin;
+
+			if (ray.has_differentials)
+				sr.set_differentials(ray, *object_ptr);
+		}
+
+		return (sr);
+	}
+
+	STATS_ADD(STAT_TRAVERSAL_STEPS, num_objects);		// the object list is walked in full
+	STATS_ADD(STAT_INTERSECTION_TESTS, num_objects);
 	
 	for (int j = 0; j < num_objects; j++)
 		if (objects[j]->hit(ray, t, sr) && (t < tmin)) {
@@ -203,18 +690,45 @@ World::hit_objects(const Ray& ray) {
 			sr.hit_point 		= ray.o + t * ray.d;
 			normal 				= sr.normal;
 			local_hit_point	 	= sr.local_hit_point;
+			object_ptr 			= objects[j];
 		}
   
 	if(sr.hit_an_object) {
+		STATS_INC(STAT_HITS);
 		sr.t = tmin;
 		sr.normal = normal;
 		sr.local_hit_point = local_hit_point;
+
+		if (ray.has_differentials)
+			sr.set_differentials(ray, *object_ptr);
 	}
 		
 	return(sr);   
 }
 
 
+// ----------------------------------------------------------------------------- any_hit
+// the occlusion query for shadow rays: stops at the first object that blocks the ray before t_max,
+// and skips the objects that don't cast shadows, such as the surfaces of area lights
+
+bool
+World::any_hit(const Ray& ray, const double t_max) const {
+	double	t;
+	int 	num_objects = objects.size();
+
+	STATS_INC(STAT_SHADOW_RAYS);
+
+	if (bvh_ptr)
+		return (bvh_ptr->any_hit(ray, t_max));
+
+	for (int j = 0; j < num_objects; j++)
+		if (objects[j]->casts_shadows() && objects[j]->shadow_hit(ray, t) && t < t_max)
+			return (true);
+
+	return (false);
+}
+
+
 
 //------------------------------------------------------------------ delete_objects
 
@@ -250,6 +764,9 @@ World::delete_lights(void) {
 
 void
 World::build() {
+    STATS_TIMER(STAT_TIME_BUILD);
+    TIMELINE_SCOPE("build", "scene");
+
     int num_samples = 28;
 
     // view plane
@@ -271,14 +788,14 @@ World::build() {
     tracer_ptr = new RayCast(this);
 
 
-    // camera
+    // camera - none, so the scene is viewed orthographically; render_tile uses the camera once one is set
 
-    auto* pinhole_ptr = new Pinhole;
-    pinhole_ptr->set_eye(0, 0, 500);
-    pinhole_ptr->set_lookat(0.0);
-    pinhole_ptr->set_view_distance(300.0);
-    pinhole_ptr->compute_uvw();
-    set_camera(pinhole_ptr);
+    //auto* pinhole_ptr = new Pinhole;
+    //pinhole_ptr->set_eye(0, 0, 500);
+    //pinhole_ptr->set_lookat(0.0);
+    //pinhole_ptr->set_view_distance(300.0);
+    //pinhole_ptr->compute_uvw();
+    //set_camera(pinhole_ptr);
 
 
     // light
@@ -14,8 +14,10 @@
 
 #include <vector>
 #include <fstream>
+#include <string>
 
 #include "ViewPlane.h"
+#include "Heatmap.h"
 #include "../Utilities/RGBColor.h"
 #include "../Tracers/Tracer.h"
 #include "../GeometricObjects/GeometricObject.h"
@@ -23,12 +25,27 @@
 #include "../Utilities/Ray.h"
 
 #include "../Cameras/Camera.h"
+#include "../Cameras/Orthographic.h"
 #include "../Lights/Light.h"
 #include "../Lights/Ambient.h"
 
 
 using namespace std;
 
+class StaticScene;
+class LightBVH;
+class BVH;
+class GBuffer;
+class TileCache;
+
+// a rectangle of pixels, in image coordinates: x across from the left, y down from the top, with the
+// maximum columns and rows left out
+
+struct PixelRegion {
+	int		x_min, y_min;
+	int		x_max, y_max;
+};
+
 class World {	
 	public:
 	
@@ -37,8 +54,23 @@ class World {
 		Tracer*						tracer_ptr;
 		Light*   					ambient_ptr;
 		Camera*						camera_ptr;
+		Orthographic				orthographic;	// what render_scene views the scene through when camera_ptr is NULL
 		vector<GeometricObject*>	objects;		
 		vector<Light*> 				lights;
+		std::string					output_file;	// where render_scene writes the image
+		Heatmap*					heatmap_ptr;	// per-pixel cost AOV, NULL unless enabled
+		int							num_threads;	// render threads, 0 for one per hardware thread
+		int							tile_size;		// width and height of a render tile in pixels
+		StaticScene*				static_scene_ptr;	// static dispatch path, NULL unless enabled
+		LightBVH*					light_bvh_ptr;		// many-light sampling, NULL unless enabled
+		BVH*						bvh_ptr;			// object hierarchy, NULL unless enabled
+		GBuffer*					gbuffer_ptr;		// cached camera ray hits for relighting, NULL unless enabled
+		TileCache*					texture_cache_ptr;	// the tiles of the image textures, NULL if there are none
+		std::string					checkpoint_file;	// where render_scene saves finished tiles, empty for none
+		double						checkpoint_interval;	// seconds between saves
+		vector<PixelRegion>			regions;			// the only pixels render_scene traces, empty for all of them
+		std::string					base_file;			// the float frame buffer the other pixels come from, empty for black
+		std::string					float_file;			// where write_image also writes the frame buffer as floats, empty for none
 
 	public:
 	
@@ -58,11 +90,80 @@ class World {
 		void
 		set_camera(Camera* c_ptr);	 
 
+		void											// see Textures/TileCache.h; the world deletes it
+		set_texture_cache(TileCache* cache_ptr);
+
+		void
+		set_output_file(const std::string& file_name);
+
+		void
+		enable_heatmap();
+
+		bool
+		enable_static_dispatch();
+
+		void
+		enable_light_bvh(const int num_samples = 1);
+
+		void											// see World/BVH.h
+		enable_bvh(const double rebuild_threshold = 1.5);
+
+		bool											// see World/GBuffer.h
+		enable_gbuffer();
+
+		void
+		set_num_threads(const int n);
+
+		void											// see World/Checkpoint.h
+		set_checkpoint(const std::string& file_name, const double interval = 60.0);
+
+		void											// traces only the regions' pixels, see render_scene
+		add_region(const int x_min, const int y_min, const int x_max, const int y_max);
+
+		void											// a region as fractions of the view plane's width and height; after it is set
+		set_crop_window(const float x_min, const float y_min, const float x_max, const float y_max);
+
+		void											// see World/FloatImage.h
+		set_base_image(const std::string& file_name);
+
+		void
+		set_float_output(const std::string& file_name);
+
 		void 					
 		build();
 
 		void 												
 		render_scene() const;
+
+		// the tiles that render_scene splits the view plane into, for renderers that schedule them
+		// themselves (World/Distributed.h); pixels is a frame buffer of hres * vres pixels, row 0 at the bottom
+
+		int
+		num_tiles(void) const;
+
+		void
+		render_tile(const int tile, Sampler& sampler, std::vector<RGBColor>& pixels) const;
+
+		void
+		get_tile(const int tile, const std::vector<RGBColor>& pixels, std::vector<RGBColor>& tile_pixels) const;
+
+		bool
+		set_tile(const int tile, const std::vector<RGBColor>& tile_pixels, std::vector<RGBColor>& pixels) const;
+
+		void											// the heatmap's costs of the tile's pixels, in get_tile order
+		get_tile_costs(const int tile, std::vector<PixelCost>& tile_costs) const;
+
+		bool											// records costs from get_tile_costs in the heatmap; false if they aren't the size of the tile
+		set_tile_costs(const int tile, const std::vector<PixelCost>& tile_costs) const;
+
+		bool											// does the tile have any pixels in a region? true for all of them without regions
+		tile_in_regions(const int tile) const;
+
+		bool											// the pixels outside the regions, from the base image, if there are regions; false if it can't be read
+		load_base_image(std::vector<RGBColor>& pixels) const;
+
+		bool
+		write_image(const std::vector<RGBColor>& pixels) const;
 						
 		RGBColor
 		max_to_one(const RGBColor& c) const;
@@ -75,9 +176,21 @@ class World {
 
 		ShadeRec
 		hit_objects(const Ray& ray);
+
+		ShadeRec										// also gives the object that was hit, NULL for none
+		hit_objects(const Ray& ray, double& tmin, const GeometricObject*& object_ptr);
+
+		bool											// is any object hit by the ray before t_max?
+		any_hit(const Ray& ray, const double t_max) const;
 		
 						
 	private:
+
+		void											// rows [r_min, r_max) and columns [c_min, c_max) of the view plane
+		tile_bounds(const int tile, int& r_min, int& r_max, int& c_min, int& c_max) const;
+
+		bool											// is the pixel in row r, from the bottom, and column c in a region?
+		in_regions(const int r, const int c) const;
 		
 		void 
 		delete_objects();
@@ -118,4 +231,53 @@ World::set_camera(Camera* c_ptr) {
 	camera_ptr = c_ptr;
 }
 
+
+// ------------------------------------------------------------------ set_num_threads
+
+inline void
+World::set_num_threads(const int n) {
+	num_threads = n;
+}
+
+
+// ------------------------------------------------------------------ set_checkpoint
+
+inline void
+World::set_checkpoint(const std::string& file_name, const double interval) {
+	checkpoint_file 	= file_name;
+	checkpoint_interval = interval;
+}
+
+
+// ------------------------------------------------------------------ add_region
+
+inline void
+World::add_region(const int x_min, const int y_min, const int x_max, const int y_max) {
+	regions.push_back(PixelRegion{x_min, y_min, x_max, y_max});
+}
+
+
+// ------------------------------------------------------------------ set_base_image
+
+inline void
+World::set_base_image(const std::string& file_name) {
+	base_file = file_name;
+}
+
+
+// ------------------------------------------------------------------ set_float_output
+
+inline void
+World::set_float_output(const std::string& file_name) {
+	float_file = file_name;
+}
+
+
+// ------------------------------------------------------------------ set_output_file
+
+inline void
+World::set_output_file(const std::string& file_name) {
+	output_file = file_name;
+}
+
 #endif
@@ -0,0 +1,60 @@
+// This file contains the definition of the microbenchmark runner
+
+#include <iomanip>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Benchmark.h"
+
+// ------------------------------------------------------------------------------ constructor
+
+BenchmarkRunner::BenchmarkRunner(const double _min_time, const int _repetitions)
+	: 	min_time(_min_time),
+		repetitions(_repetitions > 0 ? _repetitions : 1)
+{}
+
+
+// ------------------------------------------------------------------------------ write_json
+
+void
+BenchmarkRunner::write_json(std::ostream& out, const int seed, const int cpu) const {
+	out << "{\n  \"seed\": " << seed << ",\n  \"cpu\": " << cpu << ",\n  \"results\": [";
+
+	for (size_t j = 0; j < results.size(); j++)
+		out << (j ? "," : "") << "\n    { \"name\": \"" << results[j].name << "\""
+			<< ", \"ns_per_op\": " << std::fixed << std::setprecision(3) << results[j].ns_per_op
+			<< ", \"min_ns_per_op\": " << results[j].min_ns_per_op
+			<< ", \"iterations\": " << results[j].iterations << " }";
+
+	out << "\n  ]\n}\n";
+}
+
+
+// ------------------------------------------------------------------------------ write_text
+
+void
+BenchmarkRunner::write_text(std::ostream& out) const {
+	for (size_t j = 0; j < results.size(); j++)
+		out << std::left << std::setw(44) << results[j].name
+			<< std::right << std::setw(16) << std::fixed << std::setprecision(3) << results[j].ns_per_op << " ns/op"
+			<< std::setw(16) << results[j].iterations << " ops\n";
+}
+
+
+// ------------------------------------------------------------------------------ pin_thread_to_cpu
+
+bool
+pin_thread_to_cpu(const int cpu) {
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+
+	return (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0);
+#else
+	return (false);
+#endif
+}
@@ -0,0 +1,110 @@
+#ifndef __BENCHMARK__
+#define __BENCHMARK__
+
+// This file contains the declaration of a minimal microbenchmark runner
+// A benchmark body is called with an iteration count and must perform that many operations.
+// The runner doubles the count until one call takes at least min_time seconds, then times
+// a number of repetitions at that count and reports the median in nanoseconds per operation.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+	std::string	name;
+	double		ns_per_op;			// median over the repetitions
+	double		min_ns_per_op;		// fastest repetition
+	uint64_t	iterations;			// operations per repetition
+};
+
+
+class BenchmarkRunner {
+	public:
+
+		BenchmarkRunner(const double min_time, const int repetitions);
+
+		template <typename Body>
+		void
+		run(const std::string& name, Body body);
+
+		void								// one result per line, so runs can be diffed
+		write_json(std::ostream& out, const int seed, const int cpu) const;
+
+		void
+		write_text(std::ostream& out) const;
+
+	private:
+
+		double							min_time;
+		int								repetitions;
+		std::vector<BenchmarkResult>	results;
+};
+
+
+// ------------------------------------------------------------------------------ pin_thread_to_cpu
+// returns false if the platform doesn't support pinning or the cpu doesn't exist
+
+bool
+pin_thread_to_cpu(const int cpu);
+
+
+// ------------------------------------------------------------------------------ do_not_optimize
+// keeps the compiler from discarding a value that is otherwise unused
+
+template <typename T>
+inline void
+do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+
+// ------------------------------------------------------------------------------ run
+
+template <typename Body>
+void
+BenchmarkRunner::run(const std::string& name, Body body) {
+	typedef std::chrono::steady_clock clock;
+
+	uint64_t 	n = 1;
+	double		seconds;
+
+	for (;;) {
+		clock::time_point start = clock::now();
+		body(n);
+		seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+		if (seconds >= min_time || n >= (uint64_t(1) << 40))
+			break;
+
+		n *= 2;
+	}
+
+	std::vector<double> ns_per_op;
+
+	for (int j = 0; j < repetitions; j++) {
+		clock::time_point start = clock::now();
+		body(n);
+		seconds = std::chrono::duration<double>(clock::now() - start).count();
+		ns_per_op.push_back(seconds * 1.0e9 / n);
+	}
+
+	std::sort(ns_per_op.begin(), ns_per_op.end());
+
+	BenchmarkResult result;
+	result.name 			= name;
+	result.ns_per_op 		= ns_per_op[ns_per_op.size() / 2];
+	result.min_ns_per_op	= ns_per_op[0];
+	result.iterations 		= n;
+
+	results.push_back(result);
+}
+
+#endif
@@ -0,0 +1,418 @@
+// This file contains the kernel microbenchmarks: Sphere::hit, Plane::hit, World::hit_objects and its
+// static dispatch counterpart StaticScene::hit_objects, Matte::shade and its finalized counterpart
+// Matte::shade_baked, Matte::shade over grids of point lights with and without the light BVH, the
+// object BVH's traversal, build and refit, and the samplers' sample_unit_square, each reported in ns/op
+//
+// usage: Ray_Tracing_benchmarks [--seed n] [--cpu n] [--min-time seconds] [--repetitions n]
+//                               [--sizes n,n,...] [--format json|text] [--out file]
+//
+// the default sizes are 1000 and 100000 spheres; pass --sizes 1000,100000,10000000 for the 10M scene
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SceneGenerators.h"
+#include "../World/World.h"
+#include "../World/StaticScene.h"
+#include "../World/BVH.h"
+#include "../GeometricObjects/Plane.h"
+#include "../GeometricObjects/Sphere.h"
+#include "../Materials/Matte.h"
+#include "../Samplers/Jittered.h"
+#include "../Samplers/PureRandom.h"
+#include "../Samplers/Regular.h"
+#include "../Utilities/Maths.h"
+
+static const int num_rays = 1024;		// rays are precomputed and cycled through; a power of two
+
+
+// ------------------------------------------------------------------------------ parallel_rays
+// rays parallel to -z, with origins spread uniformly over a square of the given half width
+
+static std::vector<Ray>
+parallel_rays(const double half_width, const double z) {
+	std::vector<Ray> rays(num_rays);
+
+	for (Ray& ray : rays) {
+		ray.o = Point3D((2.0 * random_float() - 1.0) * half_width, (2.0 * random_float() - 1.0) * half_width, z);
+		ray.d = Vector3D(0, 0, -1);
+	}
+
+	return (rays);
+}
+
+
+// ------------------------------------------------------------------------------ bench_sphere_hit
+
+static void
+bench_sphere_hit(BenchmarkRunner& runner) {
+	World 				w;
+	Sphere				sphere(Point3D(0.0), 1.0);
+	std::vector<Ray> 	rays = parallel_rays(1.5, 10.0);		// about a third of the rays hit
+
+	runner.run("Sphere::hit", [&](uint64_t n) {
+		ShadeRec	sr(w);
+		double 		t;
+		int 		hits = 0;
+
+		for (uint64_t i = 0; i < n; i++)
+			hits += sphere.hit(rays[i & (num_rays - 1)], t, sr);
+
+		do_not_optimize(hits);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_plane_hit
+
+static void
+bench_plane_hit(BenchmarkRunner& runner) {
+	World 				w;
+	Plane				plane(Point3D(0.0), Normal(0, 0, 1));
+	std::vector<Ray> 	rays(num_rays);
+
+	for (Ray& ray : rays) {				// random directions, so half of the rays miss
+		ray.o = Point3D(0, 0, 10);
+		ray.d = Vector3D(2.0 * random_float() - 1.0, 2.0 * random_float() - 1.0, 2.0 * random_float() - 1.0);
+		ray.d.normalize();
+	}
+
+	runner.run("Plane::hit", [&](uint64_t n) {
+		ShadeRec	sr(w);
+		double 		t;
+		int 		hits = 0;
+
+		for (uint64_t i = 0; i < n; i++)
+			hits += plane.hit(rays[i & (num_rays - 1)], t, sr);
+
+		do_not_optimize(hits);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_hit_objects
+
+static void
+bench_hit_objects(BenchmarkRunner& runner, World& w, const std::string& name) {
+	double 				half_width 	= 0.5 * w.vp.hres * w.vp.s;
+	std::vector<Ray> 	rays 		= parallel_rays(half_width, 100.0);
+
+	runner.run(name, [&](uint64_t n) {
+		int hits = 0;
+
+		for (uint64_t i = 0; i < n; i++)
+			hits += w.hit_objects(rays[i & (num_rays - 1)]).hit_an_object;
+
+		do_not_optimize(hits);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_static_hit_objects
+// the same rays as bench_hit_objects, through the static dispatch path
+
+static void
+bench_static_hit_objects(BenchmarkRunner& runner, World& w, const std::string& name) {
+	double 				half_width 	= 0.5 * w.vp.hres * w.vp.s;
+	std::vector<Ray> 	rays 		= parallel_rays(half_width, 100.0);
+	StaticScene			scene;
+
+	if (!scene.compile(w))
+		return;
+
+	runner.run(name, [&](uint64_t n) {
+		int hits = 0;
+
+		for (uint64_t i = 0; i < n; i++)
+			hits += scene.hit_objects(rays[i & (num_rays - 1)]).hit_an_object;
+
+		do_not_optimize(hits);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_bvh
+// World::hit_objects through the object BVH, with the same rays as bench_hit_objects, and the BVH's
+// build and refit; the refit runs on one thread, like the rest of the benchmarks, and finds the bounds
+// unchanged, so it never rebuilds
+
+static void
+bench_bvh(BenchmarkRunner& runner, World& w, const std::string& suffix) {
+	w.enable_bvh();
+	bench_hit_objects(runner, w, "World::hit_objects/bvh/" + suffix);
+
+	runner.run("BVH::build/" + suffix, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; i++) {
+			BVH bvh(w.objects);
+			do_not_optimize(bvh.num_nodes());
+		}
+	});
+
+	runner.run("BVH::refit/" + suffix, [&](uint64_t n) {
+		int rebuilds = 0;
+
+		for (uint64_t i = 0; i < n; i++)
+			rebuilds += w.bvh_ptr->update(1);
+
+		do_not_optimize(rebuilds);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_matte_shade
+
+static void
+bench_matte_shade(BenchmarkRunner& runner) {
+	World w;
+	w.build();
+
+	Matte matte;
+	matte.set_ka(0.25);
+	matte.set_kd(0.75);
+	matte.set_cd(RGBColor(0.71, 0.40, 0.16));
+
+	ShadeRec sr(w);
+	sr.hit_an_object 	= true;
+	sr.material_ptr 	= &matte;
+	sr.ray 				= Ray(Point3D(0, 0, 100), Vector3D(0, 0, -1));
+	sr.normal 			= Normal(0.3, 0.4, 1.0);
+	sr.normal.normalize();
+
+	runner.run("Matte::shade", [&](uint64_t n) {
+		RGBColor L;
+
+		for (uint64_t i = 0; i < n; i++)
+			L += matte.shade(sr);
+
+		do_not_optimize(L);
+	});
+
+	// the same shading from the finalized record, with the lights dispatched statically
+
+	StaticScene 	scene;
+	MaterialRecord 	record;
+
+	if (!scene.compile(w) || !matte.finalize(record))
+		return;
+
+	runner.run("Matte::shade_baked", [&](uint64_t n) {
+		RGBColor L;
+
+		for (uint64_t i = 0; i < n; i++)
+			L += Matte::shade_baked(sr, record, scene);
+
+		do_not_optimize(L);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_light_bvh_shade
+// Matte::shade at a point under a grid of num_lights point lights: every light, then one light
+// picked by the light BVH
+
+static void
+bench_light_bvh_shade(BenchmarkRunner& runner, const int num_lights) {
+	World w;
+	add_point_light_grid(w, num_lights, 100.0, 50.0);
+
+	Matte matte;
+	matte.set_ka(0.25);
+	matte.set_kd(0.75);
+	matte.set_cd(RGBColor(0.71, 0.40, 0.16));
+
+	ShadeRec sr(w);
+	sr.hit_an_object 	= true;
+	sr.material_ptr 	= &matte;
+	sr.ray 				= Ray(Point3D(0, 0, 100), Vector3D(0, 0, -1));
+	sr.hit_point 		= Point3D(10, -20, 0);
+	sr.normal 			= Normal(0.3, 0.4, 1.0);
+	sr.normal.normalize();
+
+	std::string name = "Matte::shade/lights_" + std::to_string(num_lights);
+
+	runner.run(name, [&](uint64_t n) {
+		RGBColor L;
+
+		for (uint64_t i = 0; i < n; i++)
+			L += matte.shade(sr);
+
+		do_not_optimize(L);
+	});
+
+	w.enable_light_bvh();
+
+	runner.run(name + "/bvh", [&](uint64_t n) {
+		RGBColor L;
+
+		for (uint64_t i = 0; i < n; i++)
+			L += matte.shade(sr);
+
+		do_not_optimize(L);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ bench_sampler
+// the disk and hemisphere samples are mapped before the runs, as lenses and lights map them when they
+// are given the sampler
+
+static void
+bench_sampler(BenchmarkRunner& runner, Sampler& sampler, const std::string& name) {
+	runner.run(name + "::sample_unit_square", [&](uint64_t n) {
+		Point2D sum;
+
+		for (uint64_t i = 0; i < n; i++) {
+			Point2D sp = sampler.sample_unit_square();
+			sum.x += sp.x;
+			sum.y += sp.y;
+		}
+
+		do_not_optimize(sum);
+	});
+
+	sampler.map_samples_to_unit_disk();
+	runner.run(name + "::sample_unit_disk", [&](uint64_t n) {
+		Point2D sum;
+
+		for (uint64_t i = 0; i < n; i++) {
+			Point2D dp = sampler.sample_unit_disk();
+			sum.x += dp.x;
+			sum.y += dp.y;
+		}
+
+		do_not_optimize(sum);
+	});
+
+	sampler.map_samples_to_hemisphere(1);
+	runner.run(name + "::sample_hemisphere", [&](uint64_t n) {
+		Point3D sum(0.0);
+
+		for (uint64_t i = 0; i < n; i++)
+			sum = sum + Vector3D(sampler.sample_hemisphere());
+
+		do_not_optimize(sum);
+	});
+}
+
+
+// ------------------------------------------------------------------------------ parse_sizes
+
+static std::vector<int>
+parse_sizes(const std::string& list) {
+	std::vector<int> 	sizes;
+	std::stringstream 	ss(list);
+	std::string 		item;
+
+	while (std::getline(ss, item, ','))
+		if (!item.empty())
+			sizes.push_back(atoi(item.c_str()));
+
+	return (sizes);
+}
+
+
+// ------------------------------------------------------------------------------ main
+
+int
+main(int argc, char** argv) {
+	int 				seed 		= 1;
+	int 				cpu 		= 0;
+	double 				min_time 	= 0.1;
+	int 				repetitions = 5;
+	std::vector<int> 	sizes 		= {1000, 100000};
+	std::string 		format 		= "json";
+	std::string 		out_path;
+
+	for (int j = 1; j < argc; j++) {
+		bool has_value = j + 1 < argc;
+
+		if (!strcmp(argv[j], "--seed") && has_value)
+			seed = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--cpu") && has_value)
+			cpu = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--min-time") && has_value)
+			min_time = atof(argv[++j]);
+		else if (!strcmp(argv[j], "--repetitions") && has_value)
+			repetitions = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--sizes") && has_value)
+			sizes = parse_sizes(argv[++j]);
+		else if (!strcmp(argv[j], "--format") && has_value)
+			format = argv[++j];
+		else if (!strcmp(argv[j], "--out") && has_value)
+			out_path = argv[++j];
+		else {
+			std::cerr << "unknown or incomplete option " << argv[j] << "\n";
+			return (1);
+		}
+	}
+
+	if (!pin_thread_to_cpu(cpu))
+		std::cerr << "warning: could not pin the benchmark thread to cpu " << cpu << "\n";
+
+	BenchmarkRunner runner(min_time, repetitions);
+
+	set_rand_seed(seed);
+	bench_sphere_hit(runner);
+
+	set_rand_seed(seed);
+	bench_plane_hit(runner);
+
+	{
+		set_rand_seed(seed);
+		World w;
+		w.build();
+		bench_hit_objects(runner, w, "World::hit_objects/build");
+
+		set_rand_seed(seed);
+		bench_static_hit_objects(runner, w, "StaticScene::hit_objects/build");
+	}
+
+	for (int num_spheres : sizes) {
+		set_rand_seed(seed);
+		World w;
+		build_sphere_field(w, num_spheres, false);
+		bench_hit_objects(runner, w, "World::hit_objects/" + std::to_string(num_spheres));
+
+		set_rand_seed(seed);
+		bench_static_hit_objects(runner, w, "StaticScene::hit_objects/" + std::to_string(num_spheres));
+
+		set_rand_seed(seed);
+		bench_bvh(runner, w, std::to_string(num_spheres));
+	}
+
+	set_rand_seed(seed);
+	bench_matte_shade(runner);
+
+	for (int num_lights : {100, 10000}) {
+		set_rand_seed(seed);
+		bench_light_bvh_shade(runner, num_lights);
+	}
+
+	set_rand_seed(seed);
+	Regular regular;
+	bench_sampler(runner, regular, "Regular");
+
+	set_rand_seed(seed);
+	PureRandom pure_random(25);
+	bench_sampler(runner, pure_random, "PureRandom");
+
+	set_rand_seed(seed);
+	Jittered jittered(25);
+	bench_sampler(runner, jittered, "Jittered");
+
+	std::ofstream 	out_file;
+	std::ostream& 	out = out_path.empty() ? std::cout : (out_file.open(out_path), out_file);
+
+	if (format == "text")
+		runner.write_text(out);
+	else
+		runner.write_json(out, seed, cpu);
+
+	return (0);
+}
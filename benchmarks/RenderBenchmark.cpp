@@ -0,0 +1,424 @@
+// This file contains the end-to-end render benchmark
+// It renders a fixed set of canonical scenes through World::render_scene at fixed resolutions and
+// sample counts, and records the wall time, rays per second, peak RSS and a hash of the image.
+// The rays are the camera rays, hres * vres * spp, in every build, so that baselines recorded with and
+// without RT_STATS can be compared; builds with RT_STATS also report every ray traced, as traced_rays.
+// The build and render times are each the best of the runs.
+// With --baseline, any scene whose rays/s dropped by more than --threshold percent against the
+// stored baseline is flagged and the exit status is 2.
+//
+// usage: Ray_Tracing_render_benchmark [--scene name] [--runs n] [--seed n] [--threads n] [--cpu n]
+//                                     [--static] [--out file] [--baseline file] [--threshold percent]
+//
+// by default the render runs on one thread pinned to --cpu; with --threads n (0 for one per hardware
+// thread) nothing is pinned, and baselines should only be compared at the same thread count
+//
+// --static renders through the static dispatch path (World/StaticScene.h) instead of virtual calls;
+// the dispatch is recorded in the output, and only baselines with the same dispatch should be compared
+//
+// the output of one run is a valid baseline for the next: --out baseline.json, then --baseline baseline.json
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+#include "Benchmark.h"
+#include "SceneGenerators.h"
+#include "../World/World.h"
+#include "../GeometricObjects/MovingInstance.h"
+#include "../Lights/AmbientOccluder.h"
+#include "../Samplers/Jittered.h"
+#include "../Utilities/Maths.h"
+#include "../Utilities/Stats.h"
+
+// ------------------------------------------------------------------------------ canonical scenes
+
+struct SceneSpec {
+	const char*		name;
+	int				hres;
+	int				vres;
+	int				spp;					// samples per pixel, jittered
+	void			(*build)(World& w);
+};
+
+static void
+build_default(World& w) {
+	w.build();
+}
+
+static void
+build_spheres_1k(World& w) {
+	build_sphere_field(w, 1000);
+}
+
+static void
+build_spheres_1k_bvh(World& w) {
+	build_sphere_field(w, 1000);
+	w.enable_bvh();
+}
+
+// every fourth sphere moves up by about its radius while the shutter is open
+
+static void
+build_spheres_1k_blur(World& w) {
+	build_sphere_field(w, 1000);
+
+	for (int j = 0; j < (int)w.objects.size() - 1; j += 4) {		// the backdrop plane is last
+		MovingInstance* instance_ptr = new MovingInstance(w.objects[j]);
+		instance_ptr->set_shadows(w.objects[j]->casts_shadows());
+		instance_ptr->set_linear_motion(Vector3D(0.0), Vector3D(0.0, 20.0, 0.0));
+		w.objects[j] = instance_ptr;
+	}
+
+	w.vp.set_motion_blur(true);
+	w.enable_bvh();
+}
+
+static void
+build_ambient_occlusion(World& w) {
+	w.build();
+
+	AmbientOccluder* occluder_ptr = new AmbientOccluder;
+	occluder_ptr->set_num_samples(16);
+	delete w.ambient_ptr;
+	w.set_ambient_light(occluder_ptr);
+}
+
+static void
+build_whitted(World& w) {
+	build_whitted_scene(w, 5);
+}
+
+static void
+build_path_trace(World& w) {
+	build_path_trace_scene(w);
+}
+
+static void
+build_area_lights(World& w) {
+	build_area_light_scene(w, 16);
+}
+
+static const SceneSpec scenes[] = {
+	{"build", 		400, 400, 16, build_default},
+	{"spheres_1k", 	200, 200, 4, build_spheres_1k},
+	{"spheres_1k_bvh", 200, 200, 4, build_spheres_1k_bvh},
+	{"spheres_1k_blur", 200, 200, 4, build_spheres_1k_blur},
+	{"build_ao",	200, 200, 4, build_ambient_occlusion},
+	{"area_lights",	200, 200, 4, build_area_lights},
+	{"whitted",		200, 200, 4, build_whitted},
+	{"path_trace",	200, 200, 8, build_path_trace}
+};
+
+static const int num_scenes = sizeof(scenes) / sizeof(scenes[0]);
+
+
+struct RenderResult {
+	std::string		scene;
+	int				hres, vres, spp;
+	double			build_seconds;			// best of the runs
+	double			render_seconds;			// best of the runs
+	uint64_t		rays;					// camera rays
+	uint64_t		traced_rays;			// all the rays traced, counted with RT_STATS
+	double			rays_per_second;
+	long			peak_rss_kb;			// of the whole process so far
+	uint64_t		image_hash;
+};
+
+
+// ------------------------------------------------------------------------------ seconds_since
+
+static double
+seconds_since(const std::chrono::steady_clock::time_point start) {
+	return (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+
+// ------------------------------------------------------------------------------ hash_file
+// 64-bit FNV-1a of the file's bytes
+
+static uint64_t
+hash_file(const std::string& file_name) {
+	std::ifstream 	in(file_name, std::ios::binary);
+	uint64_t 		hash = 14695981039346656037ULL;
+	char 			c;
+
+	while (in.get(c)) {
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ULL;
+	}
+
+	return (hash);
+}
+
+
+// ------------------------------------------------------------------------------ peak_rss_kb
+
+static long
+peak_rss_kb(void) {
+#ifdef __unix__
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_maxrss);
+#else
+	return (0);
+#endif
+}
+
+
+// ------------------------------------------------------------------------------ render_scene
+// builds the scene afresh for every run so that each run starts from the same sampler state
+
+static RenderResult
+render_scene(const SceneSpec& spec, const int runs, const int seed, const int threads, const bool static_dispatch) {
+	RenderResult result;
+	result.scene 			= spec.name;
+	result.hres 			= spec.hres;
+	result.vres 			= spec.vres;
+	result.spp 				= spec.spp;
+	result.build_seconds 	= 0.0;
+	result.render_seconds 	= 0.0;
+	result.rays 			= (uint64_t)spec.hres * spec.vres * spec.spp;
+	result.traced_rays 		= 0;
+
+	std::string image_file = std::string("render_benchmark_") + spec.name + ".ppm";
+
+	for (int run = 0; run < runs; run++) {
+		set_rand_seed(seed);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		World w;
+		spec.build(w);
+
+		// keep the scene's field of view at the benchmark resolution
+
+		w.vp.set_pixel_size(w.vp.s * w.vp.hres / spec.hres);
+		w.vp.set_hres(spec.hres);
+		w.vp.set_vres(spec.vres);
+		w.vp.set_sampler(new Jittered(spec.spp));
+		w.set_output_file(image_file);
+		w.set_num_threads(threads);
+
+		if (static_dispatch && !w.enable_static_dispatch())
+			std::cerr << "warning: " << spec.name << " can't use static dispatch\n";
+
+		double build_seconds = seconds_since(start);
+
+		Stats::begin_frame();
+		start = std::chrono::steady_clock::now();
+		w.render_scene();
+		double seconds = seconds_since(start);
+
+#ifdef RT_STATS
+		result.traced_rays = Stats::end_frame().counters[STAT_RAYS];
+#endif
+
+		if (run == 0 || build_seconds < result.build_seconds)
+			result.build_seconds = build_seconds;
+
+		if (run == 0 || seconds < result.render_seconds)
+			result.render_seconds = seconds;
+	}
+
+	result.rays_per_second 	= result.rays / result.render_seconds;
+	result.peak_rss_kb 		= peak_rss_kb();
+	result.image_hash 		= hash_file(image_file);
+
+	return (result);
+}
+
+
+// ------------------------------------------------------------------------------ write_json
+// one scene per line, which is also what read_baseline expects
+
+static void
+write_json(std::ostream& out, const std::vector<RenderResult>& results, const int seed, const bool static_dispatch) {
+	out << "{\n  \"seed\": " << seed << ",\n  \"dispatch\": \"" << (static_dispatch ? "static" : "virtual")
+		<< "\",\n  \"scenes\": [";
+
+	for (size_t j = 0; j < results.size(); j++) {
+		const RenderResult& r = results[j];
+
+		out << (j ? "," : "") << "\n    { \"scene\": \"" << r.scene << "\""
+			<< ", \"hres\": " << r.hres << ", \"vres\": " << r.vres << ", \"spp\": " << r.spp
+			<< std::fixed << std::setprecision(4)
+			<< ", \"build_seconds\": " << r.build_seconds
+			<< ", \"render_seconds\": " << r.render_seconds
+			<< ", \"rays\": " << r.rays;
+
+#ifdef RT_STATS
+		out << ", \"traced_rays\": " << r.traced_rays;
+#endif
+
+		out << std::setprecision(0)
+			<< ", \"rays_per_second\": " << r.rays_per_second
+			<< ", \"peak_rss_kb\": " << r.peak_rss_kb
+			<< ", \"image_hash\": \"" << std::hex << std::setw(16) << std::setfill('0') << r.image_hash
+			<< std::dec << std::setfill(' ') << "\" }";
+	}
+
+	out << "\n  ]\n}\n";
+}
+
+
+// ------------------------------------------------------------------------------ json_field
+// the text following "key": on the line, up to the next comma or brace
+
+static std::string
+json_field(const std::string& line, const std::string& key) {
+	size_t pos = line.find("\"" + key + "\":");
+
+	if (pos == std::string::npos)
+		return ("");
+
+	pos += key.size() + 3;
+	size_t end = line.find_first_of(",}", pos);
+	std::string value = line.substr(pos, end - pos);
+
+	value.erase(0, value.find_first_not_of(" \""));
+	value.erase(value.find_last_not_of(" \"") + 1);
+
+	return (value);
+}
+
+
+// ------------------------------------------------------------------------------ read_baseline
+// scene name -> the baseline rays per second and image hash
+
+static bool
+read_baseline(const std::string& file_name, std::map<std::string, RenderResult>& baseline) {
+	std::ifstream in(file_name);
+
+	if (!in)
+		return (false);
+
+	std::string line;
+
+	while (std::getline(in, line)) {
+		std::string scene = json_field(line, "scene");
+
+		if (scene.empty())
+			continue;
+
+		RenderResult r;
+		r.scene 			= scene;
+		r.rays_per_second 	= atof(json_field(line, "rays_per_second").c_str());
+		r.image_hash 		= strtoull(json_field(line, "image_hash").c_str(), NULL, 16);
+		baseline[scene] 	= r;
+	}
+
+	return (true);
+}
+
+
+// ------------------------------------------------------------------------------ main
+
+int
+main(int argc, char** argv) {
+	int 			runs 		= 3;
+	int 			seed 		= 1;
+	int 			cpu 		= 0;
+	int 			threads 	= 1;
+	bool 			static_dispatch = false;
+	double 			threshold 	= 5.0;		// percent
+	std::string 	only_scene;
+	std::string 	out_path;
+	std::string 	baseline_path;
+
+	for (int j = 1; j < argc; j++) {
+		bool has_value = j + 1 < argc;
+
+		if (!strcmp(argv[j], "--scene") && has_value)
+			only_scene = argv[++j];
+		else if (!strcmp(argv[j], "--runs") && has_value)
+			runs = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--seed") && has_value)
+			seed = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--threads") && has_value)
+			threads = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--cpu") && has_value)
+			cpu = atoi(argv[++j]);
+		else if (!strcmp(argv[j], "--static"))
+			static_dispatch = true;
+		else if (!strcmp(argv[j], "--out") && has_value)
+			out_path = argv[++j];
+		else if (!strcmp(argv[j], "--baseline") && has_value)
+			baseline_path = argv[++j];
+		else if (!strcmp(argv[j], "--threshold") && has_value)
+			threshold = atof(argv[++j]);
+		else {
+			std::cerr << "unknown or incomplete option " << argv[j] << "\n";
+			return (1);
+		}
+	}
+
+	if (runs < 1)
+		runs = 1;
+
+	if (threads == 1 && !pin_thread_to_cpu(cpu))
+		std::cerr << "warning: could not pin the render thread to cpu " << cpu << "\n";
+
+	std::map<std::string, RenderResult> baseline;
+
+	if (!baseline_path.empty() && !read_baseline(baseline_path, baseline)) {
+		std::cerr << "cannot read baseline " << baseline_path << "\n";
+		return (1);
+	}
+
+	std::vector<RenderResult> results;
+
+	for (int j = 0; j < num_scenes; j++)
+		if (only_scene.empty() || only_scene == scenes[j].name)
+			results.push_back(render_scene(scenes[j], runs, seed, threads, static_dispatch));
+
+	if (results.empty()) {
+		std::cerr << "no scene named " << only_scene << "\n";
+		return (1);
+	}
+
+	if (out_path.empty())
+		write_json(std::cout, results, seed, static_dispatch);
+	else {
+		std::ofstream out(out_path);
+		write_json(out, results, seed, static_dispatch);
+	}
+
+	// compare against the baseline
+
+	bool regressed = false;
+
+	for (const RenderResult& r : results) {
+		std::map<std::string, RenderResult>::const_iterator it = baseline.find(r.scene);
+
+		if (it == baseline.end())
+			continue;
+
+		double change = 100.0 * (r.rays_per_second / it->second.rays_per_second - 1.0);
+
+		std::cerr << std::fixed << std::setprecision(1);
+
+		if (change < -threshold) {
+			std::cerr << "REGRESSION " << r.scene << ": " << change << "% rays/s against the baseline\n";
+			regressed = true;
+		}
+		else
+			std::cerr << "ok " << r.scene << ": " << change << "% rays/s against the baseline\n";
+
+		if (r.image_hash != it->second.image_hash)
+			std::cerr << "note " << r.scene << ": the image differs from the baseline image\n";
+	}
+
+	return (regressed ? 2 : 0);
+}
@@ -0,0 +1,286 @@
+// This file contains the definitions of the synthetic scene generators used by the benchmarks
+
+#include <cmath>
+
+#include "SceneGenerators.h"
+#include "../World/World.h"
+#include "../GeometricObjects/Plane.h"
+#include "../GeometricObjects/Rectangle.h"
+#include "../GeometricObjects/Sphere.h"
+#include "../GeometricObjects/TriangleMesh.h"
+#include "../Lights/AreaLight.h"
+#include "../Lights/Directional.h"
+#include "../Lights/PointLight.h"
+#include "../Lights/SpotLight.h"
+#include "../Materials/Emissive.h"
+#include "../Materials/Matte.h"
+#include "../Materials/Reflective.h"
+#include "../Materials/Transparent.h"
+#include "../Samplers/Regular.h"
+#include "../Tracers/PathTrace.h"
+#include "../Tracers/RayCast.h"
+#include "../Tracers/Whitted.h"
+
+// the spheres of World::build
+
+struct SphereSpec {
+	double		x, y, z;
+	double		radius;
+	RGBColor	color;
+};
+
+static const RGBColor yellow(1, 1, 0);
+static const RGBColor brown(0.71, 0.40, 0.16);
+static const RGBColor darkGreen(0.0, 0.41, 0.41);
+static const RGBColor orange(1, 0.75, 0);
+static const RGBColor green(0, 0.6, 0.3);
+static const RGBColor lightGreen(0.65, 1, 0.30);
+static const RGBColor darkYellow(0.61, 0.61, 0);
+static const RGBColor lightPurple(0.65, 0.3, 1);
+static const RGBColor darkPurple(0.5, 0, 1);
+static const RGBColor grey(0.25);
+
+static const SphereSpec build_spheres[] = {
+	{5, 3, 0, 30, yellow},
+	{45, -7, -60, 20, brown},
+	{40, 43, -100, 17, darkGreen},
+	{-20, 28, -15, 20, orange},
+	{-25, -7, -35, 27, green},
+	{20, -27, -35, 25, lightGreen},
+	{35, 18, -35, 22, green},
+	{-57, -17, -50, 15, brown},
+	{-47, 16, -80, 23, lightGreen},
+	{-15, -32, -60, 22, darkGreen},
+	{-35, -37, -80, 22, darkYellow},
+	{10, 43, -80, 22, darkYellow},
+	{30, -7, -80, 10, darkYellow},
+	{-40, 48, -110, 18, darkGreen},
+	{-10, 53, -120, 18, brown},
+	{-55, -52, -100, 10, lightPurple},
+	{5, -52, -100, 15, brown},
+	{-20, -57, -120, 15, darkPurple},
+	{55, -27, -100, 17, darkGreen},
+	{50, -47, -120, 15, brown},
+	{70, -42, -150, 10, lightPurple},
+	{5, 73, -130, 12, lightPurple},
+	{66, 21, -130, 13, darkPurple},
+	{72, -12, -140, 12, lightPurple},
+	{64, 5, -160, 11, green},
+	{55, 38, -160, 12, lightPurple},
+	{-73, -2, -160, 12, lightPurple},
+	{30, -62, -140, 15, darkPurple},
+	{25, 63, -140, 15, darkPurple},
+	{-60, 46, -140, 15, darkPurple},
+	{-30, 68, -130, 12, lightPurple},
+	{58, 56, -180, 11, green},
+	{-63, -39, -180, 11, green},
+	{46, 68, -200, 10, lightPurple},
+	{-3, -72, -130, 12, lightPurple}
+};
+
+static const int	num_build_spheres 	= sizeof(build_spheres) / sizeof(build_spheres[0]);
+
+// the cluster of build spheres fits in a 170 x 170 x 250 box, which is the lattice spacing
+
+static const double	cluster_width		= 170.0;
+static const double	cluster_depth		= 250.0;
+
+
+// ------------------------------------------------------------------------------ make_matte
+
+static Matte*
+make_matte(const RGBColor& c) {
+	Matte* matte_ptr = new Matte;
+	matte_ptr->set_ka(0.25);
+	matte_ptr->set_kd(0.75);
+	matte_ptr->set_cd(c);
+
+	return (matte_ptr);
+}
+
+
+// ------------------------------------------------------------------------------ build_sphere_field
+
+void
+build_sphere_field(World& w, const int num_spheres, const bool with_materials) {
+	int num_clusters 	= (num_spheres + num_build_spheres - 1) / num_build_spheres;
+	int k 				= (int)ceil(cbrt((double)num_clusters));		// clusters per lattice side
+
+	while (k * k * k < num_clusters)		// guards against cbrt rounding down
+		k++;
+
+	// view plane, tracer and light as in World::build
+
+	w.vp.set_hres(400);
+	w.vp.set_vres(400);
+	w.vp.set_pixel_size(0.5 * k);
+	w.vp.set_sampler(new Regular);
+
+	w.tracer_ptr = new RayCast(&w);
+
+	Directional* light_ptr = new Directional;
+	light_ptr->set_direction(100, 100, 200);
+	light_ptr->scale_radiance(3.0);
+	w.add_light(light_ptr);
+
+	w.objects.reserve(num_spheres + 1);
+
+	int count = 0;
+
+	for (int l = 0; l < k && count < num_spheres; l++)					// back into the scene
+		for (int j = 0; j < k && count < num_spheres; j++)				// up
+			for (int i = 0; i < k && count < num_spheres; i++) {		// across
+				double dx = (i - 0.5 * (k - 1)) * cluster_width;
+				double dy = (j - 0.5 * (k - 1)) * cluster_width;
+				double dz = -l * cluster_depth;
+
+				for (int s = 0; s < num_build_spheres && count < num_spheres; s++, count++) {
+					const SphereSpec& spec = build_spheres[s];
+					Sphere* sphere_ptr = new Sphere(Point3D(spec.x + dx, spec.y + dy, spec.z + dz), spec.radius);
+
+					if (with_materials)
+						sphere_ptr->set_material(make_matte(spec.color));
+
+					w.add_object(sphere_ptr);
+				}
+			}
+
+	// backdrop plane, behind the last layer of clusters
+
+	Plane* plane_ptr = new Plane(Point3D(0, 0, -k * cluster_depth), Normal(0, 0, 1));
+
+	if (with_materials)
+		plane_ptr->set_material(make_matte(grey));
+
+	w.add_object(plane_ptr);
+}
+
+
+// ------------------------------------------------------------------------------ add_area_light
+
+static void
+add_area_light(World& w, GeometricObject* object_ptr, const RGBColor& ce, const float ls, const int num_samples) {
+	Emissive* emissive_ptr = new Emissive;
+	emissive_ptr->set_ce(ce);
+	emissive_ptr->scale_radiance(ls);
+	object_ptr->set_material(emissive_ptr);
+	w.add_object(object_ptr);
+
+	AreaLight* light_ptr = new AreaLight;
+	light_ptr->set_object(object_ptr);
+	light_ptr->set_num_samples(num_samples);
+	light_ptr->set_shadows(true);
+	w.add_light(light_ptr);
+}
+
+
+// ------------------------------------------------------------------------------ build_area_light_scene
+
+void
+build_area_light_scene(World& w, const int num_shadow_samples) {
+	build_sphere_field(w, num_build_spheres);
+
+	w.lights[0]->set_shadows(true);
+
+	SpotLight* spot_ptr = new SpotLight;
+	spot_ptr->set_location(0, 0, 150);
+	spot_ptr->set_direction(0, 0, -1);
+	spot_ptr->set_cone(25, 15);
+	spot_ptr->scale_radiance(3.0e4);
+	spot_ptr->set_shadows(true);
+	w.add_light(spot_ptr);
+
+	// a panel above the view, facing down
+
+	add_area_light(w, new Rectangle(Point3D(-50, 110, 40), Vector3D(0, 0, -100), Vector3D(100, 0, 0)),
+				   RGBColor(1.0, 0.95, 0.85), 6.0, num_shadow_samples);
+
+	// a ball to the left
+
+	add_area_light(w, new Sphere(Point3D(-130, -40, -40), 15), RGBColor(0.6, 0.7, 1.0), 12.0, num_shadow_samples);
+
+	// a square of two triangles to the right, facing left
+
+	TriangleMesh* mesh_ptr = new TriangleMesh;
+	int v0 = mesh_ptr->add_vertex(Point3D(115, -60, 20));
+	int v1 = mesh_ptr->add_vertex(Point3D(115, -60, -80));
+	int v2 = mesh_ptr->add_vertex(Point3D(115, 40, -80));
+	int v3 = mesh_ptr->add_vertex(Point3D(115, 40, 20));
+	mesh_ptr->add_triangle(v0, v2, v1);
+	mesh_ptr->add_triangle(v0, v3, v2);
+
+	add_area_light(w, mesh_ptr, RGBColor(1.0, 0.6, 0.4), 6.0, num_shadow_samples);
+}
+
+
+// ------------------------------------------------------------------------------ build_whitted_scene
+
+void
+build_whitted_scene(World& w, const int max_depth) {
+	build_sphere_field(w, num_build_spheres);
+
+	Whitted* whitted_ptr = new Whitted(&w);
+	whitted_ptr->set_max_depth(max_depth);
+	delete w.tracer_ptr;
+	w.tracer_ptr = whitted_ptr;
+
+	// the front sphere is glass
+
+	Transparent* glass_ptr = new Transparent;
+	glass_ptr->set_ka(0.0);
+	glass_ptr->set_kd(0.05);
+	glass_ptr->set_cd(white);
+	glass_ptr->set_kr(0.1);
+	glass_ptr->set_kt(0.9);
+	glass_ptr->set_ior(1.5);
+	delete w.objects[0]->get_material();
+	w.objects[0]->set_material(glass_ptr);
+
+	// and three of the spheres around it are mirrors, tinted with their colors
+
+	for (int s : {3, 5, 6}) {
+		Reflective* mirror_ptr = new Reflective;
+		mirror_ptr->set_ka(0.1);
+		mirror_ptr->set_kd(0.25);
+		mirror_ptr->set_cd(build_spheres[s].color);
+		mirror_ptr->set_kr(0.75);
+		mirror_ptr->set_cr(build_spheres[s].color);
+		delete w.objects[s]->get_material();
+		w.objects[s]->set_material(mirror_ptr);
+	}
+}
+
+
+// ------------------------------------------------------------------------------ build_path_trace_scene
+// the paths sample the area lights once per hit, so more samples per pixel, rather than per light,
+// reduce the noise in both the direct and the indirect light
+
+void
+build_path_trace_scene(World& w) {
+	build_area_light_scene(w, 1);
+
+	delete w.tracer_ptr;
+	w.tracer_ptr = new PathTrace(&w);
+}
+
+
+// ------------------------------------------------------------------------------ add_point_light_grid
+
+void
+add_point_light_grid(World& w, const int num_lights, const double half_width, const double height) {
+	int k = (int)ceil(sqrt((double)num_lights));		// lights per grid side
+
+	w.lights.reserve(w.lights.size() + num_lights);
+
+	for (int count = 0; count < num_lights; count++) {
+		int 	i 	= count % k;
+		int 	j 	= count / k;
+		double 	x 	= k > 1 ? (2.0 * i / (k - 1) - 1.0) * half_width : 0.0;
+		double 	y 	= k > 1 ? (2.0 * j / (k - 1) - 1.0) * half_width : 0.0;
+
+		PointLight* light_ptr = new PointLight;
+		light_ptr->set_location(x, y, height);
+		light_ptr->scale_radiance(3.0e4 / num_lights);
+		w.add_light(light_ptr);
+	}
+}
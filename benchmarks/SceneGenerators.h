@@ -0,0 +1,50 @@
+#ifndef __SCENE_GENERATORS__
+#define __SCENE_GENERATORS__
+
+// This file contains the declarations of the synthetic scene generators used by the benchmarks
+// They scale the 35-sphere scene of World::build up to arbitrary sphere counts
+
+class World;
+
+// ------------------------------------------------------------------------------ build_sphere_field
+// Fills the world with num_spheres spheres plus a backdrop plane, and sets up the view plane,
+// tracer and light the way World::build does.
+// The spheres are copies of the 35 spheres of World::build, laid out in a cubic lattice of
+// translated clusters, so the sphere density and size distribution stay those of the original scene.
+// The view plane's pixel size is scaled so that the whole lattice stays in view.
+// Without materials the world can be intersected but not shaded, which keeps the
+// 10M-sphere scene small enough for a workstation.
+
+void
+build_sphere_field(World& w, const int num_spheres, const bool with_materials = true);
+
+// ------------------------------------------------------------------------------ build_area_light_scene
+// The 35 spheres and backdrop of build_sphere_field, lit with shadows by the directional light, a
+// spot light and three area lights - a rectangle, a sphere and a triangle mesh - just outside the
+// view, each taking num_shadow_samples samples per hit.
+
+void
+build_area_light_scene(World& w, const int num_shadow_samples);
+
+// ------------------------------------------------------------------------------ build_whitted_scene
+// The 35 spheres and backdrop of build_sphere_field, traced by a Whitted tracer with the given
+// maximum depth, with the front sphere made of glass and three of its neighbours reflective.
+
+void
+build_whitted_scene(World& w, const int max_depth);
+
+// ------------------------------------------------------------------------------ build_path_trace_scene
+// The scene of build_area_light_scene, with one shadow sample per area light, traced by a path tracer
+
+void
+build_path_trace_scene(World& w);
+
+// ------------------------------------------------------------------------------ add_point_light_grid
+// Adds num_lights point lights on a square grid in the plane z = height, spread over
+// [-half_width, half_width] in x and y, with their radiance scaled so that the total power
+// doesn't depend on num_lights.
+
+void
+add_point_light_grid(World& w, const int num_lights, const double half_width, const double height);
+
+#endif
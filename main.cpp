@@ -1,11 +1,383 @@
 #include <iostream>
+#include <chrono>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
 #include "World/World.h"
+#include "World/Animation.h"
+#include "World/Distributed.h"
+#include "World/GBuffer.h"
+#include "Cameras/FishEye.h"
+#include "Cameras/Pinhole.h"
+#include "Cameras/Spherical.h"
+#include "Cameras/ThinLens.h"
+#include "GeometricObjects/MovingInstance.h"
+#include "Mappings/SphericalMap.h"
+#include "Lights/AmbientOccluder.h"
+#include "Lights/Directional.h"
+#include "Materials/Matte.h"
+#include "Textures/ImageTexture.h"
+#include "Textures/TileCache.h"
+#include "Utilities/Stats.h"
+#include "Utilities/Timeline.h"
+
+// usage: Ray_Tracing_from_the_Ground_Up [--ao n] [--bvh] [--camera name] [--checkpoint file [--checkpoint-interval s]]
+//                                       [--frames n] [--heatmap] [--motion-blur] [--static] [--threads n] [--trace file]
+//                                       [--region x0 y0 x1 y1]... [--crop x0 y0 x1 y1] [--base file] [--float file]
+//                                       [--relight file] [--texture file [--texture-cache mb]]
+//                                       [--coordinator address [--workers n] | --worker address]
+// --ao replaces the ambient light with ambient occlusion, casting n rays per hit
+// --bvh traverses a BVH over the objects (World/BVH.h) instead of testing all of them for every ray
+// --camera views the scene through a pinhole, thinlens, fisheye or spherical camera, as set up by view_scene
+// --checkpoint saves the finished tiles to file every s seconds (60 by default), and resumes the render
+//   from the tiles in file if it was stopped; the file is removed once the image has been written
+// --frames renders n frames of the scene animated by animate_scene, as image_0000.ppm and on (World/Animation.h)
+// --heatmap also writes per-pixel cost images next to image.ppm
+// --motion-blur moves two spheres of the scene while the shutter is open, as set up by blur_scene
+// --static renders through the static dispatch path (World/StaticScene.h) if the scene allows it
+// --threads sets the number of render threads, 0 (the default) for one per hardware thread
+// --trace writes the render timeline as a Chrome trace that chrome://tracing or Perfetto can load
+// --region traces only the pixels from column x0 and row y0, counted from the top left, up to but not including
+//   x1 and y1, and can be given more than once; --crop gives a region as fractions of the image's width and height
+// --base takes the other pixels from file, a float image of the same size; otherwise they are black
+// --float also writes the image as floats to file (World/FloatImage.h), which can be the --base file, so that
+//   regions are merged into the full frame
+// --relight keeps the camera rays' hits in a G-buffer (World/GBuffer.h) while the image is rendered, then
+//   makes the edits of relight_scene and renders them to file from the cached hits, reporting both times
+// --texture wraps the yellow sphere in the image of file, a PPM image or a tiled texture file, read through a
+//   cache of mb megabytes (16 by default) as set up by texture_scene, and reports how well the cache did
+// --coordinator renders by handing tiles to worker processes that connect to address (World/Distributed.h),
+//   and --workers starts n of them on this machine; --worker renders tiles for the coordinator at address
+
+// the camera orbits from the left of the scene to its right, through a pinhole that frames about what the
+// default orthographic view does, while the yellow sphere rises and then stays put
+
+static void
+animate_scene(World& w, Animation& animation) {
+    auto* pinhole_ptr = new Pinhole;
+    pinhole_ptr->set_view_distance(500.0);
+    w.set_camera(pinhole_ptr);
+
+    animation.add_camera_key(0.0, Point3D(-250, 50, 433), Point3D(0, 0, -50));
+    animation.add_camera_key(0.5, Point3D(0, 100, 500), Point3D(0, 0, -50));
+    animation.add_camera_key(1.0, Point3D(250, 50, 433), Point3D(0, 0, -50));
+
+    int sphere = animation.add_object(w, 0);
+    animation.add_object_key(sphere, 0.0, Vector3D(1), Vector3D(0), Vector3D(0));
+    animation.add_object_key(sphere, 0.5, Vector3D(1), Vector3D(0), Vector3D(0, 60, 0));
+}
+
+// while the shutter is open, the yellow sphere rises, and the sphere to its right is stretched into an
+// ellipsoid that turns over and moves right; the first moves linearly, the second by keys, about its centre
+
+static void
+blur_scene(World& w) {
+    auto* rising_ptr = new MovingInstance(w.objects[0]);
+    rising_ptr->set_shadows(w.objects[0]->casts_shadows());
+    rising_ptr->set_linear_motion(Vector3D(0), Vector3D(0, 30, 0));
+    w.objects[0] = rising_ptr;
+
+    BBox bounds;
+    w.objects[1]->get_bounds(bounds);
+    Point3D centre = bounds.centroid();
+
+    auto* turning_ptr = new MovingInstance(w.objects[1]);
+    turning_ptr->set_shadows(w.objects[1]->casts_shadows());
+    turning_ptr->translate(-centre.x, -centre.y, -centre.z);
+    turning_ptr->add_key(0.0, Vector3D(1), Vector3D(0), Vector3D(centre.x, centre.y, centre.z));
+    turning_ptr->add_key(1.0, Vector3D(1.2, 0.8, 1), Vector3D(0, 0, 90), Vector3D(centre.x + 20, centre.y, centre.z));
+    w.objects[1] = turning_ptr;
+
+    w.vp.set_motion_blur(true);
+}
+
+// the cameras look at the scene from in front of it and a little above; the thin lens camera is focused
+// on the yellow sphere, and the fisheye and spherical ones are close enough to see all around it
+
+static bool
+view_scene(World& w, const char* name) {
+    Camera* camera_ptr;
+
+    if (!strcmp(name, "pinhole")) {
+        auto* pinhole_ptr = new Pinhole;
+        pinhole_ptr->set_view_distance(500.0);
+        camera_ptr = pinhole_ptr;
+    }
+    else if (!strcmp(name, "thinlens")) {
+        BBox bounds;
+        w.objects[0]->get_bounds(bounds);
+        Point3D centre = bounds.centroid();
+
+        auto* thin_lens_ptr = new ThinLens;
+        thin_lens_ptr->set_view_distance(500.0);
+        thin_lens_ptr->set_focal_distance((Point3D(0, 100, 500) - centre).length());
+        thin_lens_ptr->set_lens_radius(10.0);
+        thin_lens_ptr->set_num_samples(w.vp.num_samples);
+        camera_ptr = thin_lens_ptr;
+    }
+    else if (!strcmp(name, "fisheye")) {
+        auto* fisheye_ptr = new FishEye;
+        fisheye_ptr->set_fov(180.0);
+        camera_ptr = fisheye_ptr;
+    }
+    else if (!strcmp(name, "spherical")) {
+        auto* spherical_ptr = new Spherical;
+        spherical_ptr->set_fov(360.0, 180.0);
+        camera_ptr = spherical_ptr;
+    }
+    else
+        return (false);
+
+    camera_ptr->set_eye(0, 100, 500);
+    camera_ptr->set_lookat(0, 0, -50);
+    camera_ptr->compute_uvw();
+    delete w.camera_ptr;
+    w.set_camera(camera_ptr);
+
+    return (true);
+}
+
+// the image is converted to a tiled texture file next to it, file.tiled, unless it already is one; it is
+// mapped onto the yellow sphere about the centre of the sphere in its own space, whether or not it has
+// been wrapped in an instance, and the camera rays carry differentials to choose the MIP levels
+
+static bool
+texture_scene(World& w, const std::string& file, const double cache_mb) {
+    auto* cache_ptr = new TileCache((std::size_t)(cache_mb * 1024 * 1024));
+    int texture_id = cache_ptr->open(file);
+
+    if (texture_id < 0 && TextureFile::convert(file, file + ".tiled"))
+        texture_id = cache_ptr->open(file + ".tiled");
+
+    auto* matte_ptr = dynamic_cast<Matte*>(w.objects[0]->get_material());
+
+    if (texture_id < 0 || !matte_ptr) {
+        delete cache_ptr;
+        return (false);
+    }
+
+    w.set_texture_cache(cache_ptr);
+
+    const GeometricObject* object_ptr = w.objects[0];
+
+    while (auto* instance_ptr = dynamic_cast<const Instance*>(object_ptr))
+        object_ptr = instance_ptr->get_object();
+
+    BBox bounds;
+    object_ptr->get_bounds(bounds);
+
+    auto* map_ptr = new SphericalMap;
+    map_ptr->set_center(bounds.centroid());
+
+    auto* texture_ptr = new ImageTexture(cache_ptr, texture_id);
+    texture_ptr->set_mapping(map_ptr);
+    matte_ptr->set_cd(texture_ptr);
+
+    w.vp.set_ray_differentials(true);
+
+    return (true);
+}
+
+// the light is dimmed to half, and the yellow sphere is turned blue and made less diffuse; only materials
+// and lights change, so the G-buffer still holds
+
+static void
+relight_scene(World& w) {
+    if (auto* light_ptr = dynamic_cast<Directional*>(w.lights[0]))
+        light_ptr->scale_radiance(1.5f);
+
+    if (auto* matte_ptr = dynamic_cast<Matte*>(w.objects[0]->get_material())) {
+        matte_ptr->set_cd(0.2f, 0.4f, 1.0f);
+        matte_ptr->set_kd(0.5f);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* trace_file = nullptr;
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--trace") && j + 1 < argc)
+            trace_file = argv[++j];
+
+    if (trace_file)
+        Timeline::enable();
+
+    Stats::begin_frame();
 
-int main() {
     World w;
     w.build();
     assert(w.tracer_ptr != nullptr);
-    w.render_scene();
+
+    Animation animation;
+    int num_frames = 0;
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--frames") && j + 1 < argc)
+            num_frames = atoi(argv[++j]);
+
+    if (num_frames > 0)
+        animate_scene(w, animation);
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--camera") && j + 1 < argc && !view_scene(w, argv[++j]))
+            std::cerr << "unknown camera " << argv[j] << "; the cameras are pinhole, thinlens, fisheye and spherical\n";
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--motion-blur"))
+            blur_scene(w);
+
+    double texture_cache_mb = 16.0;
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--texture-cache") && j + 1 < argc)
+            texture_cache_mb = atof(argv[++j]);
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--texture") && j + 1 < argc && !texture_scene(w, argv[++j], texture_cache_mb))
+            std::cerr << "can't read " << argv[j] << " as a PPM image or a texture file\n";
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--ao") && j + 1 < argc) {
+            int num_samples = atoi(argv[++j]);
+
+            if (num_samples < 1) {
+                std::cerr << "--ao needs at least one ray per hit; keeping the ambient light\n";
+                continue;
+            }
+
+            auto* occluder_ptr = new AmbientOccluder;
+            occluder_ptr->set_num_samples(num_samples);
+            delete w.ambient_ptr;
+            w.set_ambient_light(occluder_ptr);
+        }
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--heatmap"))
+            w.enable_heatmap();
+        else if (!strcmp(argv[j], "--bvh"))
+            w.enable_bvh();
+        else if (!strcmp(argv[j], "--static") && !w.enable_static_dispatch())
+            std::cerr << "the scene has types the static dispatch path doesn't handle; using virtual dispatch\n";
+        else if (!strcmp(argv[j], "--threads") && j + 1 < argc)
+            w.set_num_threads(atoi(argv[++j]));
+        else if (!strcmp(argv[j], "--checkpoint") && j + 1 < argc)
+            w.set_checkpoint(argv[++j], w.checkpoint_interval);
+        else if (!strcmp(argv[j], "--checkpoint-interval") && j + 1 < argc)
+            w.checkpoint_interval = atof(argv[++j]);
+        else if (!strcmp(argv[j], "--region") && j + 4 < argc) {
+            w.add_region(atoi(argv[j + 1]), atoi(argv[j + 2]), atoi(argv[j + 3]), atoi(argv[j + 4]));
+            j += 4;
+        }
+        else if (!strcmp(argv[j], "--crop") && j + 4 < argc) {
+            w.set_crop_window(atof(argv[j + 1]), atof(argv[j + 2]), atof(argv[j + 3]), atof(argv[j + 4]));
+            j += 4;
+        }
+        else if (!strcmp(argv[j], "--base") && j + 1 < argc)
+            w.set_base_image(argv[++j]);
+        else if (!strcmp(argv[j], "--float") && j + 1 < argc)
+            w.set_float_output(argv[++j]);
+
+    const char* coordinator_address = nullptr;
+    const char* worker_address = nullptr;
+    int num_local_workers = 0;
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--coordinator") && j + 1 < argc)
+            coordinator_address = argv[++j];
+        else if (!strcmp(argv[j], "--worker") && j + 1 < argc)
+            worker_address = argv[++j];
+        else if (!strcmp(argv[j], "--workers") && j + 1 < argc)
+            num_local_workers = atoi(argv[++j]);
+
+    if (worker_address) {
+        RenderWorker worker(w);
+        return (worker.connect(worker_address) && worker.serve() ? 0 : 1);
+    }
+
+    if (coordinator_address) {
+        std::vector<pid_t> children;
+
+        for (int j = 0; j < num_local_workers; j++) {
+            pid_t pid = fork();
+
+            if (pid == 0) {
+                RenderWorker worker(w);
+                _exit(worker.connect(coordinator_address) && worker.serve() ? 0 : 1);
+            }
+
+            if (pid > 0)
+                children.push_back(pid);
+        }
+
+        RenderCoordinator coordinator(w);
+        bool rendered = coordinator.listen(coordinator_address) && coordinator.render(std::cout);
+
+        if (!rendered)
+            std::cerr << "the distributed render failed\n";
+
+        for (pid_t pid : children)
+            waitpid(pid, nullptr, 0);
+
+        return (rendered ? 0 : 1);
+    }
+
+    const char* relight_file = nullptr;
+
+    for (int j = 1; j < argc; j++)
+        if (!strcmp(argv[j], "--relight") && j + 1 < argc)
+            relight_file = argv[++j];
+
+    if (relight_file && (num_frames > 0 || !w.enable_gbuffer())) {
+        std::cerr << "--relight needs a still render with a tracer that shades materials; rendering without it\n";
+        relight_file = nullptr;
+    }
+
+    if (num_frames > 0)
+        animation.render_frames(w, num_frames, 0.0, 1.0, std::cout);
+    else if (relight_file) {
+        std::string output_file = w.output_file;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        w.render_scene();
+        std::chrono::duration<double> traced = std::chrono::steady_clock::now() - start;
+
+        relight_scene(w);
+        w.output_file = relight_file;
+
+        start = std::chrono::steady_clock::now();
+        w.render_scene();
+        std::chrono::duration<double> relit = std::chrono::steady_clock::now() - start;
+
+        w.output_file = output_file;
+
+        std::cout << "traced " << traced.count() << " s, relit " << relit.count() << " s, G-buffer "
+                  << w.gbuffer_ptr->bytes() / (1024.0 * 1024.0) << " MB\n";
+    }
+    else
+        w.render_scene();
+
+    if (w.texture_cache_ptr) {
+        const TileCache& cache = *w.texture_cache_ptr;
+
+        std::cout << "texture cache: " << 100.0 * cache.hit_rate() << "% of " << cache.get_lookups()
+                  << " lookups hit, " << cache.get_bytes_read() / (1024.0 * 1024.0) << " MB read into "
+                  << cache.get_capacity() / (1024.0 * 1024.0) << " MB\n";
+    }
+
+#ifdef RT_STATS
+    StatBlock totals = Stats::end_frame();
+    Stats::report(std::cout, totals);
+
+    std::ofstream statsFile("stats.json");
+    Stats::write_json(statsFile, totals);
+#endif
+
+    if (trace_file) {
+        Timeline::disable();
+        std::ofstream traceFile(trace_file);
+        Timeline::write_chrome_trace(traceFile);
+    }
     return 0;
-}
\ No newline at end of file
+}